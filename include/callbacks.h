@@ -2,11 +2,14 @@
 #ifndef callbacks_h
 #define callbacks_h
 
-#include <arduino.h>
+#include <Arduino.h>
 #include <MyDisplay.h>
 #include <MyFreeFonts.h>
 #include <MyTouchScreen.h>
 #include <main.h>
+#include <render.h>
+#include <streaming.h>
+#include <toast.h>
 #include "RTClib.h"
 
 void nop(uint8_t);
@@ -26,6 +29,8 @@ void cycleDoutActionOnAlarm(uint8_t);
 void cycle110vActionOnAlarm(uint8_t);
 void cycle110vActionOnClock(uint8_t);
 void manual110vAction(uint8_t);
+void toggleStream(uint8_t);
+void cycleGraphMode(uint8_t);
 
 extern TFT_eSprite statusSprite;
 
@@ -67,6 +72,9 @@ extern char  manual110vActionS[];
 extern float curModuleTemp;
 extern float curModuleHumidity;
 
+extern char  streamStateS[];
+extern char  graphModeS[];
+
 extern char  ivAlarmArmedS[];
 extern char  tempAlarmArmedS[];
 extern char  clockAlarmArmedS[];
@@ -5,18 +5,39 @@
 #include <main.h>
 #include <MyTouchScreen.h>
 
-MyTouchScreen * getScreenPtr(const char * );
 void drawAdGraph(uint8_t);
 void drawIvGraph(uint8_t);
 void drawTempGraph(uint8_t);
+uint8_t curGraphMode();
+boolean allChannelsView();
+void setGraphXAxis(screenId, screenId);
+void drawOverlayGraph(uint8_t);
+void applyGraphXAxis();
+void redrawGraph();
+void graphTouch(boolean, uint16_t, uint16_t);
+void graphCursor(uint16_t);
+
+// Touch gestures on the graph screen
+#define GESTURE_NONE 0
+#define GESTURE_ZOOM 1
+#define GESTURE_PAN  2
+#define GRAPH_MIN_DRAG 8     // Pixels a touch has to move to be a drag rather than a tap
 
 extern MyTouchScreen * prevScreenPtr;
 extern MyTouchScreen * curScreenPtr;
 extern char currentlyGraphing[];
+extern char graphModeS[];
+extern float stripWindow;
+extern boolean graphZoomed;
+extern float graphZoomMin;
+extern float graphZoomMax;
 extern char curResType[];
 extern char resF0[];
 extern char resF1[];
 extern char resF2[];
+extern MyResultPyramid resPyramid0;
+extern MyResultPyramid resPyramid1;
+extern MyResultPyramid resPyramid2;
 extern int resArrIdx;
 extern boolean resultArraysFilled;
 extern float  monitoredResultsYAxis0[];
@@ -2,7 +2,7 @@
 #ifndef keypad_h
 #define keypad_h
 
-#include <arduino.h>
+#include <Arduino.h>
 #include <MyDisplay.h>
 #include <MyFreeFonts.h>
 #include <MyTouchScreen.h>
@@ -9,6 +9,7 @@
 #define KEYPAD "Keypad"
 #define CLOCK_MENU "Clock Menu"
 #define GRAPH "Graph"
+#define GRAPH_OVERLAY "Overlay"  // currentlyGraphing when all the result channels are on one graph
 #define AXIS_MENU "Graph Axis"
 #define MENU_110V "110v Outlet Control"
 #define SETUP_MENU "Setup Menu"
@@ -33,21 +34,93 @@
 // For temp/humidity module
 #define DHTPIN 17
 
+// XPT2046 touch controller PENIRQ (T_IRQ) line.  Goes low while the screen is touched.  Set to the GPIO
+// it is wired to, or -1 if it isn't connected (the panel then just gets polled every TOUCH_POLL_MS).
+// GPIO34-39 have no internal pullup so need an external one if used here.
+#define TOUCH_IRQ_PIN -1
+#define TOUCH_POLL_MS 20    // Fastest we read the touch panel (while pressed when using PENIRQ)
+
+// Keep images of the screens already drawn so going back to one is a single blit (see MyScreenCache).
+// The screen gets read back to make them, so the display's MISO line has to be connected.  Set to
+// false if it isn't (toasts then redraw the screen when they go instead of reading back what they cover).
+#define USE_SCREEN_CACHE true
+
 #define DATE_LEN 25 // date string length
 
-// Number of screens we will use for displays
-const uint8_t MAX_SCREEN_NUM = 9;
+// Serial port speed.  The ESP32 UART runs fine at 921600 (or faster) if the binary sample stream needs 
+// the bandwidth.  Remember to change monitor_speed in platformio.ini to match.
+#define SERIAL_BAUD 115200
+#define STREAM_TX_BUFFER_SIZE 1024   // Serial TX ring buffer so streaming never blocks the main loop
+
+// The screens we use for displays.  The id is the screen's index in screenPtrs[].  The IV, temperature and
+// Ain/Din results each have their own setup, axis, monitor and graph screens.
+enum screenId {
+   SCREEN_MAIN,
+   SCREEN_KEYPAD,
+   SCREEN_CLOCK,
+   SCREEN_110V,
+   SCREEN_DOUT,
+   SCREEN_IV_SETUP,
+   SCREEN_IV_AXIS,
+   SCREEN_IV_MONITOR,
+   SCREEN_IV_GRAPH,
+   SCREEN_TEMP_SETUP,
+   SCREEN_TEMP_AXIS,
+   SCREEN_TEMP_MONITOR,
+   SCREEN_TEMP_GRAPH,
+   SCREEN_AD_SETUP,
+   SCREEN_AD_AXIS,
+   SCREEN_AD_MONITOR,
+   SCREEN_AD_GRAPH,
+   NUM_SCREENS
+};
+const uint8_t MAX_SCREEN_NUM = NUM_SCREENS;
+static_assert(NUM_SCREENS <= MAX_SCREENS, "MyTouchScreen state arena and screen cache slots (MAX_SCREENS) are too few");
+
+// Buttons whose labels hold settings that get read back while running
+#define SETUP_ALARM_BTN      3    // Setup menu: alarm Enabled/Disabled
+#define SETUP_LIMIT0_BTN     7    // Setup menu: first alarm limit
+#define SETUP_LIMIT1_BTN     11   // Setup menu: second alarm limit
+#define SETUP_DURATION_BTN   15   // Setup menu: monitor duration
+#define SETUP_INTERVAL_BTN   19   // Setup menu: monitor interval
+#define DOUT_OUTPUT_BTN      3    // D-Out menu: output mode
+#define DOUT_DUTY_CYCLE_BTN  11   // D-Out menu: PWM duty cycle
+#define DOUT_FOLLOWS_BTN     15   // D-Out menu: what the duty cycle follows
+#define DOUT_ON_ALARM_BTN    19   // D-Out menu: action on alarm
+#define V110_ON_ALARM_BTN    7    // 110v menu: action on alarm
+#define V110_ON_CLOCK_BTN    11   // 110v menu: action on clock alarm
+#define V110_MANUAL_BTN      15   // 110v menu: manual On/Off
+#define CLOCK_ALARM_BTN      20   // Clock menu: AlarmOn/AlarmOff
+#define MONITOR_START_BTN    21   // Monitor menu: StartLog/Restart
+#define IV_AXIS_CURRENT_BTN  3    // I/V axis menu: current axis max
+#define IV_AXIS_VOLTAGE_BTN  7    // I/V axis menu: voltage axis max
+#define IV_AXIS_POWER_BTN    11   // I/V axis menu: power axis max
+#define IV_AXIS_MIN_BTN      15   // I/V axis menu: min of all three axis
+#define TEMP_AXIS_MAX_BTN    3    // Temp axis menu: temperature axis max
+#define TEMP_AXIS_MIN_BTN    7    // Temp axis menu: temperature axis min
+#define HUM_AXIS_MAX_BTN     11   // Temp axis menu: humidity axis max
+#define HUM_AXIS_MIN_BTN     15   // Temp axis menu: humidity axis min
+#define AD_AXIS_DIN_BTN      3    // A/D axis menu: D-In count axis max
+#define AD_AXIS_AIN_BTN      7    // A/D axis menu: A-In voltage axis max
+#define AD_AXIS_MIN_BTN      11   // A/D axis menu: min of both axis
 
 //###################################
 // Prototypes
 //###################################
 
-MyTouchScreen * getScreenPtr(const char * );
+// Screen pointer for the given screen
+extern MyTouchScreen * screenPtrs[];
+inline MyTouchScreen * getScreenPtr(screenId id) {
+   return(screenPtrs[id]);
+}
+MyTouchScreen * findScreenPtr(const char * );
+
+// The graph screens take the zoom/pan gestures
+inline boolean isGraphScreen(MyTouchScreen * screenPtr) {
+   return(screenPtr == screenPtrs[SCREEN_IV_GRAPH] || screenPtr == screenPtrs[SCREEN_TEMP_GRAPH] ||
+          screenPtr == screenPtrs[SCREEN_AD_GRAPH]);
+}
 
-void saveIvSetup();
-void saveIvSetupAndDrawMainMenu(uint8_t);
-void saveIvSetupAndDrawIvMenu(uint8_t);
-void saveIvSetupAndDrawIvAxisMenu(uint8_t);
 void drawIvGraph(uint8_t);
 void drawIvSetupMenu(uint8_t);
 void drawIvMenu(uint8_t);
@@ -76,10 +149,6 @@ void cycleDoutPwmFollows(uint8_t);
 void cycleDoutActionOnAlarm(uint8_t);
 void drawDoutMenu(uint8_t);
 
-void saveTempSetup();
-void saveTempSetupAndDrawMainMenu(uint8_t);
-void saveTempSetupAndDrawTempMenu(uint8_t);
-void saveTempSetupAndDrawTempAxisMenu(uint8_t);
 void drawTempGraph(uint8_t);
 void drawTempSetupMenu(uint8_t);
 void drawTempMenu(uint8_t);
@@ -96,8 +165,10 @@ void drawAdAxisMenu(uint8_t);
 
 void nop(uint8_t);
 void clearCount(uint8_t);
+void toggleStream(uint8_t);
+void cycleGraphMode(uint8_t);
 void touchCalibrate();
 void monitorResults(uint8_t);
-void writeResultsToFile(boolean, const char *, int, float *, float *);
+void writeResultsToFile(boolean, const char *, int, float *, float *, MyResultPyramid *);
 
 #endif
\ No newline at end of file
@@ -2,28 +2,17 @@
 #ifndef menus_h
 #define menus_h
 
-#include <arduino.h>
+#include <Arduino.h>
 #include <MyDisplay.h>
 #include <MyFreeFonts.h>
 #include <MyTouchScreen.h>
 #include <main.h>
+#include <render.h>
 #include "RTClib.h"
 
 void updateKeypad(uint8_t);
 void drawKeypad(uint8_t);
 void drawMainMenu(uint8_t);
-void saveIvSetup();
-void saveIvSetupAndDrawMainMenu(uint8_t);
-void saveIvSetupAndDrawIvMenu(uint8_t);
-void saveIvSetupAndDrawIvAxisMenu(uint8_t);
-void saveTempSetup();
-void saveTempSetupAndDrawMainMenu(uint8_t);
-void saveTempSetupAndDrawTempMenu(uint8_t);
-void saveTempSetupAndDrawTempAxisMenu(uint8_t);
-void saveAdSetup();
-void saveAdSetupAndDrawMainMenu(uint8_t);
-void saveAdSetupAndDrawAdMenu(uint8_t);
-void saveAdSetupAndDrawAdAxisMenu(uint8_t);
 void drawClockScreen(uint8_t);
 void updateClock();
 void updateClockAlarm();
@@ -38,6 +27,7 @@ void drawTempAxisMenu(uint8_t);
 void drawAdAxisMenu(uint8_t);
 void drawAdSetupMenu(uint8_t);
 void drawAdMenu(uint8_t);
+void initResultScreens();
 
 
 extern DateTime now;
@@ -48,81 +38,81 @@ extern MyTouchScreen * prevScreenPtr;
 extern MyTouchScreen mainMenuScreen;
 extern MyTouchScreen keypadScreen;
 extern MyTouchScreen clockScreen;
-extern MyTouchScreen graphScreen;
-extern MyTouchScreen axisScreen;
 extern MyTouchScreen screen110V;
-extern MyTouchScreen setupScreen;
-extern MyTouchScreen monitorScreen;
 extern MyTouchScreen doutScreen;
 
 extern uint8_t prevButtonNumber;
 
 extern char curResType[];
-extern char curStartResumeState[];
+extern char curStartResumeState[TITLE_LEN];
+extern char streamStateS[TITLE_LEN];
+extern char graphModeS[TITLE_LEN];
+extern float stripWindow;
+extern char stripWindowS[FLOAT_STRING_WIDTH];
 
 extern char dateString[][DATE_LEN];
-extern char ivAlarmArmedS[];
-extern char maxAlarmVS[];
-extern char maxAlarmIS[];
-extern char monitorIvDurationS[];
-extern char monitorIvIntervalS[];
+extern char ivAlarmArmedS[TITLE_LEN];
+extern char maxAlarmVS[FLOAT_STRING_WIDTH];
+extern char maxAlarmIS[FLOAT_STRING_WIDTH];
+extern char monitorIvDurationS[FLOAT_STRING_WIDTH];
+extern char monitorIvIntervalS[FLOAT_STRING_WIDTH];
 
 extern float curAxisMax;
 extern float voltAxisMax;
 extern float powerAxisMax;
 extern float allIvAxisMin;
 
-extern char current_mAS[];
-extern char loadVoltageS[];
-extern char power_mWS[];
-extern char timeMonitoredS[];
+extern char current_mAS[FLOAT_STRING_WIDTH];
+extern char loadVoltageS[FLOAT_STRING_WIDTH];
+extern char power_mWS[FLOAT_STRING_WIDTH];
+extern char timeMonitoredS[FLOAT_STRING_WIDTH];
 
-extern char tempAlarmArmedS[];
-extern char maxAlarmTempS[];
-extern char maxAlarmHumidS[];
-extern char monitorTempDurationS[];
-extern char monitorTempIntervalS[];
+extern char tempAlarmArmedS[TITLE_LEN];
+extern char maxAlarmTempS[FLOAT_STRING_WIDTH];
+extern char maxAlarmHumidS[FLOAT_STRING_WIDTH];
+extern char monitorTempDurationS[FLOAT_STRING_WIDTH];
+extern char monitorTempIntervalS[FLOAT_STRING_WIDTH];
 
 extern float tempAxisMax;
 extern float tempAxisMin;
 extern float humidityAxisMax;
 extern float humidityAxisMin;
 
-extern char adAlarmArmedS[];
-extern char maxDinCountLimitS[];
-extern char maxAinVoltageLimitS[];
-extern char monitorAdDurationS[];
-extern char monitorAdIntervalS[];
-
-extern char curYearS[];
-extern char curMonthS[];
-extern char curDayS[];
-extern char curHourS[];
-extern char curMinS[];
-extern char curSecS[];
-
-extern char curProbeTempS[];
-extern char curModuleTempS[];
-extern char curModuleHumidityS[];
-extern char timeMonitoredS[];
-extern char curAxisMaxS[];
-extern char voltAxisMaxS[];
-extern char powerAxisMaxS[];
-extern char allIvAxisMinS[];
-extern char tempAxisMaxS[];
-extern char tempAxisMinS[];
-extern char humidityAxisMaxS[];
-extern char humidityAxisMinS[];
+extern char adAlarmArmedS[TITLE_LEN];
+extern char maxDinCountLimitS[INT_STRING_WIDTH];
+extern char maxAinVoltageLimitS[FLOAT_STRING_WIDTH];
+extern char monitorAdDurationS[FLOAT_STRING_WIDTH];
+extern char monitorAdIntervalS[FLOAT_STRING_WIDTH];
+
+extern char curYearS[INT_STRING_WIDTH];
+extern char curMonthS[INT_STRING_WIDTH];
+extern char curDayS[INT_STRING_WIDTH];
+extern char curHourS[INT_STRING_WIDTH];
+extern char curMinS[INT_STRING_WIDTH];
+extern char curSecS[INT_STRING_WIDTH];
+
+extern char curProbeTempS[FLOAT_STRING_WIDTH];
+extern char curModuleTempS[FLOAT_STRING_WIDTH];
+extern char curModuleHumidityS[FLOAT_STRING_WIDTH];
+extern char timeMonitoredS[FLOAT_STRING_WIDTH];
+extern char curAxisMaxS[FLOAT_STRING_WIDTH];
+extern char voltAxisMaxS[FLOAT_STRING_WIDTH];
+extern char powerAxisMaxS[FLOAT_STRING_WIDTH];
+extern char allIvAxisMinS[FLOAT_STRING_WIDTH];
+extern char tempAxisMaxS[FLOAT_STRING_WIDTH];
+extern char tempAxisMinS[FLOAT_STRING_WIDTH];
+extern char humidityAxisMaxS[FLOAT_STRING_WIDTH];
+extern char humidityAxisMinS[FLOAT_STRING_WIDTH];
 
 extern int maxDinCount;
 extern float maxAinVoltage;
 extern float allAdAxisMin;
 
-extern char maxAinVoltageS[];
-extern char maxDinCountS[];
-extern char allAdAxisMinS[];
-extern char dinLevelS[];
-extern char dinCountS[];
-extern char ainVoltageS[];
+extern char maxAinVoltageS[FLOAT_STRING_WIDTH];
+extern char maxDinCountS[INT_STRING_WIDTH];
+extern char allAdAxisMinS[FLOAT_STRING_WIDTH];
+extern char dinLevelS[INT_STRING_WIDTH];
+extern char dinCountS[INT_STRING_WIDTH];
+extern char ainVoltageS[FLOAT_STRING_WIDTH];
 
 #endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+
+#ifndef render_h
+#define render_h
+
+#include <Arduino.h>
+#include <MyTouchScreen.h>
+#include <main.h>
+#include <toast.h>
+
+//#################################################################################################
+// Display refresh scheduler.  Rather than drawing the result fields/clock/button labels the moment
+// something changes, the code asks for a redraw with renderRequest() and the main loop draws
+// everything that is pending in one frame at the end of each pass (renderFrame()).
+// Each kind of update has its own minimum spacing so the numeric fields refresh at a readable
+// rate while the sensors are sampled as fast as the loop spins.
+//#################################################################################################
+
+// Things that can be waiting to be drawn (drawn in this order)
+#define RENDER_BUTTONS 0x01   // Button label overlays (after a callback changed one)
+#define RENDER_CLOCK   0x02   // Clock/alarm lines on the clock screen
+#define RENDER_TEXT    0x04   // Result text fields on the monitor screens
+
+// Minimum time between redraws of each kind.  The clock is already only updated once a second in
+// the main loop so its spacing is just under that to avoid skipping a tick.
+#define RENDER_BUTTONS_INTERVAL_MS 0     // Labels follow touches right away
+#define RENDER_CLOCK_INTERVAL_MS   950   // ~1 Hz
+#define RENDER_TEXT_INTERVAL_MS    150   // ~6-7 Hz
+
+// Time a frame is allowed to take.  Once a frame has used its budget the remaining kinds are left
+// pending for the next pass of the loop so sampling/touch handling doesn't stall.
+#define RENDER_FRAME_BUDGET_US 20000
+
+// How often the frame time statistics get printed (0 = never).  Not printed while streaming as
+// the serial port is carrying binary sample frames then.
+#define RENDER_STATS_INTERVAL_MS 60000
+
+void renderRequest(uint8_t);
+boolean renderDue(uint8_t);
+void renderFrame();
+void renderPrintStats();
+
+extern MyTouchScreen * curScreenPtr;
+extern char streamStateS[];
+
+#endif
@@ -2,21 +2,23 @@
 #ifndef results_h
 #define results_h
 
-#include <arduino.h>
+#include <Arduino.h>
 #include <MyDisplay.h>
 #include <MyFreeFonts.h>
 #include <MyTouchScreen.h>
 #include <main.h>
+#include <streaming.h>
+#include <render.h>
 #include "RTClib.h"
 
-void updateResults(const char *, const char *, const char *, const char *, const char *,   const char *,  const char *,
+void updateResults(screenId, screenId, const char *, screenId, const char *,   const char *,  const char *,
                    float *, float *, float *, void (*)());
 
 void drawAdResults();
 void drawIvResults();
 void drawTempResults();
 void monitorResults(uint8_t);
-void writeResultsToFile(boolean, const char *, int, float *, float *);
+void writeResultsToFile(boolean, const char *, int, float *, float *, MyResultPyramid *);
 
 extern DateTime now;
 extern RTC_DS1307 RTC;
@@ -26,7 +28,10 @@ extern char dateString[][DATE_LEN];
 extern char resF0[];
 extern char resF1[];
 extern char resF2[];
-extern char resMenu[];
+extern screenId resScreen;
+extern MyResultPyramid resPyramid0;
+extern MyResultPyramid resPyramid1;
+extern MyResultPyramid resPyramid2;
 
 extern File myFile; 
 
@@ -35,6 +40,7 @@ extern MyTouchScreen * curScreenPtr;
 extern MyTouchScreen * prevScreenPtr;
 
 extern boolean monitoringResults;
+extern char streamStateS[];
 extern unsigned long lastResultsLoggedTime;
 extern unsigned long monitoringStartTime;
 extern float curMonitorTime;
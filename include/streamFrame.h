@@ -0,0 +1,208 @@
+#ifndef streamFrame_h
+#define streamFrame_h
+
+//#################################################################################################
+// Binary sample frame sent over the serial port while streaming is turned on.
+//
+// This header has no Arduino dependencies so the host side receiver (tools/streamReceiver) can
+// include it directly.  Keep the two in sync by only ever changing the layout here.
+//
+// Raw frame (little endian, STREAM_RAW_LEN bytes):
+//    0  uint8   frame version (STREAM_FRAME_VERSION)
+//    1  uint8   result type (STREAM_TYPE_AD/IV/TEMP)
+//    2  uint32  sequence number (increments for every sample, even ones we had to drop)
+//    6  uint32  milliseconds since logging was started
+//   10  float   result 0  (dinCount / current_mA / probe temp)
+//   14  float   result 1  (ainVoltage / loadVoltage / module temp)
+//   18  float   result 2  (ainVoltage / power_mW / module humidity)
+//   22  uint16  CRC-16/CCITT-FALSE over bytes 0-21
+//
+// On the wire the raw frame is COBS encoded and terminated with a 0x00 byte, so a receiver can
+// always resync on the next zero even if bytes are lost or debug text gets mixed into the stream.
+//#################################################################################################
+
+#include <stdint.h>
+#include <string.h>
+
+#define STREAM_FRAME_VERSION 1
+
+#define STREAM_TYPE_AD   0
+#define STREAM_TYPE_IV   1
+#define STREAM_TYPE_TEMP 2
+
+#define STREAM_RESULTS 3
+#define STREAM_RAW_LEN 24
+#define STREAM_WIRE_LEN (STREAM_RAW_LEN + STREAM_RAW_LEN/254 + 2)  // COBS overhead plus the 0x00 delimiter
+
+struct streamSample {
+   uint8_t  type;
+   uint32_t seq;
+   uint32_t timeMs;
+   float    result[STREAM_RESULTS];
+};
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+inline uint16_t streamCrc16(const uint8_t * data, uint16_t len) {
+   uint16_t crc = 0xFFFF;
+   for(uint16_t i=0; i<len; i++) {
+      crc ^= (uint16_t)data[i] << 8;
+      for(uint8_t b=0; b<8; b++) {
+         crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+      }
+   }
+   return(crc);
+}
+
+inline void streamPutU32(uint8_t * p, uint32_t v) {
+   p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+inline uint32_t streamGetU32(const uint8_t * p) {
+   return((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+// Pack a sample into a raw frame (including the CRC)
+inline void streamPackFrame(const streamSample * s, uint8_t * raw) {
+   raw[0] = STREAM_FRAME_VERSION;
+   raw[1] = s->type;
+   streamPutU32(raw+2, s->seq);
+   streamPutU32(raw+6, s->timeMs);
+   for(uint8_t i=0; i<STREAM_RESULTS; i++) {
+      uint32_t bits;
+      memcpy(&bits, &s->result[i], sizeof(bits));
+      streamPutU32(raw+10+i*4, bits);
+   }
+   uint16_t crc = streamCrc16(raw, STREAM_RAW_LEN-2);
+   raw[22] = crc;
+   raw[23] = crc >> 8;
+}
+
+// Check the CRC/version of a raw frame and unpack it.  Returns false if the frame is bad.
+inline bool streamUnpackFrame(const uint8_t * raw, uint16_t len, streamSample * s) {
+   if(len != STREAM_RAW_LEN || raw[0] != STREAM_FRAME_VERSION) {
+      return(false);
+   }
+   if(streamCrc16(raw, STREAM_RAW_LEN-2) != (uint16_t)(raw[22] | (raw[23] << 8))) {
+      return(false);
+   }
+   s->type = raw[1];
+   s->seq = streamGetU32(raw+2);
+   s->timeMs = streamGetU32(raw+6);
+   for(uint8_t i=0; i<STREAM_RESULTS; i++) {
+      uint32_t bits = streamGetU32(raw+10+i*4);
+      memcpy(&s->result[i], &bits, sizeof(bits));
+   }
+   return(true);
+}
+
+// COBS encode len bytes from in to out and append the 0x00 delimiter.  out must hold
+// len + len/254 + 2 bytes.  Returns the number of bytes written.
+inline uint16_t streamCobsEncode(const uint8_t * in, uint16_t len, uint8_t * out) {
+   uint16_t codeIdx = 0;
+   uint16_t outIdx = 1;
+   uint8_t code = 1;
+   for(uint16_t i=0; i<len; i++) {
+      if(in[i] == 0) {
+         out[codeIdx] = code;
+         codeIdx = outIdx++;
+         code = 1;
+      } else {
+         out[outIdx++] = in[i];
+         if(++code == 0xFF) {
+            out[codeIdx] = code;
+            codeIdx = outIdx++;
+            code = 1;
+         }
+      }
+   }
+   out[codeIdx] = code;
+   out[outIdx++] = 0;
+   return(outIdx);
+}
+
+// COBS decode one frame (without the 0x00 delimiter).  Returns the decoded length or -1 if the
+// frame is malformed or would not fit in maxLen bytes.
+inline int streamCobsDecode(const uint8_t * in, uint16_t len, uint8_t * out, uint16_t maxLen) {
+   uint16_t inIdx = 0;
+   uint16_t outIdx = 0;
+   while(inIdx < len) {
+      uint8_t code = in[inIdx++];
+      if(code == 0 || inIdx + code - 1 > len) {
+         return(-1);
+      }
+      for(uint8_t i=1; i<code; i++) {
+         if(outIdx >= maxLen) {
+            return(-1);
+         }
+         out[outIdx++] = in[inIdx++];
+      }
+      if(code != 0xFF && inIdx < len) {
+         if(outIdx >= maxLen) {
+            return(-1);
+         }
+         out[outIdx++] = 0;
+      }
+   }
+   return(outIdx);
+}
+
+// Receiver side.  Bytes off the wire go into streamDecodeByte() one at a time.  It collects a frame up
+// to each 0x00 delimiter, checks it and keeps count of the good frames, the bad ones (COBS/CRC/format
+// errors) and the samples lost in between (gaps in the sequence numbers).  Anything longer than a
+// frame can't be one of ours (debug text, line noise) and is discarded up to the next delimiter.
+struct streamDecoder {
+   uint8_t frame[STREAM_WIRE_LEN];
+   uint16_t frameLen;
+   bool overflow;
+   bool synced;             // False to skip the partial frame a receiver most likely joined in the middle of
+   bool haveSeq;
+   uint32_t expectedSeq;
+   unsigned long goodFrames;
+   unsigned long badFrames;
+   unsigned long droppedFrames;
+   unsigned long restarts;  // Sequence went backwards (logger reset)
+};
+
+inline void streamDecoderInit(streamDecoder * d, bool synced) {
+   memset(d, 0, sizeof(*d));
+   d->synced = synced;
+}
+
+// Returns true when c finished a good frame, which is unpacked into s
+inline bool streamDecodeByte(streamDecoder * d, uint8_t c, streamSample * s) {
+   if(c != 0) {
+      if(d->frameLen < sizeof(d->frame)) {
+         d->frame[d->frameLen++] = c;
+      } else {
+         d->overflow = true;
+      }
+      return(false);
+   }
+
+   // End of frame
+   bool good = false;
+   if(d->synced && d->frameLen > 0) {
+      uint8_t raw[STREAM_RAW_LEN];
+      int rawLen = d->overflow ? -1 : streamCobsDecode(d->frame, d->frameLen, raw, sizeof(raw));
+      if(rawLen > 0 && streamUnpackFrame(raw, rawLen, s)) {
+         if(d->haveSeq && s->seq != d->expectedSeq) {
+            if(s->seq > d->expectedSeq) {
+               d->droppedFrames += s->seq - d->expectedSeq;
+            } else {
+               d->restarts++;
+            }
+         }
+         d->haveSeq = true;
+         d->expectedSeq = s->seq + 1;
+         d->goodFrames++;
+         good = true;
+      } else {
+         d->badFrames++;
+      }
+   }
+   d->synced = true;
+   d->frameLen = 0;
+   d->overflow = false;
+   return(good);
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef streaming_h
+#define streaming_h
+
+#include <Arduino.h>
+#include <MyDisplay.h>
+#include <main.h>
+#include <streamFrame.h>
+
+void streamBegin();
+void streamResults(const char *, float, float, float);
+void streamEnd();
+
+extern char streamStateS[];
+extern uint32_t streamSeq;
+extern uint32_t streamSentFrames;
+extern uint32_t streamDroppedFrames;
+extern unsigned long monitoringStartTime;
+
+#endif
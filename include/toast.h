@@ -0,0 +1,30 @@
+
+#ifndef toast_h
+#define toast_h
+
+#include <Arduino.h>
+#include <MyDisplay.h>
+#include <MyFreeFonts.h>
+#include <MyTouchScreen.h>
+#include <main.h>
+
+//#################################################################################################
+// Timed status pop-ups ("toasts").  toastShow() saves the bit of screen under the status box, draws
+// the message over it and returns straight away.  toastService() (called every pass of the main loop)
+// puts the saved pixels back once the time is up, so sampling/alarms keep running while it is shown.
+//#################################################################################################
+
+#define TOAST_SHORT_MS 1500
+#define TOAST_LONG_MS  2000
+
+void toastShow(const char *, unsigned long);
+void toastService();
+boolean toastVisible();
+void toastSuspend();
+void toastResume();
+
+extern TFT_eSPI tft;
+extern TFT_eSprite statusSprite;
+extern MyTouchScreen * curScreenPtr;
+
+#endif
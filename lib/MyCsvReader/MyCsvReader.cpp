@@ -0,0 +1,145 @@
+
+// Buffered reader for the numeric CSV result files we log to the SD card.
+//
+// The files are written with File.print() so every row is a few plain decimal numbers separated by 
+// commas and ended with CR LF (we also accept a bare LF).  Reading these a byte at a time and
+// atof()'ing them is very slow when re-drawing a long graph, so instead we pull the file in big 
+// blocks and scan the numbers straight out of the block buffer.
+//
+// dlf 
+
+#include "MyCsvReader.h"
+
+// Powers of ten for the fraction digits we keep
+static const float _fractionScale[CSV_MAX_FRACTION + 1] = {1.0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7};
+
+//####################################################################
+// Constructor.  
+//####################################################################
+MyCsvReader::MyCsvReader(char * buffer, uint16_t bufferSize){
+   _buf = buffer;
+   _bufSize = bufferSize;
+   _len = 0;
+   _pos = 0;
+}
+
+//#######################################
+// Methods for the class
+//#######################################
+boolean MyCsvReader::open(const char * fileName) {
+   _len = 0;
+   _pos = 0;
+   _fh = SD.open(fileName, FILE_READ);
+   if(!_fh) {
+      return(false);
+   }
+   return(true);
+}
+
+void MyCsvReader::close() {
+   _fh.close();
+}
+
+boolean MyCsvReader::seek(uint32_t position) {
+   _len = 0;
+   _pos = 0;
+   return(_fh.seek(position));
+}
+
+boolean MyCsvReader::_fill() {
+   if(!_fh) {
+      return(false);
+   }
+   int n = _fh.read((uint8_t *)_buf, _bufSize);
+   if(n <= 0) {
+      _len = 0;
+      _pos = 0;
+      return(false);
+   }
+   _len = n;
+   _pos = 0;
+   return(true);
+}
+
+// Scan a plain decimal number (optional sign, digits, optional fraction).  Anything else in the field
+// (nan, ovf, garbage from a partly written row) just ends the number and is skipped, which matches 
+// what atof() did for us before.  The field length is unbounded but we never store more than we need.
+float MyCsvReader::_scanNumber(int * delim) {
+   int c = _getc();
+
+   // Leading blanks
+   while(c == ' ' || c == '\t') {
+      c = _getc();
+   }
+
+   boolean negative = false;
+   if(c == '-' || c == '+') {
+      negative = (c == '-');
+      c = _getc();
+   }
+
+   // Integer part.  Accumulate in float once the digits no longer fit in 32 bits.
+   uint32_t intPart = 0;
+   float bigPart = 0.0;
+   boolean big = false;
+   while(c >= '0' && c <= '9') {
+      if(!big && intPart < 429496729) {
+         intPart = intPart * 10 + (c - '0');
+      } else {
+         if(!big) {
+            bigPart = intPart;
+            big = true;
+         }
+         bigPart = bigPart * 10.0 + (c - '0');
+      }
+      c = _getc();
+   }
+   float value = big ? bigPart : (float)intPart;
+
+   // Fraction part
+   if(c == '.') {
+      uint32_t fracPart = 0;
+      uint8_t fracDigits = 0;
+      c = _getc();
+      while(c >= '0' && c <= '9') {
+         if(fracDigits < CSV_MAX_FRACTION) {
+            fracPart = fracPart * 10 + (c - '0');
+            fracDigits++;
+         }
+         c = _getc();
+      }
+      value += fracPart * _fractionScale[fracDigits];
+   }
+
+   // Skip whatever is left of the field
+   while(c != ',' && c != '\n' && c != '\r' && c != -1) {
+      c = _getc();
+   }
+   *delim = c;
+   return(negative ? -value : value);
+}
+
+// Read one row of fields.  Blank lines are skipped.
+uint8_t MyCsvReader::readRow(float * fields, uint8_t maxFields) {
+   int c;
+
+   // Skip over any line endings left from the previous row
+   do {
+      c = _getc();
+   } while(c == '\r' || c == '\n');
+   if(c == -1) {
+      return(0);
+   }
+   _pos--;  // Put back the first character of the row (it's always still in the buffer)
+
+   uint8_t numFields = 0;
+   int delim = ',';
+   while(delim == ',') {
+      float value = _scanNumber(&delim);
+      if(numFields < maxFields) {
+         fields[numFields] = value;
+      }
+      numFields++;
+   }
+   return(numFields > maxFields ? maxFields : numFields);
+}
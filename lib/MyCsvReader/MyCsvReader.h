@@ -0,0 +1,63 @@
+
+// Buffered reader for the numeric CSV result files we log to the SD card.
+// dlf 
+
+#ifndef MyCsvReader_h
+#define MyCsvReader_h
+
+#include "Arduino.h"
+
+// For sd card
+#include <FS.h>
+#include <SPI.h>
+#include <SD.h>
+
+#define CSV_BLOCK_SIZE 4096     // Bytes pulled from the SD card per read
+#define CSV_MAX_FRACTION 7      // Digits after the decimal point we bother to keep
+
+class MyCsvReader  {
+
+   public:
+      //#######################################################################
+      // Constructor 
+      // Need to supply the block buffer and its size.  The buffer is owned by
+      // the caller so one static block can be shared by all the readers.
+      //#######################################################################
+      MyCsvReader(char *, uint16_t);
+
+      //#######################################
+      // Methods
+      //#######################################
+      // Open/close the result file
+      boolean open(const char *);
+      void close();
+
+      // Move to a byte offset in the file (start of a row)
+      boolean seek(uint32_t);
+
+      // Read the next row of numeric fields into the float array (up to the max fields given).
+      // Returns the number of fields on the row, 0 at the end of the file.  Extra fields are skipped.
+      uint8_t readRow(float *, uint8_t);
+
+   private:
+      // Pull the next block from the file.  Returns false at end of file.
+      boolean _fill();
+
+      // Next character from the block buffer (-1 at end of file)
+      inline int _getc() {
+         if(_pos >= _len && !_fill()) {
+            return(-1);
+         }
+         return((uint8_t)_buf[_pos++]);
+      }
+
+      // Scan one number.  Stops on the field/row delimiter (which is returned in *delim)
+      float _scanNumber(int *);
+
+      File _fh;
+      char * _buf;
+      uint16_t _bufSize;
+      uint16_t _len;    // Valid bytes in the buffer
+      uint16_t _pos;    // Next unread byte in the buffer
+};
+#endif
@@ -13,6 +13,7 @@
 #define TEXT_LEN 27            // Maximum length of any text field
 #define TEXT_PLUS_DATE_LEN 55  // Field used to concatenate the results file name with the date 
 #define TEXT_ROWS 5            // Number of rows of text we allow on any screen
+#define MAX_SCREENS 17         // Screen state blocks in the MyTouchScreen arena
 
 #define FLOAT_STRING_WIDTH 7  // The width of the string fields used to print data results
 #define INT_STRING_WIDTH 5    // The width of the string fields used for integer results
@@ -92,6 +93,7 @@
 #define TEXT_SP_WIDTH  86     // Width of individual button text sprite
 #define TEXT_SP_HEIGHT 25     // Height of individual button text sprite
 #define TEXT_SP_LEFT 400      // Where to place the Left side of all Text sprites 
+#define TEXT_COLUMN_HEIGHT (TEXT_SP_LINE4 - TEXT_SP_LINE0 + TEXT_SP_HEIGHT)  // The text sprite covers the whole result column
                            
 // Sprite's text coords relative to the sprite rectangle
 #define TEXT_SP_LINE0 50        // Y coord of the Text line
@@ -111,6 +113,25 @@
 
 #define GRAPH_Y_TOP     35
 #define GRAPH_Y_INCX    25
+#define GRAPH_LEGEND_Y  10      // Trace legend above an overlay graph
+#define GRAPH_PAN_Y_BOTTOM 265  // Touches between the X axis and here (over the X labels) pan the graph
+#define GRAPH_CURSOR_Y  2       // Cursor readout (status sprite) above the plot
+#define GRAPH_CURSOR_COLOR TFT_GREEN
+#define GRAPH_SPLIT_GAP 6       // Pixels between the stacked plots of a split view
+#define GRAPH_SPLIT_INTERVALS 2 // Y grid intervals on each of them
+#define GRAPH_SPLIT_LABEL_H 14  // Height of their Y axis numbers
+
+// Off-screen sprite covering the plot window (border included)
+#define GRAPH_PLOT_W    (GRAPH_X_RIGHT - GRAPH_X_ORIGIN + 1)
+#define GRAPH_PLOT_H    (GRAPH_Y_ORIGIN - GRAPH_Y_TOP + 1)
+
+// Graph chrome cache.  The labels around the plot window are cached in bands (left, top, right, bottom).
+#define CHROME_BANDS  4
+#define CHROME_LEFT   0
+#define CHROME_TOP    1
+#define CHROME_RIGHT  2
+#define CHROME_BOTTOM 3
+#define CHROME_CACHE_SIZE 8192
 
 // Sprite used to rotate text for the yAxisLabel
 #define GRAPH_SP_X_PIVOT   20
@@ -0,0 +1,155 @@
+
+// Pre-rendered glyphs for drawing numbers into 1-bit sprites quickly.
+//
+// The result fields change several times a second and drawString() has to walk the free font's bit
+// stream pixel by pixel for every character.  The result values only ever use a handful of characters
+// (digits, sign, decimal point), so at boot those glyphs are unpacked once into byte aligned rows.
+// Drawing a value is then a few shifted byte ORs per row straight into the sprite's buffer.
+//
+// dlf 
+
+#include "MyGlyphAtlas.h"
+
+//####################################################################
+// Constructor.  
+//####################################################################
+MyGlyphAtlas::MyGlyphAtlas(){
+   memset(_lookup, -1, sizeof(_lookup));
+   _bitsUsed = 0;
+   _ascent = 0;
+}
+
+//#######################################
+// Methods for the class
+//#######################################
+boolean MyGlyphAtlas::begin(const GFXfont * font, const char * chars) {
+   memset(_lookup, -1, sizeof(_lookup));
+   _bitsUsed = 0;
+
+   // Baseline position the way TFT_eSPI works it out for TL_DATUM (tallest glyph in the whole font)
+   _ascent = 0;
+   for(uint16_t c=0; c <= font->last - font->first; c++) {
+      int8_t ab = -font->glyph[c].yOffset;
+      if(ab > _ascent) {
+         _ascent = ab;
+      }
+   }
+
+   uint8_t count = 0;
+   for(const char * p=chars; *p; p++) {
+      uint8_t c = *p;
+      if(c < font->first || c > font->last || c >= sizeof(_lookup) || count >= GLYPH_ATLAS_MAX_GLYPHS) {
+         return(false);
+      }
+      const GFXglyph * src = &font->glyph[c - font->first];
+      atlasGlyph * g = &_glyphs[count];
+      g->width = src->width;
+      g->height = src->height;
+      g->xAdvance = src->xAdvance;
+      g->xOffset = src->xOffset;
+      g->yOffset = src->yOffset;
+      g->offset = _bitsUsed;
+
+      // The font packs the glyph's pixels as one continuous bit stream.  Start each row on a byte.
+      uint8_t stride = (g->width + 7) / 8;
+      if(_bitsUsed + stride * g->height > GLYPH_ATLAS_BYTES) {
+         return(false);
+      }
+      memset(_bits + _bitsUsed, 0, stride * g->height);
+      const uint8_t * bitmap = font->bitmap + src->bitmapOffset;
+      uint16_t bit = 0;
+      for(uint8_t y=0; y < g->height; y++) {
+         for(uint8_t x=0; x < g->width; x++, bit++) {
+            if(bitmap[bit >> 3] & (0x80 >> (bit & 7))) {
+               _bits[_bitsUsed + y * stride + (x >> 3)] |= 0x80 >> (x & 7);
+            }
+         }
+      }
+      _bitsUsed += stride * g->height;
+      _lookup[c] = count++;
+   }
+   return(true);
+}
+
+int8_t MyGlyphAtlas::_glyphIndex(char c) {
+   if((uint8_t)c >= sizeof(_lookup)) {
+      return(-1);
+   }
+   return(_lookup[(uint8_t)c]);
+}
+
+boolean MyGlyphAtlas::drawString(TFT_eSprite * spritePtr, const char * text, int32_t boxX, int32_t boxY, int32_t boxW, int32_t boxH) {
+   uint8_t * buf = (uint8_t *)spritePtr->getPointer();
+   if(buf == NULL || spritePtr->getColorDepth() != 1 || _bitsUsed == 0) {
+      return(false);
+   }
+   int32_t spriteW = spritePtr->width();
+   int32_t spriteH = spritePtr->height();
+   if(boxX < 0 || boxY < 0 || boxX + boxW > spriteW || boxY + boxH > spriteH) {
+      return(false);
+   }
+
+   // Everything has to be in the atlas and fit across the box (rows below the box just get clipped)
+   int32_t penX = 0;
+   for(const char * p=text; *p; p++) {
+      int8_t i = _glyphIndex(*p);
+      if(i < 0) {
+         return(false);
+      }
+      const atlasGlyph * g = &_glyphs[i];
+      if(g->width && (penX + g->xOffset < 0 || penX + g->xOffset + g->width > boxW)) {
+         return(false);
+      }
+      penX += g->xAdvance;
+   }
+
+   // 1-bit sprites keep each row padded to a whole byte, leftmost pixel in the top bit
+   int32_t rowBytes = (spriteW + 7) >> 3;
+
+   // Clear the box
+   for(int32_t y=boxY; y < boxY + boxH; y++) {
+      uint8_t * row = buf + y * rowBytes;
+      int32_t x = boxX;
+      int32_t end = boxX + boxW;
+      while(x < end) {
+         if((x & 7) == 0 && end - x >= 8) {
+            row[x >> 3] = 0;
+            x += 8;
+         } else {
+            row[x >> 3] &= ~(0x80 >> (x & 7));
+            x++;
+         }
+      }
+   }
+
+   // OR the glyph rows in
+   int32_t baseline = boxY + _ascent;
+   penX = boxX;
+   for(const char * p=text; *p; p++) {
+      const atlasGlyph * g = &_glyphs[_glyphIndex(*p)];
+      uint8_t stride = (g->width + 7) / 8;
+      int32_t dx = penX + g->xOffset;
+      uint8_t shift = dx & 7;
+      for(uint8_t gy=0; gy < g->height; gy++) {
+         int32_t y = baseline + g->yOffset + gy;
+         if(y < boxY || y >= boxY + boxH) {
+            continue;
+         }
+         const uint8_t * src = _bits + g->offset + gy * stride;
+         uint8_t * dst = buf + y * rowBytes + (dx >> 3);
+         for(uint8_t b=0; b < stride; b++) {
+            dst[b] |= src[b] >> shift;
+            uint8_t spill = src[b] << (8 - shift);
+            if(shift && spill) {
+               dst[b+1] |= spill;
+            }
+         }
+      }
+      penX += g->xAdvance;
+   }
+   return(true);
+}
+
+uint16_t MyGlyphAtlas::getMemoryUsed() {
+   return(_bitsUsed);
+}
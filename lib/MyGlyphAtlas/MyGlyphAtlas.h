@@ -0,0 +1,59 @@
+
+// Pre-rendered glyphs for drawing numbers into 1-bit sprites quickly
+// dlf 
+
+#ifndef MyGlyphAtlas_h
+#define MyGlyphAtlas_h
+
+#include "Arduino.h"
+
+// Uses the Bodmer TFT_eSPI graphics display library
+#include <TFT_eSPI.h>
+
+#define GLYPH_ATLAS_CHARS " +-.0123456789"   // What the live result values are made of
+#define GLYPH_ATLAS_MAX_GLYPHS 16
+#define GLYPH_ATLAS_BYTES 768                 // Room for the digits etc. of a 12pt bold font
+
+// Where a glyph's rows are in the atlas and how to place it (same meanings as a GFXglyph)
+struct atlasGlyph {
+   uint16_t offset;    // Into _bits
+   uint8_t width;
+   uint8_t height;
+   uint8_t xAdvance;
+   int8_t xOffset;
+   int8_t yOffset;
+};
+
+class MyGlyphAtlas  {
+
+   public:
+      //#######################################################################
+      // Constructor 
+      //#######################################################################
+      MyGlyphAtlas();
+
+      //#######################################
+      // Methods
+      //#######################################
+      // Render the given characters of a free font into the atlas.  False if they don't fit.
+      boolean begin(const GFXfont *, const char *);
+
+      // Clear a box in a 1-bit sprite and draw the text at its top left (TL_DATUM, same pixels as 
+      // drawString with the same font).  Returns false without drawing anything if the text has a
+      // character not in the atlas, it is wider than the box, or the sprite isn't 1-bit.
+      boolean drawString(TFT_eSprite *, const char *, int32_t, int32_t, int32_t, int32_t);
+
+      // Bytes of glyph bitmaps in the atlas
+      uint16_t getMemoryUsed();
+
+   private:
+      // Glyph index for a character (-1 if it isn't in the atlas)
+      int8_t _glyphIndex(char);
+
+      atlasGlyph _glyphs[GLYPH_ATLAS_MAX_GLYPHS];
+      int8_t _lookup[128];      // Character to glyph index
+      uint8_t _bits[GLYPH_ATLAS_BYTES];
+      uint16_t _bitsUsed;
+      uint8_t _ascent;          // Baseline below the top of the text (glyph_ab in TFT_eSPI)
+};
+#endif
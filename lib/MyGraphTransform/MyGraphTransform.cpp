@@ -0,0 +1,33 @@
+// Fixed point data to pixel transform for the graphs.
+//
+// Mapping a sample to a pixel used to be two subtractions, a divide and a multiply per coordinate in 
+// float.  The scale and offset only change when an axis does, so they're worked out once here and
+// plotting a point is then integer only (see graphDataToPixel() in the header).
+//
+// dlf 
+
+#include "MyGraphTransform.h"
+
+// Pixels per data unit and the Q16 pixel position of data value 0, as a fixed point transform.  The
+// fraction bits are picked so anything up to GRAPH_PIXEL_LIMIT pixels off the plot still fits in
+// GRAPH_FIXED_LIMIT, and the shift so the scale keeps about 30 significant bits.
+void setGraphTransform(float min, float max, int pixels, int origin, graphTransform * t) {
+   t->fracBits = 0;
+   t->shift = 0;
+   t->scale = 0;
+   t->offsetQ16 = (int64_t)origin << 16;
+   if(max == min) {
+      return;
+   }
+   double perUnitQ16 = (pixels * 65536.0) / ((double)max - min);
+   double limit = ((fabs(min) > fabs(max)) ? fabs(min) : fabs(max)) + GRAPH_PIXEL_LIMIT * 65536.0 / fabs(perUnitQ16);
+   int limitExp, scaleExp;
+   frexp(limit, &limitExp);
+   frexp(perUnitQ16, &scaleExp);
+   t->fracBits = 30 - limitExp;
+   int shift = constrain(t->fracBits + 30 - scaleExp, 0, 62);
+   long long scale = llround(ldexp(perUnitQ16, shift - t->fracBits));
+   t->shift = shift;
+   t->scale = (int32_t)constrain(scale, -(long long)INT32_MAX, (long long)INT32_MAX);
+   t->offsetQ16 -= (int64_t)llround(min * perUnitQ16);
+}
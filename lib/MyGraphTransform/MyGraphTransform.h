@@ -0,0 +1,59 @@
+// Fixed point data to pixel transform for the graphs.
+// dlf 
+
+#ifndef MyGraphTransform_h
+#define MyGraphTransform_h
+
+#include "Arduino.h"
+
+// Limits for the fixed point data to pixel transform.  Far off-plot points are clamped so the
+// clipper's intersection math stays in range (a few million pixels is plenty of "off screen").
+#define GRAPH_FIXED_LIMIT (1L << 30)
+#define GRAPH_PIXEL_LIMIT (1L << 22)
+
+// Data to pixel transform for one axis, all integer once it's set up.  A sample is turned into fixed
+// point with fracBits fraction bits straight from its float bits, then
+//    pixel = (offsetQ16 + ((fixed * scale) >> shift)) >> 16
+struct graphTransform {
+   int16_t fracBits;
+   uint8_t shift;
+   int32_t scale;
+   int64_t offsetQ16;
+};
+
+// Work out the transform that puts data min at pixel origin and max at origin + pixels
+void setGraphTransform(float, float, int, int, graphTransform *);
+
+// ###########################################################################
+// Data (graph units) to pixel coordinates.  The float is turned into fixed
+// point from its exponent and mantissa bits, then one multiply, one add and
+// a shift.  Points way off the plot are clamped to GRAPH_PIXEL_LIMIT.
+// Inline as it's called for every point of a graph.
+// ###########################################################################
+inline int32_t graphFloatToFixed(float data, int16_t fracBits) {
+   uint32_t bits;
+   memcpy(&bits, &data, sizeof(bits));
+   int exponent = (bits >> 23) & 0xFF;
+   int shift = exponent - 150 + fracBits;          // 150 = exponent bias + 23 mantissa bits
+   int32_t fixed;
+   if(shift > 6 || exponent == 0xFF) {
+      fixed = GRAPH_FIXED_LIMIT;                   // Won't fit in 30 bits (or inf/NaN)
+   } else if(shift < -24 || exponent == 0) {
+      fixed = 0;                                   // Rounds to 0 (or zero/denormal)
+   } else {
+      // Shift up first so one right shift covers both directions
+      fixed = (int32_t)((((int64_t)((bits & 0x7FFFFF) | 0x800000)) << 24) >> (24 - shift));
+   }
+   int32_t sign = (int32_t)bits >> 31;
+   return((fixed ^ sign) - sign);
+}
+
+inline int graphDataToPixel(float data, const graphTransform * t) {
+   int64_t scaled = ((int64_t)graphFloatToFixed(data, t->fracBits) * t->scale) >> t->shift;
+   int64_t pixel = (t->offsetQ16 + scaled) >> 16;
+   if(pixel > GRAPH_PIXEL_LIMIT) { pixel = GRAPH_PIXEL_LIMIT; }
+   if(pixel < -GRAPH_PIXEL_LIMIT) { pixel = -GRAPH_PIXEL_LIMIT; }
+   return((int)pixel);
+}
+
+#endif
@@ -0,0 +1,183 @@
+
+// Multi-resolution summary of a logged result stream.
+//
+// While logging, every sample written to a raw result file is also rolled up into buckets of 16, 256 
+// and 4096 samples.  Each finished bucket (first/last time, min/max/mean and where it ends in the raw 
+// file) is appended to a level file next to the raw CSV file.  When re-drawing the graph we can then
+// read the coarsest level that still gives about one bucket per pixel instead of the whole raw file,
+// so opening a graph takes about the same time for a short or a multi-day session.
+//
+// dlf 
+
+#include "MyResultPyramid.h"
+
+//####################################################################
+// Constructor.  
+//####################################################################
+MyResultPyramid::MyResultPyramid(){
+   begin("");
+}
+
+//#######################################
+// Methods for the class
+//#######################################
+void MyResultPyramid::begin(const char * resultFile) {
+   strncpy(_resultFile, resultFile, TEXT_PLUS_DATE_LEN - 1);
+   _resultFile[TEXT_PLUS_DATE_LEN - 1] = '\0';
+   _sampleCount = 0;
+   _pendingCount = 0;
+   for(uint8_t level=0; level<PYRAMID_LEVELS; level++) {
+      _bucketCount[level] = 0;
+      _bucketChildren[level] = 0;
+   }
+}
+
+uint32_t MyResultPyramid::getBucketSize(uint8_t level) {
+   uint32_t size = PYRAMID_FANOUT;
+   for(uint8_t i=0; i<level; i++) {
+      size *= PYRAMID_FANOUT;
+   }
+   return(size);
+}
+
+// Swap the ".csv" for ".p<bucket size>".  Name buffer must be at least TEXT_PLUS_DATE_LEN + 4.
+void MyResultPyramid::getLevelFileName(const char * resultFile, uint8_t level, char * name) {
+   char ext[13];   // ".p" plus any 32-bit bucket size
+   strcpy(name, resultFile);
+   char * dot = strrchr(name, '.');
+   if(dot != NULL) {
+      *dot = '\0';
+   }
+   snprintf(ext, sizeof(ext), ".p%lu", (unsigned long)getBucketSize(level));
+   strcat(name, ext);
+}
+
+// Records are sorted by time so we can binary search them with a seek per probe
+uint32_t MyResultPyramid::findRecord(File * levelFile, float x) {
+   pyramidRecord rec;
+   uint32_t lo = 0;
+   uint32_t hi = levelFile->size() / sizeof(pyramidRecord);
+   while(lo < hi) {
+      uint32_t mid = (lo + hi) / 2;
+      levelFile->seek(mid * sizeof(pyramidRecord));
+      if(levelFile->read((uint8_t *)&rec, sizeof(rec)) != sizeof(rec)) {
+         break;
+      }
+      if(rec.xLast < x) {
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+   return(lo);
+}
+
+uint32_t MyResultPyramid::getSampleCount() {
+   return(_sampleCount);
+}
+
+int8_t MyResultPyramid::getLevelForBuckets(uint32_t buckets) {
+   for(int8_t level=PYRAMID_LEVELS-1; level>=0; level--) {
+      if(_sampleCount / getBucketSize(level) >= buckets) {
+         return(level);
+      }
+   }
+   return(-1);
+}
+
+void MyResultPyramid::add(float x, float y, uint32_t rawEnd) {
+   if(_resultFile[0] == '\0') {
+      return;
+   }
+   pyramidRecord * b = &_bucket[0];
+   if(_bucketCount[0] == 0) {
+      b->xFirst = x;
+      b->minY = y;
+      b->maxY = y;
+      _bucketSum[0] = 0.0;
+   }
+   if(y < b->minY) { b->minY = y; }
+   if(y > b->maxY) { b->maxY = y; }
+   b->xLast = x;
+   b->rawEnd = rawEnd;
+   _bucketSum[0] += y;
+   _bucketCount[0]++;
+   _sampleCount++;
+
+   if(++_bucketChildren[0] == PYRAMID_FANOUT) {
+      _closeBucket(0);
+   }
+}
+
+// Finish off the bucket at this level, queue it for writing and merge it into the level above
+void MyResultPyramid::_closeBucket(uint8_t level) {
+   pyramidRecord * b = &_bucket[level];
+   b->meanY = _bucketSum[level] / _bucketCount[level];
+
+   if(_pendingCount == PYRAMID_PENDING) {
+      flush();
+   }
+   _pending[_pendingCount] = *b;
+   _pendingLevel[_pendingCount] = level;
+   _pendingCount++;
+
+   if(level + 1 < PYRAMID_LEVELS) {
+      pyramidRecord * up = &_bucket[level + 1];
+      if(_bucketCount[level + 1] == 0) {
+         up->xFirst = b->xFirst;
+         up->minY = b->minY;
+         up->maxY = b->maxY;
+         _bucketSum[level + 1] = 0.0;
+      }
+      if(b->minY < up->minY) { up->minY = b->minY; }
+      if(b->maxY > up->maxY) { up->maxY = b->maxY; }
+      up->xLast = b->xLast;
+      up->rawEnd = b->rawEnd;
+      _bucketSum[level + 1] += _bucketSum[level];
+      _bucketCount[level + 1] += _bucketCount[level];
+      if(++_bucketChildren[level + 1] == PYRAMID_FANOUT) {
+         _closeBucket(level + 1);
+      }
+   }
+   _bucketCount[level] = 0;
+   _bucketChildren[level] = 0;
+}
+
+// Append the queued buckets to their level files (one open per level)
+void MyResultPyramid::flush() {
+   char levelFile[TEXT_PLUS_DATE_LEN + 4];
+   for(uint8_t level=0; level<PYRAMID_LEVELS && _pendingCount; level++) {
+      File levelFH;
+      for(uint8_t i=0; i<_pendingCount; i++) {
+         if(_pendingLevel[i] != level) {
+            continue;
+         }
+         if(!levelFH) {
+            getLevelFileName(_resultFile, level, levelFile);
+            levelFH = SD.open(levelFile, FILE_APPEND);
+            if(!levelFH) {
+               Serial.print(F("Error opening ")); Serial.println(levelFile);
+               break;
+            }
+         }
+         levelFH.write((const uint8_t *)&_pending[i], sizeof(pyramidRecord));
+      }
+      if(levelFH) {
+         levelFH.close();
+      }
+   }
+   _pendingCount = 0;
+}
+
+// The partly filled buckets get written too so the level files cover the whole session
+void MyResultPyramid::finish() {
+   if(_resultFile[0] == '\0') {
+      return;
+   }
+   for(uint8_t level=0; level<PYRAMID_LEVELS; level++) {
+      if(_bucketCount[level] > 0) {
+         _closeBucket(level);
+      }
+   }
+   flush();
+}
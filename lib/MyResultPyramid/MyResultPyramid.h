@@ -0,0 +1,88 @@
+
+// Multi-resolution summary of a logged result stream
+// dlf 
+
+#ifndef MyResultPyramid_h
+#define MyResultPyramid_h
+
+#include "Arduino.h"
+#include "MyDisplay.h"
+
+// For sd card
+#include <FS.h>
+#include <SPI.h>
+#include <SD.h>
+
+#define PYRAMID_LEVELS 3        // Levels of summary kept alongside each result file
+#define PYRAMID_FANOUT 16       // Each level summarizes 16 buckets of the level below (16, 256, 4096 samples)
+#define PYRAMID_PENDING 8       // Completed buckets we hold until the next flush to the SD card
+
+// One summary bucket.  Written to the level files as fixed size binary records so 
+// a reader can seek straight to any bucket.
+struct pyramidRecord {
+   float xFirst;      // X (time) of the first sample in the bucket
+   float xLast;       // X (time) of the last sample in the bucket
+   float minY;
+   float maxY;
+   float meanY;
+   uint32_t rawEnd;   // Byte offset in the raw CSV file just past the bucket's last sample
+};
+
+class MyResultPyramid  {
+
+   public:
+      //#######################################################################
+      // Constructor 
+      //#######################################################################
+      MyResultPyramid();
+
+      //#######################################
+      // Methods
+      //#######################################
+      // Start a new session for the given raw result file (empty name disables the pyramid)
+      void begin(const char *);
+
+      // Add one sample that was just written to the raw file.  rawEnd is the raw file position after the sample.
+      void add(float, float, uint32_t);
+
+      // Write any completed buckets out to the level files
+      void flush();
+
+      // Session is done.  Write out the partly filled buckets as well.
+      void finish();
+
+      // Number of samples summarized this session
+      uint32_t getSampleCount();
+
+      // The coarsest level that still has at least the given number of buckets (-1 if none do)
+      int8_t getLevelForBuckets(uint32_t);
+
+      // Samples per bucket for a level
+      static uint32_t getBucketSize(uint8_t);
+
+      // Build the level file name from the raw result file name (xxx.csv -> xxx.p16, xxx.p256, xxx.p4096)
+      static void getLevelFileName(const char *, uint8_t, char *);
+
+      // Binary search an open level file.  Index of the first record whose bucket ends at or after 
+      // the given X (the record count if none do).
+      static uint32_t findRecord(File *, float);
+
+   private:
+      // Close the bucket at the given level and roll it up into the level above
+      void _closeBucket(uint8_t);
+
+      char _resultFile[TEXT_PLUS_DATE_LEN];
+      uint32_t _sampleCount;
+
+      // Bucket being filled at each level
+      pyramidRecord _bucket[PYRAMID_LEVELS];
+      float _bucketSum[PYRAMID_LEVELS];
+      uint32_t _bucketCount[PYRAMID_LEVELS];   // Samples in the bucket
+      uint8_t _bucketChildren[PYRAMID_LEVELS]; // Buckets from the level below (level 0 counts samples)
+
+      // Completed buckets waiting to be written
+      pyramidRecord _pending[PYRAMID_PENDING];
+      uint8_t _pendingLevel[PYRAMID_PENDING];
+      uint8_t _pendingCount;
+};
+#endif
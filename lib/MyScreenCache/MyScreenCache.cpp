@@ -0,0 +1,226 @@
+
+// Compressed copies of recently shown screens.
+//
+// Drawing a menu means clearing the display and drawing the title, every button and every text line
+// over SPI.  The first time a screen is drawn it is read back from the display and kept here as a
+// palette + run length encoded image (menus are a few flat colors, so a full screen packs into a few
+// KB).  Next time the same screen is shown the whole image goes out as one address window, a row of
+// pixels at a time, and only the fields that changed since (button labels) need drawing on top of it.
+//
+// All the images share one fixed pool.  When a new one doesn't fit, the least recently used images
+// are dropped (and the pool compacted) until it does.
+//
+// dlf 
+
+#include "MyScreenCache.h"
+
+//####################################################################
+// Constructor.  
+//####################################################################
+MyScreenCache::MyScreenCache(TFT_eSPI *tftPtr){
+   _tftPtr = tftPtr;
+   _used = 0;
+   _tick = 0;
+   _hits = 0;
+   _misses = 0;
+   _capEntry = -1;
+   _capLen = 0;
+   for(uint8_t i=0; i<SCREEN_CACHE_ENTRIES; i++) {
+      _entries[i].key = 0;
+   }
+}
+
+//#######################################
+// Methods for the class
+//#######################################
+boolean MyScreenCache::restore(uint32_t key, uint32_t * fields) {
+   int8_t e = _find(key);
+   if(e < 0) {
+      _misses++;
+      return(false);
+   }
+   screenCacheEntry * entry = &_entries[e];
+   entry->lastUsed = ++_tick;
+   _hits++;
+
+   // The display wants the high byte first
+   uint16_t palette[SCREEN_CACHE_COLORS];
+   for(uint8_t i=0; i<entry->colors; i++) {
+      palette[i] = (entry->palette[i] >> 8) | (entry->palette[i] << 8);
+   }
+
+   // Runs carry on across rows so the whole screen is one address window.  Each row is unpacked
+   // into the line buffer and pushed in one go.
+   const uint8_t * in = _pool + entry->offset;
+   const uint8_t * end = in + entry->len;
+   boolean swap = _tftPtr->getSwapBytes();
+   _tftPtr->setSwapBytes(false);
+   _tftPtr->startWrite();
+   _tftPtr->setAddrWindow(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+   int x = 0;
+   while(in < end) {
+      uint8_t idx = *in >> 4;
+      uint32_t run = *in++ & 0x0F;
+      if(run == 0) {
+         run = in[0] | (in[1] << 8);
+         in += 2;
+      }
+      while(run > 0) {
+         _line[x++] = palette[idx];
+         run--;
+         if(x == SCREEN_WIDTH) {
+            _tftPtr->pushPixels(_line, SCREEN_WIDTH);
+            x = 0;
+         }
+      }
+   }
+   if(x > 0) {
+      _tftPtr->pushPixels(_line, x);
+   }
+   _tftPtr->endWrite();
+   _tftPtr->setSwapBytes(swap);
+
+   memcpy(fields, entry->fields, sizeof(entry->fields));
+   return(true);
+}
+
+// ###########################################################################
+// Runs are one byte of palette index<<4 | length for 1-15 pixels, longer runs
+// are index<<4 followed by a 16 bit length (low byte first).
+// ###########################################################################
+boolean MyScreenCache::capture(uint32_t key, const uint32_t * fields) {
+   int8_t e = _find(key);
+   if(e >= 0) {
+      _evict(e);
+   }
+
+   // Find a free slot (or make one)
+   e = -1;
+   for(uint8_t i=0; i<SCREEN_CACHE_ENTRIES && e < 0; i++) {
+      if(_entries[i].key == 0) {
+         e = i;
+      }
+   }
+   if(e < 0) {
+      _evictOldest();
+      for(uint8_t i=0; i<SCREEN_CACHE_ENTRIES && e < 0; i++) {
+         if(_entries[i].key == 0) {
+            e = i;
+         }
+      }
+   }
+   _capEntry = e;
+   _capLen = 0;
+   screenCacheEntry * entry = &_entries[e];
+   entry->colors = 0;
+
+   boolean ok = true;
+   uint16_t runColor = 0;
+   uint32_t run = 0;
+   for(int y=0; y<SCREEN_HEIGHT && ok; y++) {
+      _tftPtr->readRect(0, y, SCREEN_WIDTH, 1, _line);
+      for(int x=0; x<SCREEN_WIDTH && ok; x++) {
+         // readRect hands the colors back byte swapped (ready for pushImage)
+         uint16_t color = (_line[x] >> 8) | (_line[x] << 8);
+         if(run && color == runColor && run < 0xFFFF) {
+            run++;
+         } else {
+            ok = (run == 0) || _putRun(runColor, run);
+            runColor = color;
+            run = 1;
+         }
+      }
+   }
+   ok = ok && _putRun(runColor, run);
+   _capEntry = -1;
+   if(!ok) {
+      return(false);
+   }
+
+   entry->key = key;
+   entry->lastUsed = ++_tick;
+   entry->offset = _used;
+   entry->len = _capLen;
+   memcpy(entry->fields, fields, sizeof(entry->fields));
+   _used += _capLen;
+   return(true);
+}
+
+uint32_t MyScreenCache::getMemoryUsed() {
+   return(_used);
+}
+
+uint32_t MyScreenCache::getHits() {
+   return(_hits);
+}
+
+uint32_t MyScreenCache::getMisses() {
+   return(_misses);
+}
+
+int8_t MyScreenCache::_find(uint32_t key) {
+   for(uint8_t i=0; i<SCREEN_CACHE_ENTRIES; i++) {
+      if(key != 0 && _entries[i].key == key) {
+         return(i);
+      }
+   }
+   return(-1);
+}
+
+// Drop an image and close up the gap it leaves in the pool (including any capture in progress after it)
+void MyScreenCache::_evict(uint8_t e) {
+   screenCacheEntry * entry = &_entries[e];
+   uint32_t gapEnd = entry->offset + entry->len;
+   memmove(_pool + entry->offset, _pool + gapEnd, _used + _capLen - gapEnd);
+   for(uint8_t i=0; i<SCREEN_CACHE_ENTRIES; i++) {
+      if(_entries[i].key != 0 && _entries[i].offset > entry->offset) {
+         _entries[i].offset -= entry->len;
+      }
+   }
+   _used -= entry->len;
+   entry->key = 0;
+}
+
+// Drop the least recently used image.  False if there aren't any.
+boolean MyScreenCache::_evictOldest() {
+   int8_t oldest = -1;
+   for(uint8_t i=0; i<SCREEN_CACHE_ENTRIES; i++) {
+      if(_entries[i].key != 0 && i != _capEntry && (oldest < 0 || _entries[i].lastUsed < _entries[oldest].lastUsed)) {
+         oldest = i;
+      }
+   }
+   if(oldest < 0) {
+      return(false);
+   }
+   _evict(oldest);
+   return(true);
+}
+
+boolean MyScreenCache::_putRun(uint16_t color, uint32_t run) {
+   screenCacheEntry * entry = &_entries[_capEntry];
+   uint8_t idx = 0;
+   while(idx < entry->colors && entry->palette[idx] != color) {
+      idx++;
+   }
+   if(idx == entry->colors) {
+      if(entry->colors == SCREEN_CACHE_COLORS) {
+         return(false);
+      }
+      entry->palette[entry->colors++] = color;
+   }
+   if(run < 16) {
+      return(_putByte((idx << 4) | run));
+   }
+   return(_putByte(idx << 4) && _putByte(run & 0xFF) && _putByte(run >> 8));
+}
+
+// Append to the image being captured, making room if the pool is full
+boolean MyScreenCache::_putByte(uint8_t b) {
+   while(_used + _capLen >= SCREEN_CACHE_BYTES) {
+      if(!_evictOldest()) {
+         return(false);
+      }
+   }
+   _pool[_used + _capLen++] = b;
+   return(true);
+}
@@ -0,0 +1,75 @@
+
+// Compressed copies of recently shown screens so going back to one is a single blit
+// dlf 
+
+#ifndef MyScreenCache_h
+#define MyScreenCache_h
+
+#include "Arduino.h"
+#include "MyDisplay.h"
+
+// Uses the Bodmer TFT_eSPI graphics display library
+#include <TFT_eSPI.h>
+
+#define SCREEN_CACHE_BYTES   40960   // Memory budget for all the cached images
+// A slot for every screen, so it's the byte budget and not the slot count that decides what gets
+// evicted.  A screen's image is 1.5k to 8k, so the pool holds about 7 of them at once.
+#define SCREEN_CACHE_ENTRIES MAX_SCREENS   // Most images kept
+#define SCREEN_CACHE_COLORS  16      // Screens with more colors than this aren't cached
+#define SCREEN_CACHE_FIELDS  NUM_BUTTONS   // Field hashes kept with each image (the button labels)
+
+// One cached image.  Pixels are run length encoded in the pool (see capture()).
+struct screenCacheEntry {
+   uint32_t key;          // What the image is of (0 = empty slot)
+   uint32_t lastUsed;     // For the least recently used eviction
+   uint32_t offset;       // Into _pool
+   uint32_t len;
+   uint16_t palette[SCREEN_CACHE_COLORS];
+   uint8_t colors;
+   uint32_t fields[SCREEN_CACHE_FIELDS];   // Hashes of the dynamic fields as they are in the image
+};
+
+class MyScreenCache  {
+
+   public:
+      //#######################################################################
+      // Constructor 
+      //#######################################################################
+      MyScreenCache(TFT_eSPI *);
+
+      //#######################################
+      // Methods
+      //#######################################
+      // Push the image cached under the key to the display and hand back its field hashes.
+      // False if there isn't one.
+      boolean restore(uint32_t, uint32_t *);
+
+      // Read the display back and cache it under the key along with its field hashes.  Older
+      // images are dropped to make room.  False if it has too many colors or won't fit.
+      boolean capture(uint32_t, const uint32_t *);
+
+      uint32_t getMemoryUsed();
+      uint32_t getHits();
+      uint32_t getMisses();
+
+   private:
+      int8_t _find(uint32_t);
+      void _evict(uint8_t);
+      boolean _evictOldest();
+      boolean _putRun(uint16_t, uint32_t);
+      boolean _putByte(uint8_t);
+
+      TFT_eSPI *_tftPtr;
+      screenCacheEntry _entries[SCREEN_CACHE_ENTRIES];
+      uint8_t _pool[SCREEN_CACHE_BYTES];
+      uint32_t _used;          // Bytes of _pool holding finished images
+      uint32_t _tick;
+      uint32_t _hits;
+      uint32_t _misses;
+      uint16_t _line[SCREEN_WIDTH];
+
+      // Image being captured (it sits just past _used until it's done)
+      int8_t _capEntry;
+      uint32_t _capLen;
+};
+#endif
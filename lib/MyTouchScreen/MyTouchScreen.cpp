@@ -6,21 +6,151 @@
 // dlf 3/29/2023
 
 #include "MyTouchScreen.h"
+#include <MyCsvReader.h>
+
+// Block buffer used when reading logged results back from the SD card.  Only one screen
+// is ever drawing a graph so they all share this one.
+static char _csvBlock[CSV_BLOCK_SIZE] __attribute__((aligned(4)));
+
+// Cohen-Sutherland outcodes for clipping graph segments to the plot window
+#define CLIP_LEFT   1
+#define CLIP_RIGHT  2
+#define CLIP_TOP    4
+#define CLIP_BOTTOM 8
+#define CLIP_MAX_PASSES 8
+
+// Palette for the 4-bit plot sprite.  Colors passed to the plot drawing routines are looked up here
+// (anything not in the table plots as white).
+static const uint16_t _plotPalette[16] = {
+   TFT_BLACK, TFT_WHITE, TFT_BLUE, TFT_YELLOW, TFT_RED, TFT_GREEN, TFT_CYAN, TFT_MAGENTA,
+   TFT_ORANGE, TFT_DARKGREY, TFT_NAVY, TFT_GREY, TFT_BLACK, TFT_BLACK, TFT_BLACK, TFT_BLACK
+};
+#define PLOT_PALETTE_USED 12
+
+// FNV-1a hashing, for keying the graph chrome cache and spotting text fields that haven't changed
+#define FNV_OFFSET 2166136261UL
+#define FNV_PRIME  16777619UL
+static uint32_t _fnvBytes(uint32_t hash, const void * data, size_t len) {
+   const uint8_t * p = (const uint8_t *)data;
+   for(size_t i=0; i<len; i++) {
+      hash = (hash ^ p[i]) * FNV_PRIME;
+   }
+   return(hash);
+}
+static uint32_t _fnvString(uint32_t hash, const char * s) {
+   return(_fnvBytes(hash, s, strlen(s) + 1));
+}
+
+// Hash of a field's text (never 0, that means "not on the display")
+static uint32_t _fieldHash(const char * s) {
+   uint32_t hash = _fnvString(FNV_OFFSET, s);
+   return(hash ? hash : 1);
+}
+
+// Graph chrome cache.  The axis numbers, labels, title and legend around the plot window rarely change
+// between redraws, so each band around the window is rendered once, run length encoded into a slot of
+// _chromeCache (mostly black, so a band packs down to a few KB) and pushed back from there.  There's one
+// display so this is shared by all the screens.
+struct chromeBand {
+   int16_t x, y, w, h;     // Screen rectangle
+   uint16_t offset, size;  // Slot in _chromeCache
+};
+static const chromeBand _chromeBands[CHROME_BANDS] = {
+   { 0, 0, GRAPH_X_ORIGIN, (GRAPH_Y_ORIGIN) + 1, 0, 3072 },                                          // Y numbers and label
+   { GRAPH_X_ORIGIN, 0, GRAPH_PLOT_W, GRAPH_Y_TOP, 3072, 1536 },                                     // Title/legend
+   { (GRAPH_X_RIGHT) + 1, 0, SCREEN_WIDTH - (GRAPH_X_RIGHT) - 1, (GRAPH_Y_ORIGIN) + 1, 4608, 1024 }, // Overlay right axis
+   { 0, (GRAPH_Y_ORIGIN) + 1, SCREEN_WIDTH, GRAPH_PAN_Y_BOTTOM - (GRAPH_Y_ORIGIN), 5632, 2560 }      // X numbers and label
+};
+static uint8_t _chromeCache[CHROME_CACHE_SIZE];
+static uint16_t _chromeCacheLen[CHROME_BANDS];
+static uint32_t _chromeCacheKey[CHROME_BANDS];   // Key of what's in each slot (0 = empty)
+static uint32_t _chromeShownKey[CHROME_BANDS];   // Key of what's on the display
+static uint16_t _chromeLine[SCREEN_WIDTH];       // One decoded row
+static boolean _graphShown = false;              // The graph screen is what's on the display (drawScreen clears it)
+
+// Screen state arena.  Zero initialized static data, so it's ready before any of the screen objects
+// get constructed.  MAX_SCREENS has to cover every screen object (main.h checks the sketch's at compile time).
+// Screens past MAX_SCREENS share the spare block so nothing gets overwritten, and are counted so setup() can
+// report it (see getArenaOverflow).
+static screenStorage _screenArena[MAX_SCREENS];
+static screenStorage _screenArenaSpare;
+static uint8_t _screenArenaUsed = 0;
+static uint8_t _screenArenaOverflow = 0;
+
+// Press state is a bit per button
+static_assert(NUM_BUTTONS <= 32, "Button press bits don't fit in a uint32_t");
+#define BUTTON_BIT(b) (1UL << (b))
+
+// Label handed to the button drawing (our own labels go over the top, see drawButtonTextSprite)
+static char _noLabel[1] = "";
+
+// Result text column.  The text sprite fields are composed into one sprite covering the whole column and the
+// span of fields that changed is pushed in one transfer.  The sprite is shared by all the screens so we keep
+// track of whose column (and where) it holds.
+static MyTouchScreen * _textColumnOwner = NULL;
+static int _textColumnX = 0;
+static int _textColumnY = 0;
+
+// Glyphs for drawing the result values into the column without going through drawString (see setTextAtlas)
+static MyGlyphAtlas * _textAtlas = NULL;
+
+// Images of screens drawn before (see setScreenCache)
+static MyScreenCache * _screenCache = NULL;
 
 //####################################################################
 // Constructor.  Pass all the screen pointers to the screen object.
 //####################################################################
 MyTouchScreen::MyTouchScreen(TFT_eSPI *tftPtr,TFT_eSprite *btnTextSpritePtr, TFT_eSprite *textSpritePtr, TFT_eSprite *statusSpritePtr, 
-                             TFT_eSprite *yAxisSpritePtr, TFT_eSprite *clockSpritePtr, const char *title, boolean titleVisible){
+                             TFT_eSprite *yAxisSpritePtr, TFT_eSprite *clockSpritePtr, TFT_eSprite *plotSpritePtr,
+                             const char *title, boolean titleVisible){
+   // Static construction, too early to print anything
+   if(_screenArenaUsed < MAX_SCREENS) {
+      _storage = &_screenArena[_screenArenaUsed++];
+   } else {
+      _storage = &_screenArenaSpare;
+      _screenArenaOverflow++;
+   }
+   _buttonLabels = _storage->buttonLabels;
+   _buttonValueSize = _storage->buttonValueSize;
+   _buttonVisible = _storage->buttonVisible;
+   _textFields = _storage->textFields;
+   _textSpriteFields = _storage->textSpriteFields;
+   _clockSpriteFields = _storage->clockSpriteFields;
+   _buttonTextHash = _storage->buttonTextHash;
+
    _tftPtr = tftPtr;
    _clockSpritePtr = clockSpritePtr;
    _btnTextSpritePtr = btnTextSpritePtr;
    _textSpritePtr = textSpritePtr;
    _statusSpritePtr = statusSpritePtr;
    _yAxisSpritePtr = yAxisSpritePtr;
+   _plotSpritePtr = plotSpritePtr;
+   _plotToSprite = false;
+   _dirtyX0 = 1; _dirtyX1 = 0;
+   _graphMode = GRAPH_MODE_FULL;
+   _stripWindow = 0.0;
+   _overlayChannels = 1;
+   _plotArea.left = GRAPH_X_ORIGIN;
+   _plotArea.top = GRAPH_Y_TOP;
+   _plotArea.right = GRAPH_X_RIGHT;
+   _plotArea.bottom = GRAPH_Y_ORIGIN;
+   _splitView = false;
+   _cursorShown = false;
+   _cursorX = -1;
+   _cursorChannels = 0;
+   for(uint8_t ch=0; ch<GRAPH_CHANNELS; ch++) {
+      _channelColor[ch] = TFT_WHITE;
+      _channelLabel[ch] = "";
+      _channelMin[ch] = 0.0;
+      _channelMax[ch] = 0.0;
+   }
+   _layoutViewports();
    _title = title;
    _type = "";
    _titleVisible = titleVisible;
+   _layout = NULL;
+   _buttonPressed = 0;
+   _buttonWasPressed = 0;
 }
 
 
@@ -29,41 +159,102 @@ MyTouchScreen::MyTouchScreen(TFT_eSPI *tftPtr,TFT_eSprite *btnTextSpritePtr, TFT
 //#######################################
 
 
-// Initialize the screen parameters.  Set all buttons to invisible with blank label text (nopS = "").
-// Set all text fields to nopS as well to make invisible.  In the main setup code, each screen object
-// will be loaded with its required screen settings.
+// Initialize the screen parameters.  Set all buttons to invisible with blank labels.  Set all text fields
+// to blank as well to make invisible.  In the main setup code, each screen object will be loaded with its
+// required screen settings.
 void MyTouchScreen::init(MyTouchScreen * screenPtr){
 
-   // Create the button objects and default to invisible, nop callbacks, and blank text (_nopS)
-   strcpy(_nopS,"");
-   _tftPtr->setFreeFont(LABEL0B_FONT);
-   for(uint8_t row=0; row<BUTTON_ROWS; row++) {
-      for(uint8_t col=0; col<BUTTON_COLUMNS;col++) {
-         uint8_t bIndex = col + row * BUTTON_COLUMNS;
-
-
-            // x, y, w, h, outline, fill, button text, textsize
-            _buttonsPtr[bIndex].initButton(_tftPtr, KEY_X + col * (KEY_W + KEY_SPACING_X) , KEY_Y + row * ( KEY_H + KEY_SPACING_Y),
-                                                    KEY_W, KEY_H, TFT_WHITE, TFT_BLUE, TFT_WHITE,_nopS, KEY_TEXTSIZE);
-            strcpy(_buttonLabels+(sizeof(char)*TITLE_LEN+1)*bIndex, _nopS); // clear all button labels
-            *(_buttonVisible+bIndex) = false;    // start with the buttons turned off
-            _buttonsPtr[bIndex].press(false);  // clear any previous button press state
-      }
+   // Buttons default to invisible with no label or press state
+   for(uint8_t bIndex=0; bIndex<NUM_BUTTONS; bIndex++) {
+      _buttonLabels[bIndex] = "";    // clear all button labels
+      _buttonValueSize[bIndex] = 0;
+      _buttonVisible[bIndex] = false;    // start with the buttons turned off
    }
-   strcpy(_textSpriteNopS,"");
+   _buttonWasPressed = _buttonPressed;  // clear any previous button press state
+   _buttonPressed = 0;
    for(uint8_t row=0; row<TEXT_ROWS; row++) {
       _textVisible[row] = false;
-      strcpy(_textFields+((sizeof(char)*TEXT_LEN)+1)*row, _nopS); // clear all the text fields
+      _textFields[row] = "";          // clear all the text fields
       _textSpriteVisible[row] = false;
-      strcpy(_textSpriteFields+((sizeof(char)*TEXT_LEN)+1)*row, _textSpriteNopS); // clear all the text sprint fields
+      _textSpriteFields[row] = "";    // clear all the text sprite fields
+   }
+   for(uint8_t row=0; row<CLOCK_ROWS; row++) {
+      _clockSpriteFields[row] = "";   // clear the clock sprite fields
+   }
+   _invalidateFields();
+   _layout = NULL;
+}
+
+// Set the screen up from a layout table.  The fields point at the layout's strings (and bound settings at
+// their variables) so nothing gets copied.  Loading the same layout again only clears the press state.
+void MyTouchScreen::loadLayout(const screenLayout * layout) {
+   if(layout == _layout) {
+      _buttonWasPressed = _buttonPressed;
+      _buttonPressed = 0;
+      return;
    }
-   strcpy(_clockSpriteFields,  _textSpriteNopS);      // clear the clock sprint field
-   strcpy(_clockSpriteFields+(sizeof(char)*TEXT_LEN+1),  _textSpriteNopS);      // clear the clock sprint field
+   init(this);
+
+   for(uint8_t i=0; i<layout->numButtons; i++) {
+      enableButton(layout->buttons[i].button, layout->buttons[i].label, layout->buttons[i].callBack);
+      _buttonValueSize[layout->buttons[i].button] = layout->buttons[i].valueSize;
+   }
+   for(uint8_t i=0; i<layout->numText; i++) {
+      enableTextField(layout->text[i].field, layout->text[i].text, layout->text[i].x, layout->text[i].y);
+   }
+   for(uint8_t i=0; i<layout->numSprites; i++) {
+      enableTextSprite(layout->sprites[i].field, layout->sprites[i].text, layout->sprites[i].x, layout->sprites[i].y);
+   }
+   for(uint8_t i=0; i<layout->numClocks; i++) {
+      enableClockSprite(layout->clocks[i].field, layout->clocks[i].text, layout->clocks[i].x, layout->clocks[i].y);
+   }
+   _layout = layout;
+}
+
+// Forget what the sprite fields/button labels have on the display so they all get drawn next time
+void MyTouchScreen::_invalidateFields() {
+   for(uint8_t row=0; row<TEXT_ROWS; row++) {
+      _textSpriteHash[row] = 0;
+   }
+   for(uint8_t row=0; row<CLOCK_ROWS; row++) {
+      _clockSpriteHash[row] = 0;
+   }
+   for(uint8_t bIndex=0; bIndex<NUM_BUTTONS; bIndex++) {
+      _buttonTextHash[bIndex] = 0;
+   }
+   _textColumnOwner = NULL;
 }
 
 //#######################################
 // Screen drawing methods
 //#######################################
+// Bytes used by a screen: the object itself plus its state block.  Fixed at compile time, every screen is
+// the same size (getArenaUsed has what's been handed out).
+uint32_t MyTouchScreen::getMemoryUsed() {
+   return(sizeof(MyTouchScreen) + sizeof(screenStorage));
+}
+
+// Bytes of the state arena handed out so far, and its total size
+uint32_t MyTouchScreen::getArenaUsed() {
+   return(_screenArenaUsed * sizeof(screenStorage));
+}
+uint32_t MyTouchScreen::getArenaSize() {
+   return(MAX_SCREENS * sizeof(screenStorage));
+}
+
+// Screens that didn't get a block of their own (0 unless MAX_SCREENS is too small)
+uint8_t MyTouchScreen::getArenaOverflow() {
+   return(_screenArenaOverflow);
+}
+
+void MyTouchScreen::setTextAtlas(MyGlyphAtlas * atlasPtr) {
+   _textAtlas = atlasPtr;
+}
+
+void MyTouchScreen::setScreenCache(MyScreenCache * cachePtr) {
+   _screenCache = cachePtr;
+}
+
 // Manage the screen title
 const char * MyTouchScreen::getScreenTitle() {
    return(_title);
@@ -83,15 +274,28 @@ void MyTouchScreen::drawScreenText(){
    _tftPtr->setFreeFont(TEXT_FONT);
    for(uint8_t row=0; row<TEXT_ROWS;row++) {
       if(_textVisible[row]) {
-         //_tftPtr->drawString(_textFields[row],_textCoords[row][0],_textCoords[row][1],GFXFF);
-         _tftPtr->drawString(_textFields+((sizeof(char)*TEXT_LEN)+1)*row,_textCoords[row][0],_textCoords[row][1],GFXFF);
+         _tftPtr->drawString(_textFields[row],_textCoords[row][0],_textCoords[row][1],GFXFF);
       }
    }
 }
 
-// Draw the screen title and for all visible buttons, draw the button and add the text overlay to it
+// Draw the screen title and for all visible buttons, draw the button and add the text overlay to it.
+// If it's been drawn the same way before it comes from the screen cache and only the button labels
+// that have changed since get drawn over it.
 void MyTouchScreen::drawScreen(){
 
+   _graphShown = false;
+   _invalidateFields();
+
+   uint32_t key = 0;
+   if(_screenCache != NULL) {
+      key = _screenKey();
+      if(_screenCache->restore(key, _buttonTextHash)) {
+         MyTouchScreen::drawButtonTextSprite();
+         return;
+      }
+   }
+
    _tftPtr->fillScreen(TFT_BLACK);
    _tftPtr->setTextColor(TITLE_COLOR, TFT_BLACK);
    _tftPtr->setTextDatum(TITLE_DATUM);
@@ -100,15 +304,9 @@ void MyTouchScreen::drawScreen(){
       _tftPtr->drawString(_title,TITLE_X,TITLE_Y,GFXFF);
    }
 
-   for(uint8_t row=0; row<BUTTON_ROWS; row++) {
-      for(uint8_t col=0; col<BUTTON_COLUMNS;col++) {
-         uint8_t bIndex = col + row * BUTTON_COLUMNS;
-                                            
-         if(*(_buttonVisible+bIndex)) {
-            // Draw the button
-            _buttonsPtr[bIndex].setLabelDatum(0,0,MC_DATUM);
-            _buttonsPtr[bIndex].drawButton();
-         }
+   for(uint8_t bIndex=0; bIndex<NUM_BUTTONS; bIndex++) {
+      if(_buttonVisible[bIndex]) {
+         _drawKey(bIndex, false);
       }
    }
 
@@ -117,63 +315,137 @@ void MyTouchScreen::drawScreen(){
 
    // Now add any text lines outside the buttons
    MyTouchScreen::drawScreenText();
+
+   if(_screenCache != NULL) {
+      _screenCache->capture(key, _buttonTextHash);
+   }
 }
 
 // For drawing the clock text fields.  Separate method as the clock field is very wide compared to the usual result fields.
-// We still use the _textSpriteFields array to hold the string but use a wider _clockSprite for drawing the sprite
+// The strings are in _clockSpriteFields (like the result fields) but drawn with the wider _clockSprite.
+// Like the other sprite fields, a line is only redrawn when its text has changed.
 void MyTouchScreen::drawClockSprite() {
    _clockSpritePtr->setFreeFont(TEXT_FONT);
    _clockSpritePtr->setTextColor(TFT_WHITE, TFT_BLACK);
    _clockSpritePtr->setTextDatum(TEXT_DATUM);
 
-   // Current time line
-   _clockSpritePtr->fillSprite(TFT_BLACK);
-   //_clockSpritePtr->drawString(_clockSpriteFields[0],0,0,GFXFF);
-   _clockSpritePtr->drawString(_clockSpriteFields,0,0,GFXFF);
-   _clockSpritePtr->pushSprite(_clockSpriteCoords[0][0], _clockSpriteCoords[0][1]);
-
-   // Alarm line
-   _clockSpritePtr->fillSprite(TFT_BLACK);
-   //_clockSpritePtr->drawString(_clockSpriteFields[1],0,0,GFXFF);
-   _clockSpritePtr->drawString(_clockSpriteFields+(sizeof(char)*TEXT_LEN+1),0,0,GFXFF);
-   _clockSpritePtr->pushSprite(_clockSpriteCoords[1][0], _clockSpriteCoords[1][1]);
+   // Row 0 is the current time line, row 1 the alarm line
+   for(uint8_t row=0; row<CLOCK_ROWS; row++) {
+      const char * text = _clockSpriteFields[row];
+      uint32_t hash = _fieldHash(text);
+      if(hash == _clockSpriteHash[row]) {
+         continue;
+      }
+      _clockSpriteHash[row] = hash;
+      _clockSpritePtr->fillSprite(TFT_BLACK);
+      _clockSpritePtr->drawString(text,0,0,GFXFF);
+      _clockSpritePtr->pushSprite(_clockSpriteCoords[row][0], _clockSpriteCoords[row][1]);
+   }
 }
 
 // For drawing the text fields where we store dynamically changing text fields like sensor results, etc.
+// Fields whose text is the same as what's already on the display are skipped (most loops only one or two
+// of the results actually change).  The rest are drawn into the column sprite and each run of touching
+// changed fields is pushed with one windowed transfer.  Fields with a gap between them go separately, the
+// blank rows would cost more on the bus than the extra transfer does.
 void MyTouchScreen::drawTextSprite() {
+
+   // The column starts at the top left of the visible fields
+   int colX = SCREEN_WIDTH;
+   int colY = SCREEN_HEIGHT;
+   for(uint8_t row=0; row<TEXT_ROWS; row++) {
+      if(_textSpriteVisible[row]) {
+         colX = min(colX, _textSpriteCoords[row][0]);
+         colY = min(colY, _textSpriteCoords[row][1]);
+      }
+   }
+   if(colX == SCREEN_WIDTH) {
+      return;
+   }
+
+   // Start the sprite over if it holds another screen's column (or this one moved)
+   if(_textColumnOwner != this || colX != _textColumnX || colY != _textColumnY) {
+      _textSpritePtr->fillSprite(TFT_BLACK);
+      for(uint8_t row=0; row<TEXT_ROWS; row++) {
+         _textSpriteHash[row] = 0;
+      }
+      _textColumnOwner = this;
+      _textColumnX = colX;
+      _textColumnY = colY;
+   }
+
    _textSpritePtr->setFreeFont(TEXT_FONT);
    _textSpritePtr->setTextColor(TFT_WHITE, TFT_BLACK);
    _textSpritePtr->setTextDatum(TEXT_DATUM);
 
+   int top = TEXT_COLUMN_HEIGHT;
+   int bottom = 0;
    for(uint8_t row=0; row<TEXT_ROWS; row++) {
       if(_textSpriteVisible[row]) {
+         const char * text = _textSpriteFields[row];
+         uint32_t hash = _fieldHash(text);
+         if(hash == _textSpriteHash[row]) {
+            continue;
+         }
+         _textSpriteHash[row] = hash;
+
+         int x = _textSpriteCoords[row][0] - colX;
+         int y = _textSpriteCoords[row][1] - colY;
+         if(x != 0 || y + TEXT_SP_HEIGHT > TEXT_COLUMN_HEIGHT) {
+            // Not in the column.  Draw it straight to the display.
+            _tftPtr->setFreeFont(TEXT_FONT);
+            _tftPtr->setTextColor(TFT_WHITE, TFT_BLACK);
+            _tftPtr->setTextDatum(TEXT_DATUM);
+            _tftPtr->fillRect(_textSpriteCoords[row][0], _textSpriteCoords[row][1], TEXT_SP_WIDTH, TEXT_SP_HEIGHT, TFT_BLACK);
+            _tftPtr->drawString(text, _textSpriteCoords[row][0], _textSpriteCoords[row][1], GFXFF);
+            continue;
+         }
 
-         // Clear the sprite text
-         _textSpritePtr->fillSprite(TFT_BLACK);
-         //_textSpritePtr->drawString(_textSpriteFields[row],0,0,GFXFF);
-         _textSpritePtr->drawString(_textSpriteFields+((sizeof(char)*TEXT_LEN)+1)*row,0,0,GFXFF);
-         _textSpritePtr->pushSprite(_textSpriteCoords[row][0], _textSpriteCoords[row][1]);
+         // Clear the field's rows of the column and draw the new text (clipped to the field like a
+         // sprite of its own would).  Plain numbers come straight from the glyph atlas.
+         if(_textAtlas == NULL || !_textAtlas->drawString(_textSpritePtr, text, 0, y, TEXT_SP_WIDTH, TEXT_SP_HEIGHT)) {
+            _textSpritePtr->setViewport(0, y, TEXT_SP_WIDTH, TEXT_SP_HEIGHT);
+            _textSpritePtr->fillSprite(TFT_BLACK);
+            _textSpritePtr->drawString(text, 0, 0, GFXFF);
+            _textSpritePtr->resetViewport();
+         }
+         if(bottom > top && (y > bottom || y + TEXT_SP_HEIGHT < top)) {
+            _textSpritePtr->pushSprite(colX, colY + top, 0, top, TEXT_SP_WIDTH, bottom - top);
+            top = TEXT_COLUMN_HEIGHT;
+            bottom = 0;
+         }
+         top = min(top, y);
+         bottom = max(bottom, y + TEXT_SP_HEIGHT);
       }
    }
+
+   if(bottom > top) {
+      _textSpritePtr->pushSprite(colX, colY + top, 0, top, TEXT_SP_WIDTH, bottom - top);
+   }
 }
 
 // For drawing the button text overlay.  We will call only this function for cases where we
 // are using the button label to display user-modifiable options (alarm on/off, limits , etc.)
+// Only labels that changed (or whose button was redrawn underneath them) are drawn.
 void MyTouchScreen::drawButtonTextSprite() {
+   _btnTextSpritePtr->setFreeFont(LABEL0B_FONT);
+   _btnTextSpritePtr->setTextColor(TFT_WHITE, TFT_BLUE);
+   _btnTextSpritePtr->setTextDatum(BUTTON_TEXT_DATUM);
+
    for(uint8_t row=0; row<BUTTON_ROWS; row++) {
       for(uint8_t col=0; col<BUTTON_COLUMNS;col++) {
          uint8_t bIndex = col + row * BUTTON_COLUMNS;
 
-         if(*(_buttonVisible+bIndex)) {
+         if(_buttonVisible[bIndex]) {
+            uint32_t hash = _fieldHash(_buttonLabels[bIndex]);
+            if(hash == _buttonTextHash[bIndex]) {
+               continue;
+            }
+            _buttonTextHash[bIndex] = hash;
 
             // Clear the sprite text that we overlay on the buttons
-            _btnTextSpritePtr->setFreeFont(LABEL0B_FONT);
-            _btnTextSpritePtr->setTextColor(TFT_WHITE, TFT_BLUE);
-            _btnTextSpritePtr->setTextDatum(BUTTON_TEXT_DATUM);
-
             _btnTextSpritePtr->fillSprite(TFT_BLUE);
-            //_btnTextSpritePtr->drawString(_buttonLabels[bIndex],(BUTTON_TEXT_SP_WIDTH/2),(BUTTON_TEXT_SP_HEIGHT/2-2),GFXFF);
-            _btnTextSpritePtr->drawString(_buttonLabels+(sizeof(char)*TITLE_LEN+1)*bIndex,(BUTTON_TEXT_SP_WIDTH/2),(BUTTON_TEXT_SP_HEIGHT/2-2),GFXFF);
+            _btnTextSpritePtr->drawString(_buttonLabels[bIndex],(BUTTON_TEXT_SP_WIDTH/2),(BUTTON_TEXT_SP_HEIGHT/2-2),GFXFF);
             _btnTextSpritePtr->pushSprite(KEY_X + col * (KEY_W + KEY_SPACING_X)  - BUTTON_TEXT_SP_WIDTH/2 , 
                                     KEY_Y + row * ( KEY_H + KEY_SPACING_Y) - BUTTON_TEXT_SP_HEIGHT/2 - 2);  // Scooch it up 2 pixels for better centering
          }
@@ -191,12 +463,65 @@ void MyTouchScreen::setXAxis(float min, float max, float numberOfIntervals, cons
    _xAxisMax = max;
    _xAxisIntervals = numberOfIntervals;
    _xAxisLabel = label;
+   setGraphTransform(min, max, _plotArea.right - _plotArea.left, _plotArea.left, &_xTransform);
 }
 void MyTouchScreen::setYAxis(float min, float max, float numberOfIntervals, const char * label){
    _yAxisMin = min;
    _yAxisMax = max;
    _yAxisIntervals = numberOfIntervals;
    _yAxisLabel = label;
+   setOverlayChannel(0, min, max, label, TFT_WHITE);
+}
+
+// Y scale, legend label and trace color for one channel of an overlay graph (channel 0 is the setYAxis one)
+void MyTouchScreen::setOverlayChannel(uint8_t channel, float min, float max, const char * label, uint16_t color){
+   if(channel >= GRAPH_CHANNELS) {
+      return;
+   }
+   _channelMin[channel] = min;
+   _channelMax[channel] = max;
+   _channelLabel[channel] = label;
+   _channelColor[channel] = color;
+   // Pixel Y runs down the screen so the scale is negative
+   graphViewport * vp = &_viewport[_channelVp(channel)];
+   setGraphTransform(min, max, -(vp->bottom - vp->top), vp->bottom, &_yTransform[channel]);
+}
+
+void MyTouchScreen::setGraphMode(uint8_t mode) {
+   _graphMode = mode;
+}
+
+void MyTouchScreen::setSplitView(boolean split) {
+   _splitView = split;
+}
+
+// One viewport covering the whole plot area, or for a split view the plot area cut into a stack of one 
+// per channel.  Each channel's Y transform is redone to fit the viewport it's drawn in.
+void MyTouchScreen::_layoutViewports() {
+   _viewports = (_splitView && _overlayChannels > 1) ? _overlayChannels : 1;
+   int height = (_plotArea.bottom - _plotArea.top + 1 - GRAPH_SPLIT_GAP * (_viewports - 1)) / _viewports;
+   for(uint8_t v=0; v<GRAPH_CHANNELS; v++) {
+      _viewport[v] = _plotArea;
+      if(_viewports > 1 && v < _viewports) {
+         _viewport[v].top = _plotArea.top + v * (height + GRAPH_SPLIT_GAP);
+         _viewport[v].bottom = (v == _viewports - 1) ? _plotArea.bottom : _viewport[v].top + height - 1;
+      }
+   }
+   for(uint8_t ch=0; ch<GRAPH_CHANNELS; ch++) {
+      graphViewport * vp = &_viewport[_channelVp(ch)];
+      setGraphTransform(_channelMin[ch], _channelMax[ch], -(vp->bottom - vp->top), vp->bottom, &_yTransform[ch]);
+   }
+   _vp = 0;
+}
+
+// Viewport a channel is drawn in
+uint8_t MyTouchScreen::_channelVp(uint8_t channel) {
+   return((channel < _viewports) ? channel : 0);
+}
+
+// Y grid intervals of a viewport.  The mini-plots of a split view are too short for the full set.
+float MyTouchScreen::_viewportIntervals() {
+   return((_viewports > 1) ? GRAPH_SPLIT_INTERVALS : _yAxisIntervals);
 }
 
 
@@ -204,187 +529,980 @@ void MyTouchScreen::setYAxis(float min, float max, float numberOfIntervals, cons
 // Draw the graphing screen
 // ###########################
 void MyTouchScreen::drawGraph(boolean resultArraysFilled, const char * resultFile,
-                              int resultIndex, float * resultsArrXAxisPtr, float * resultsArrYAxisPtr){
+                              int resultIndex, float * resultsArrXAxisPtr, float * resultsArrYAxisPtr,
+                              MyResultPyramid * pyramidPtr){
+   _overlayChannels = 1;
+   _layoutViewports();
+   _drawGraphFrame(resultIndex, resultsArrXAxisPtr);
+   _replayChannel(0, resultArraysFilled, resultFile, resultIndex, resultsArrXAxisPtr, resultsArrYAxisPtr, pyramidPtr);
+   _pushPlot();
+}
 
-   float prevDataX = 0.0;
-   float prevDataY = 0.0;
-   float dataX = 0.0;
-   float dataY = 0.0;
-   char buff[FLOAT_STRING_WIDTH]; // For converting itoa for the graph labels
-   _tftPtr->fillScreen(TFT_BLACK);
-   _tftPtr->setTextColor(TITLE_COLOR, TFT_BLACK);
-   _tftPtr->setTextDatum(TITLE_DATUM);
-   _tftPtr->setFreeFont(TITLE_FONT);
-   if(_titleVisible) {
-      _tftPtr->drawString(_title,TITLE_X,TITLE_Y,GFXFF);
+// ###########################################################################
+// Overlay graph.  All the channels of a session on the one plot, each in its 
+// own color and Y scale (channel 0 from setYAxis, the rest from 
+// setOverlayChannel).  Channel 0's scale is on the left axis, channel 1's on
+// the right.  Every channel is replayed into the plot sprite before the one 
+// push, so each result file is read once and the screen is drawn once.
+// ###########################################################################
+void MyTouchScreen::drawOverlayGraph(uint8_t channels, boolean resultArraysFilled, const char ** resultFiles,
+                                     int resultIndex, float ** resultsArrXAxisPtrs, float ** resultsArrYAxisPtrs,
+                                     MyResultPyramid ** pyramidPtrs){
+   _overlayChannels = (channels > GRAPH_CHANNELS) ? GRAPH_CHANNELS : channels;
+   _layoutViewports();
+   _drawGraphFrame(resultIndex, resultsArrXAxisPtrs[0]);
+
+   for(uint8_t ch=0; ch<_overlayChannels; ch++) {
+      _replayChannel(ch, resultArraysFilled, resultFiles[ch], resultIndex, resultsArrXAxisPtrs[ch], resultsArrYAxisPtrs[ch],
+                     pyramidPtrs[ch]);
    }
+   _pushPlot();
+}
 
-   // Draw any buttons used by the graphing screen
-   for(uint8_t row=0; row<BUTTON_ROWS; row++) {
-      for(uint8_t col=0; col<BUTTON_COLUMNS;col++) {
-         uint8_t bIndex = col + row * BUTTON_COLUMNS;
-                                            
-         if(*(_buttonVisible+bIndex)) {
-            // Draw the button
-            _buttonsPtr[bIndex].setLabelDatum(0,0,MC_DATUM);
-            _buttonsPtr[bIndex].drawButton();
+// ###########################################################################
+// Everything but the data.  Title, buttons, plot border/grid, axis labels.
+// ###########################################################################
+void MyTouchScreen::_drawGraphFrame(int resultIndex, float * resultsArrXAxisPtr) {
+
+   // Buttons only need drawing when we're coming from another screen
+   if(!_graphShown) {
+      _invalidateFields();
+      _tftPtr->fillRect(0, GRAPH_PAN_Y_BOTTOM + 1, SCREEN_WIDTH, SCREEN_HEIGHT - GRAPH_PAN_Y_BOTTOM - 1, TFT_BLACK);
+      for(uint8_t bIndex=0; bIndex<NUM_BUTTONS; bIndex++) {
+         if(_buttonVisible[bIndex]) {
+            _drawKey(bIndex, false);
          }
       }
+      // Fill in the text overlays on the visible buttons
+      MyTouchScreen::drawButtonTextSprite();
    }
-   // Fill in the text overlays on the visible buttons
-   MyTouchScreen::drawButtonTextSprite();
 
-   // Draw the graph outer borders
-   _tftPtr->drawLine(GRAPH_X_ORIGIN, GRAPH_Y_ORIGIN, GRAPH_X_RIGHT, GRAPH_Y_ORIGIN, TFT_YELLOW);
-   _tftPtr->drawLine(GRAPH_X_ORIGIN, GRAPH_Y_ORIGIN, GRAPH_X_ORIGIN, GRAPH_Y_TOP, TFT_YELLOW);
-   _tftPtr->drawLine(GRAPH_X_ORIGIN, GRAPH_Y_TOP, GRAPH_X_RIGHT, GRAPH_Y_TOP, TFT_YELLOW);
-   _tftPtr->drawLine(GRAPH_X_RIGHT, GRAPH_Y_ORIGIN, GRAPH_X_RIGHT, GRAPH_Y_TOP, TFT_YELLOW);
+   // The plot window is built up off-screen (if we have the sprite) and pushed to the display in one go
+   // once the trace is drawn.
+   _plotBegin();
+
+   // A strip chart keeps the same window width but slides it so it ends at the newest sample
+   float xLabelStart = _xAxisMin;
+   if(_stripActive()) {
+      _stripWindow = _xAxisMax - _xAxisMin;
+      float newest = 0.0;
+      if(resultIndex > 0) {
+         newest = *(resultsArrXAxisPtr + resultIndex - 1);
+      }
+      setXAxis(newest - _stripWindow, newest, _xAxisIntervals, _xAxisLabel);
+      xLabelStart = -_stripWindow;   // Labels count back from "now"
+   }
 
-   // Add the internal grid lines and labels.
-   _tftPtr->setTextColor(TFT_WHITE, TFT_BLACK);
-   _tftPtr->setFreeFont(LABEL0_FONT);
+   // Axis numbers/labels from the chrome cache.  If there's no RAM to render a band in, draw the lot straight
+   // to the display like we used to.
+   boolean direct = false;
+   for(uint8_t band=0; band<CHROME_BANDS; band++) {
+      if(!_showChromeBand(band, xLabelStart)) {
+         direct = true;
+      }
+   }
+   if(direct) {
+      for(uint8_t band=0; band<CHROME_BANDS; band++) {
+         _tftPtr->fillRect(_chromeBands[band].x, _chromeBands[band].y, _chromeBands[band].w, _chromeBands[band].h, TFT_BLACK);
+         _chromeShownKey[band] = 0;
+      }
+      _drawChrome(NULL, 0, 0, xLabelStart);
+   }
+   _graphShown = true;
 
-   // xstep/ystep are the delta-value per grid line (e.g. 100/0 degree delta over 10 grids is 10 degrees per step)
-   float xstep = (_xAxisMax - _xAxisMin)/_xAxisIntervals;
-   float ystep = (_yAxisMax - _yAxisMin)/_yAxisIntervals;
+   // Without the plot sprite the plot window is drawn directly so clear it (and any label overhang) first
+   if(!_plotToSprite) {
+      _tftPtr->fillRect(_plotArea.left, _plotArea.top, GRAPH_PLOT_W, GRAPH_PLOT_H, TFT_BLACK);
+   }
+   _drawPlotFrame();
+   _cursorShown = false;   // Gone under the new plot (the top band readout was restored above)
+}
+
+// ###########################################################################
+// Put one band of the graph chrome on the display.  Nothing to do if it's
+// already there, pushed from the RLE cache if we've rendered it before with
+// the same axes, otherwise rendered into a scratch sprite (and cached).
+// Returns false if the scratch sprite couldn't be allocated.
+// ###########################################################################
+boolean MyTouchScreen::_showChromeBand(uint8_t band, float xLabelStart) {
+   const chromeBand * b = &_chromeBands[band];
+   uint32_t key = _chromeKey(band, xLabelStart);
+
+   if(_graphShown && _chromeShownKey[band] == key) {
+      return(true);
+   }
 
+   if(_chromeCacheKey[band] == key) {
+      _chromeDecode(band);
+      _chromeShownKey[band] = key;
+      return(true);
+   }
+
+   TFT_eSprite scratch = TFT_eSprite(_tftPtr);
+   scratch.setColorDepth(4);
+   if(scratch.createSprite(b->w, b->h) == NULL) {
+      return(false);
+   }
+   scratch.createPalette(_plotPalette, 16);
+   scratch.fillSprite(_plotColor(TFT_BLACK));
+   _drawChrome(&scratch, b->x, b->y, xLabelStart);
+   scratch.pushSprite(b->x, b->y);
+   _chromeShownKey[band] = key;
+
+   // Keep it for next time if it fits in the band's slot
+   _chromeCacheKey[band] = _chromeEncode(band, &scratch) ? key : 0;
+   scratch.deleteSprite();
+   return(true);
+}
+
+// ###########################################################################
+// Draw the title, axis numbers, axis labels and (overlay graphs) right hand
+// axis and legend.  Band is the scratch sprite for one band (everything is
+// shifted by offX/offY and clipped to it) or NULL to draw to the display.
+// ###########################################################################
+void MyTouchScreen::_drawChrome(TFT_eSprite * band, int offX, int offY, float xLabelStart) {
+   char buff[FLOAT_STRING_WIDTH]; // For converting itoa for the graph labels
+   char legend[TEXT_LEN + 2 * FLOAT_STRING_WIDTH + 4];
+   TFT_eSPI * target = (band != NULL) ? (TFT_eSPI *)band : _tftPtr;
 
-   // Draw vertical internal grid lines
-   int graphWidth = GRAPH_X_RIGHT - GRAPH_X_ORIGIN;
-   for(uint8_t i=1; i<_xAxisIntervals; i++) {
-      _tftPtr->drawLine(GRAPH_X_ORIGIN + (i * (graphWidth/_xAxisIntervals)), GRAPH_Y_ORIGIN, 
-                        GRAPH_X_ORIGIN + (i * (graphWidth/_xAxisIntervals)), GRAPH_Y_TOP, TFT_BLUE);
+   // The band sprites are 4-bit so colors go through the plot palette
+   uint16_t black = (band != NULL) ? _plotColor(TFT_BLACK) : TFT_BLACK;
+   uint16_t white = (band != NULL) ? _plotColor(TFT_WHITE) : TFT_WHITE;
+
+   target->setTextColor((band != NULL) ? _plotColor(TITLE_COLOR) : TITLE_COLOR, black);
+   target->setTextDatum(TITLE_DATUM);
+   target->setFreeFont(TITLE_FONT);
+   if(_titleVisible) {
+      target->drawString(_title,TITLE_X - offX,TITLE_Y - offY,GFXFF);
    }
 
-   // We use a sprite to draw the Y-Axis label as we need to rotate the text to run vertically parallel to the axis
-   _tftPtr->setPivot(GRAPH_SP_X_PIVOT, GRAPH_SP_Y_PIVOT);  // The point where the yAxis label sprite will pivot
-   _yAxisSpritePtr->setTextDatum(TEXT_DATUM);
-   _yAxisSpritePtr->setFreeFont(LABEL0_FONT);
-   _yAxisSpritePtr->fillSprite(TFT_BLACK);
-   _yAxisSpritePtr->drawString(_yAxisLabel,0,0);
-   _yAxisSpritePtr->pushRotated(-90);
+   // Add the grid labels.
+   target->setTextColor(white, black);
+   target->setFreeFont(LABEL0_FONT);
 
-   // Draw the vertical increment numbers
-   int graphHeight = GRAPH_Y_ORIGIN - GRAPH_Y_TOP;
-   for(int i=0; i<=_yAxisIntervals; i++) {
-      if(_yAxisMax - _yAxisMin >= 100) {
-         itoa(i*ystep+_yAxisMin,buff,10);
+   // xstep/ystep are the delta-value per grid line (e.g. 100/0 degree delta over 10 grids is 10 degrees per step)
+   float xstep = (_xAxisMax - _xAxisMin)/_xAxisIntervals;
+   float ystep;
+
+   int graphWidth = _plotArea.right - _plotArea.left;
+   int graphHeight;
+
+   // We use a sprite to draw the Y-Axis label as we need to rotate the text to run vertically parallel to the axis.
+   // A split view has no room for it (the legend names the plots instead).
+   if(_viewports == 1) {
+      _yAxisSpritePtr->setTextDatum(TEXT_DATUM);
+      _yAxisSpritePtr->setFreeFont(LABEL0_FONT);
+      _yAxisSpritePtr->fillSprite(TFT_BLACK);
+      _yAxisSpritePtr->drawString(_yAxisLabel,0,0);
+      if(band != NULL) {
+         // The label sprite is 1-bit.  Have it read back as palette indexes while it's rotated into the band.
+         band->setPivot(GRAPH_SP_X_PIVOT - offX, GRAPH_SP_Y_PIVOT - offY);
+         _yAxisSpritePtr->setBitmapColor(white, black);
+         _yAxisSpritePtr->pushRotated(band, -90);
+         _yAxisSpritePtr->setBitmapColor(TFT_WHITE, TFT_BLACK);
       } else {
-         dtostrf(i*ystep+_yAxisMin,3,1,buff);
+         _tftPtr->setPivot(GRAPH_SP_X_PIVOT, GRAPH_SP_Y_PIVOT);  // The point where the yAxis label sprite will pivot
+         _yAxisSpritePtr->pushRotated(-90);
       }
-      _tftPtr->drawString(buff,GRAPH_X_ORIGIN-20,GRAPH_Y_ORIGIN-(i * (graphHeight/_yAxisIntervals))-10 ,GFXFF);
    }
 
-   // Draw horizontal internal graph lines
-   for(uint8_t i=1; i<_yAxisIntervals; i++) {
-      _tftPtr->drawLine(GRAPH_X_ORIGIN,  GRAPH_Y_ORIGIN - (i * (graphHeight/_yAxisIntervals)), 
-                        GRAPH_X_RIGHT,  GRAPH_Y_ORIGIN - (i * (graphHeight/_yAxisIntervals)), TFT_BLUE);
+   // Draw the vertical increment numbers.  Each mini-plot of a split view gets its own in its trace color, kept 
+   // inside the plot so they don't run into the numbers of the plot above/below.
+   float intervals = _viewportIntervals();
+   for(uint8_t v=0; v<_viewports; v++) {
+      graphViewport * vp = &_viewport[v];
+      graphHeight = vp->bottom - vp->top;
+      ystep = (_channelMax[v] - _channelMin[v])/intervals;
+      if(_viewports > 1) {
+         target->setTextColor((band != NULL) ? _plotColor(_channelColor[v]) : _channelColor[v], black);
+      }
+      for(int i=0; i<=intervals; i++) {
+         if(_channelMax[v] - _channelMin[v] >= 100) {
+            itoa(i*ystep+_channelMin[v],buff,10);
+         } else {
+            dtostrf(i*ystep+_channelMin[v],3,1,buff);
+         }
+         int y = vp->bottom-(i * (graphHeight/intervals))-10;
+         if(_viewports > 1) {
+            y = constrain(y + 3, vp->top + 1, vp->bottom - GRAPH_SPLIT_LABEL_H);
+         }
+         target->drawString(buff,_plotArea.left-20 - offX,y - offY,GFXFF);
+      }
    }
+   target->setTextColor(white, black);
 
    // Draw the horizontal increment numbers
    for(int i=0; i<=_xAxisIntervals; i++) {
       // no decimal if we have long durations so labels have more space
       if(_xAxisMax - _xAxisMin >= 100) {
-         itoa(i*xstep+_xAxisMin,buff,10);
+         itoa(i*xstep+xLabelStart,buff,10);
       } else {
-         dtostrf(i*xstep+_xAxisMin,3,1,buff);
+         dtostrf(i*xstep+xLabelStart,3,1,buff);
       }
-      _tftPtr->drawString(buff,GRAPH_X_ORIGIN + (i * (graphWidth/_xAxisIntervals)),GRAPH_Y_ORIGIN+2 ,GFXFF);
+      target->drawString(buff,_plotArea.left + (i * (graphWidth/_xAxisIntervals)) - offX,_plotArea.bottom+2 - offY,GFXFF);
+   }
+   target->drawString(_xAxisLabel,GRAPH_X_LABELX - offX,GRAPH_X_LABELY - offY,GFXFF);
+
+   if(_overlayChannels < 2) {
+      return;
    }
-   _tftPtr->drawString(_xAxisLabel,GRAPH_X_LABELX,GRAPH_X_LABELY,GFXFF);
 
-   // Fill in any data already recorded (i.e. we may be re-drawing the graph that is already in progress
-   // We fill result arrays first.  Once the arrays fill, we write the array results to "disk" and 
-   // start filling the result arrays again.  That means we need to read any results written to "disk" first,
-   // then plot the data in the currently filling array buffer to bring the plot up to the latest data point.
+   // Right hand axis for channel 1 of an overlay graph
+   if(_viewports == 1) {
+      graphHeight = _plotArea.bottom - _plotArea.top;
+      ystep = (_channelMax[1] - _channelMin[1])/_yAxisIntervals;
+      target->setTextColor((band != NULL) ? _plotColor(_channelColor[1]) : _channelColor[1], black);
+      for(int i=0; i<=_yAxisIntervals; i++) {
+         if(_channelMax[1] - _channelMin[1] >= 100) {
+            itoa(i*ystep+_channelMin[1],buff,10);
+         } else {
+            dtostrf(i*ystep+_channelMin[1],3,1,buff);
+         }
+         target->drawString(buff,_plotArea.right+15 - offX,_plotArea.bottom-(i * (graphHeight/_yAxisIntervals))-10 - offY,GFXFF);
+      }
+   }
+
+   // Legend across the top in the trace colors.  Overlaid channels past the right axis show their range.
+   for(uint8_t ch=0; ch<_overlayChannels; ch++) {
+      strcpy(legend, _channelLabel[ch]);
+      if(ch > 1 && _viewports == 1) {
+         strcat(legend, " ");
+         dtostrf(_channelMin[ch],1,1,buff);
+         strcat(legend, buff);
+         strcat(legend, "-");
+         dtostrf(_channelMax[ch],1,1,buff);
+         strcat(legend, buff);
+      }
+      target->setTextColor((band != NULL) ? _plotColor(_channelColor[ch]) : _channelColor[ch], black);
+      target->drawString(legend, _plotArea.left + (ch*2 + 1) * graphWidth / (2 * _overlayChannels) - offX,
+                         GRAPH_LEGEND_Y - offY, GFXFF);
+   }
+   target->setTextColor(white, black);
+}
+
+// ###########################################################################
+// Cache key for one chrome band.  A hash of everything that draws into it:
+// the Y scale and overlay setup reach every band (the end numbers overhang
+// the corners), the Y label only the left band and the X axis only the
+// bottom one.  So a zoom/pan only re-renders the X labels and flipping
+// between channels with the same scale only re-renders the Y label.
+// ###########################################################################
+uint32_t MyTouchScreen::_chromeKey(uint8_t band, float xLabelStart) {
+   uint32_t key = _fnvBytes(FNV_OFFSET, &band, sizeof(band));
+   key = _fnvBytes(key, &_titleVisible, sizeof(_titleVisible));
+   if(_titleVisible) {
+      key = _fnvString(key, _title);
+   }
+   key = _fnvBytes(key, &_yAxisMin, sizeof(_yAxisMin));
+   key = _fnvBytes(key, &_yAxisMax, sizeof(_yAxisMax));
+   key = _fnvBytes(key, &_yAxisIntervals, sizeof(_yAxisIntervals));
+   key = _fnvBytes(key, &_overlayChannels, sizeof(_overlayChannels));
+   key = _fnvBytes(key, &_viewports, sizeof(_viewports));
+   for(uint8_t ch=0; ch<_overlayChannels && _overlayChannels > 1; ch++) {
+      key = _fnvBytes(key, &_channelMin[ch], sizeof(float));
+      key = _fnvBytes(key, &_channelMax[ch], sizeof(float));
+      key = _fnvBytes(key, &_channelColor[ch], sizeof(uint16_t));
+      key = _fnvString(key, _channelLabel[ch]);
+   }
+
+   if(band == CHROME_LEFT) {
+      key = _fnvString(key, _yAxisLabel);
+   } else if(band == CHROME_BOTTOM) {
+      float span = _xAxisMax - _xAxisMin;
+      key = _fnvBytes(key, &xLabelStart, sizeof(xLabelStart));
+      key = _fnvBytes(key, &span, sizeof(span));
+      key = _fnvBytes(key, &_xAxisIntervals, sizeof(_xAxisIntervals));
+      key = _fnvString(key, _xAxisLabel);
+   }
+   return(key ? key : 1);   // 0 means "nothing cached"
+}
+
+// ###########################################################################
+// Screen cache key.  The buttons that are showing, the title and the fixed
+// text lines.  The labels are left out so a screen whose labels have changed
+// can still come from the cache (drawScreen redraws the changed ones).
+// ###########################################################################
+uint32_t MyTouchScreen::_screenKey() {
+   MyTouchScreen * self = this;
+   uint32_t key = _fnvBytes(FNV_OFFSET, &self, sizeof(self));
+   key = _fnvBytes(key, &_titleVisible, sizeof(_titleVisible));
+   if(_titleVisible) {
+      key = _fnvString(key, _title);
+   }
+   key = _fnvBytes(key, _buttonVisible, sizeof(boolean) * NUM_BUTTONS);
+   for(uint8_t row=0; row<TEXT_ROWS; row++) {
+      if(_textVisible[row]) {
+         key = _fnvBytes(key, &row, sizeof(row));
+         key = _fnvBytes(key, _textCoords[row], sizeof(_textCoords[row]));
+         key = _fnvString(key, _textFields[row]);
+      }
+   }
+   return(key ? key : 1);   // 0 means "nothing cached"
+}
+
+// ###########################################################################
+// Run length encode a rendered band into its slot of the chrome cache.  Runs
+// never cross a row.  One byte per run of up to 15 pixels (palette index in
+// the top nibble, length in the bottom), longer runs are index<<4 followed
+// by a length byte.  Returns false if the band doesn't fit in its slot.
+// ###########################################################################
+boolean MyTouchScreen::_chromeEncode(uint8_t band, TFT_eSprite * sprite) {
+   const chromeBand * b = &_chromeBands[band];
+   uint8_t * out = _chromeCache + b->offset;
+   uint16_t len = 0;
+
+   for(int y=0; y<b->h; y++) {
+      int x = 0;
+      while(x < b->w) {
+         uint8_t idx = sprite->readPixelValue(x, y);
+         int run = 1;
+         while(x + run < b->w && run < 255 && sprite->readPixelValue(x + run, y) == idx) {
+            run++;
+         }
+         if(len + 2 > b->size) {
+            return(false);
+         }
+         if(run < 16) {
+            out[len++] = (idx << 4) | run;
+         } else {
+            out[len++] = idx << 4;
+            out[len++] = run;
+         }
+         x += run;
+      }
+   }
+   _chromeCacheLen[band] = len;
+   return(true);
+}
+
+// Unpack a cached band a row at a time and push it
+void MyTouchScreen::_chromeDecode(uint8_t band) {
+   const chromeBand * b = &_chromeBands[band];
+   const uint8_t * in = _chromeCache + b->offset;
+   const uint8_t * end = in + _chromeCacheLen[band];
+
+   boolean swap = _tftPtr->getSwapBytes();
+   _tftPtr->setSwapBytes(false);
+   _tftPtr->startWrite();
+   for(int y=0; y<b->h && in < end; y++) {
+      int x = 0;
+      while(x < b->w && in < end) {
+         uint8_t idx = *in >> 4;
+         int run = *in++ & 0x0F;
+         if(run == 0) {
+            run = *in++;
+         }
+         // The display wants the high byte first
+         uint16_t color = _plotPalette[idx];
+         color = (color >> 8) | (color << 8);
+         while(run-- > 0 && x < b->w) {
+            _chromeLine[x++] = color;
+         }
+      }
+      _tftPtr->pushImage(b->x, b->y + y, b->w, 1, _chromeLine);
+   }
+   _tftPtr->endWrite();
+   _tftPtr->setSwapBytes(swap);
+}
+
+// ###########################################################################
+// Plot one channel's results.
+// Fill in any data already recorded (i.e. we may be re-drawing the graph that is already in progress
+// We fill result arrays first.  Once the arrays fill, we write the array results to "disk" and 
+// start filling the result arrays again.  That means we need to read any results written to "disk" first,
+// then plot the data in the currently filling array buffer to bring the plot up to the latest data point.
+// ###########################################################################
+void MyTouchScreen::_replayChannel(uint8_t channel, boolean resultArraysFilled, const char * resultFile,
+                                   int resultIndex, float * resultsArrXAxisPtr, float * resultsArrYAxisPtr,
+                                   MyResultPyramid * pyramidPtr) {
+   uint16_t color = _channelColor[channel];
+   int graphWidth = _plotArea.right - _plotArea.left;
+   _vp = _channelVp(channel);
+
    if(resultArraysFilled) {
-      File resFH;
-      char fieldX[FLOAT_STRING_WIDTH];
-      char fieldY[FLOAT_STRING_WIDTH];
-      int8_t idx;
-      resFH = SD.open(resultFile,FILE_READ);
-      if(!resFH){
-        Serial.print("Failed to open "); Serial.print(resultFile); Serial.println(" for reading");
-        return;
-      }
-      //Serial.print("Reading from logFile: "); Serial.println(resultFile);
-      // data in the file is one pair of floats per line:  dataX,dataYCrLf
-      while(resFH.available()){
-         boolean foundCR = false;
-         boolean foundComma = false;
-         uint8_t c;
-
-         // Read in the X data field
-         idx=0;
-         while(!foundComma) {
-            c = resFH.read();
-            if(c == 44) {  // comma found, we're at the end of the first float
-               fieldX[idx]='\0';  // null pad the string
-               break;
-            }else{
-               fieldX[idx++]=c; 
-            }
+      MyCsvReader resReader(_csvBlock, CSV_BLOCK_SIZE);
+      float fields[2];
+      uint32_t rawStart = 0;
+      boolean pastWindow = false;
+
+      // The trace starts at the 0,0 point like the in-progress graph does.
+      graphColumn column;
+      _columnStart(&column);
+      if(_xAxisMin <= 0) {
+         _columnAdd(&column, _dataToPixelX(0.0), _dataToPixelY(0.0, channel), color);
+      }
+
+      // How much of the session is inside the X axis (it may be zoomed in or a strip chart)
+      float newest = _xAxisMax;
+      if(resultIndex > 0) {
+         newest = *(resultsArrXAxisPtr + resultIndex - 1);
+      }
+      float visibleSpan = ((newest < _xAxisMax) ? newest : _xAxisMax) - ((_xAxisMin > 0) ? _xAxisMin : 0);
+
+      // Long sessions have more samples than pixel columns.  Plot the coarsest summary level that still
+      // has a bucket per column across the part that's in view, then pick up the raw file where the 
+      // summary buckets end.  Without a usable level, skip straight to the left edge of the raw file.
+      int8_t level = -1;
+      if(pyramidPtr != NULL && visibleSpan > 0) {
+         level = pyramidPtr->getLevelForBuckets((uint32_t)(graphWidth * (newest / visibleSpan)));
+      }
+      if(level >= 0) {
+         rawStart = _drawPyramidLevel(resultFile, level, &column, channel, &pastWindow);
+      } else if(_xAxisMin > 0) {
+         rawStart = _rawOffsetFor(resultFile, _xAxisMin);
+      }
+
+      // Then the raw results (unless the summary already ran past the right edge of the graph)
+      if(!pastWindow) {
+         if(!resReader.open(resultFile)){
+           Serial.print("Failed to open "); Serial.print(resultFile); Serial.println(" for reading");
+           return;
+         }
+         if(rawStart > 0) {
+            resReader.seek(rawStart);
          }
-         idx=0;
-         while(!foundCR) {  // Now read in the second float (Y data) (delimited by cr lf)
-            c = resFH.read();
-            if(c == 13) {  // cr
-               c = resFH.read();  //flush out the newline
-               fieldY[idx]='\0';  // null pad the string
+         //Serial.print("Reading from logFile: "); Serial.println(resultFile);
+         // data in the file is one pair of floats per line:  dataX,dataYCrLf
+         // Stop at the first point past the right edge (it gives the line out to the edge).
+         while(resReader.readRow(fields, 2) == 2) {
+            //Serial.print("data: ");Serial.print(fields[0]); Serial.print(" "); Serial.println(fields[1]);
+            _columnAdd(&column, _dataToPixelX(fields[0]), _dataToPixelY(fields[1], channel), color);
+            if(fields[0] > _xAxisMax) {
                break;
-            }else{
-               fieldY[idx++]=c; 
             }
          }
-         // At this point we have read the two data fields (dataX and dataY).  Go plot them
-         dataX = atof(fieldX);  
-         dataY = atof(fieldY);  
-         //Serial.print("data: ");Serial.print(dataX); Serial.print(" "); Serial.println(dataY);
-         _tftPtr->drawLine(int(((prevDataX-_xAxisMin)/(_xAxisMax-_xAxisMin))*graphWidth + GRAPH_X_ORIGIN), 
-                             int(GRAPH_Y_ORIGIN - ((prevDataY-_yAxisMin)/(_yAxisMax-_yAxisMin))*graphHeight),
-                            int(((dataX-_xAxisMin)/(_xAxisMax-_xAxisMin))*graphWidth + GRAPH_X_ORIGIN), 
-                             int(GRAPH_Y_ORIGIN - ((dataY-_yAxisMin)/(_yAxisMax-_yAxisMin))*graphHeight), TFT_WHITE);
-         prevDataX=dataX;
-         prevDataY=dataY;
+         resReader.close();
       }
-      resFH.close();
+      _columnFlush(&column, color);
    }
 
-   // Now plot the data in the results Arrays (the data that hasn't yet been written back to the file)
+   // Now plot the data in the results Arrays (the data that hasn't yet been written back to the file).
+   // Each point is transformed once and carried over as the start of the next segment.
+   if(resultIndex < 2) {
+      return;
+   }
+   int prevX = _dataToPixelX(*resultsArrXAxisPtr);
+   int prevY = _dataToPixelY(*resultsArrYAxisPtr, channel);
    for(int i=1; i<resultIndex; i++) {
-      prevDataX = *(resultsArrXAxisPtr + i - 1);
-      prevDataY = *(resultsArrYAxisPtr + i - 1);
-      dataX = *(resultsArrXAxisPtr + i);
-      dataY = *(resultsArrYAxisPtr + i);
+      int x = _dataToPixelX(*(resultsArrXAxisPtr + i));
+      int y = _dataToPixelY(*(resultsArrYAxisPtr + i), channel);
+      _plotSegment(prevX, prevY, x, y, color);
+      prevX = x;
+      prevY = y;
+   }
+}
+
+// ###########################################################################
+// Data (graph units) to pixel coordinates with the transform from setXAxis/setYAxis
+// ###########################################################################
+int MyTouchScreen::_dataToPixelX(float dataX) {
+   return(graphDataToPixel(dataX, &_xTransform));
+}
+int MyTouchScreen::_dataToPixelY(float dataY, uint8_t channel) {
+   return(graphDataToPixel(dataY, &_yTransform[channel]));
+}
+
+// ###########################################################################
+// Cohen-Sutherland line clipping against the plot window.  Segments that run
+// off the edge of the graph are cut at the border instead of being dropped.
+// ###########################################################################
+uint8_t MyTouchScreen::_outCode(int x, int y) {
+   graphViewport * vp = &_viewport[_vp];
+   uint8_t code = 0;
+   if(x < vp->left) {
+      code |= CLIP_LEFT;
+   } else if(x > vp->right) {
+      code |= CLIP_RIGHT;
+   }
+   if(y < vp->top) {
+      code |= CLIP_TOP;
+   } else if(y > vp->bottom) {
+      code |= CLIP_BOTTOM;
+   }
+   return(code);
+}
+
+// a * b / c rounded to the nearest pixel
+static inline int _mulDivRound(int64_t a, int64_t b, int64_t c) {
+   int64_t n = a * b;
+   int64_t half = (c < 0 ? -c : c) / 2;
+   return((int)(((n < 0) ? n - half : n + half) / c));
+}
+
+boolean MyTouchScreen::_clipSegment(int * x0, int * y0, int * x1, int * y1) {
+   graphViewport * vp = &_viewport[_vp];
+   uint8_t code0 = _outCode(*x0, *y0);
+   uint8_t code1 = _outCode(*x1, *y1);
+
+   // Each pass moves one end onto a window edge, so four passes normally do it.  Integer rounding
+   // near a corner can leave a point a pixel outside and need another, so the bound has room to
+   // spare and the outcodes are checked once more after the last pass.  The crossings are always
+   // worked out from the original ends so the rounding doesn't add up from one pass to the next.
+   int startX = *x0;
+   int startY = *y0;
+   int64_t dx = *x1 - *x0;
+   int64_t dy = *y1 - *y0;
+   for(uint8_t pass=0; pass<CLIP_MAX_PASSES; pass++) {
+      if(!(code0 | code1)) {
+         return(true);         // Both ends inside
+      }
+      if(code0 & code1) {
+         return(false);        // Both ends off the same side
+      }
+      uint8_t out = code0 ? code0 : code1;
+      int x, y;
+      if(out & CLIP_TOP) {
+         y = vp->top;
+         x = startX + _mulDivRound(dx, y - startY, dy);
+      } else if(out & CLIP_BOTTOM) {
+         y = vp->bottom;
+         x = startX + _mulDivRound(dx, y - startY, dy);
+      } else if(out & CLIP_RIGHT) {
+         x = vp->right;
+         y = startY + _mulDivRound(dy, x - startX, dx);
+      } else {
+         x = vp->left;
+         y = startY + _mulDivRound(dy, x - startX, dx);
+      }
+      if(out == code0) {
+         *x0 = x; *y0 = y;
+         code0 = _outCode(x, y);
+      } else {
+         *x1 = x; *y1 = y;
+         code1 = _outCode(x, y);
+      }
+   }
+   return(!(code0 | code1));
+}
+
+void MyTouchScreen::_plotSegment(int x0, int y0, int x1, int y1, uint16_t color) {
+   if(!_clipSegment(&x0, &y0, &x1, &y1)) {
+      return;
+   }
+   TFT_eSPI * target = _tftPtr;
+   if(_plotToSprite) {
+      // Sprite coords are relative to the top left corner of the plot window
+      target = _plotSpritePtr;
+      x0 -= _plotArea.left; x1 -= _plotArea.left;
+      y0 -= _plotArea.top; y1 -= _plotArea.top;
+      color = _plotColor(color);
+      _markDirty(x0, y0, x1, y1);
+   }
+   if(x0 == x1) {
+      if(y0 > y1) {
+         int t = y0; y0 = y1; y1 = t;
+      }
+      target->drawFastVLine(x0, y0, y1 - y0 + 1, color);
+   } else {
+      target->drawLine(x0, y0, x1, y1, color);
+   }
+}
+
+// ###########################################################################
+// Plot window framebuffer.  Everything inside the graph border goes through 
+// _plotSegment so it lands in the plot sprite, then _pushPlot sends just the
+// rectangle that changed to the display in one transaction.
+// ###########################################################################
+void MyTouchScreen::_plotBegin() {
+   _plotToSprite = (_plotSpritePtr != NULL && _plotSpritePtr->created());
+   if(_plotToSprite) {
+      _plotSpritePtr->createPalette(_plotPalette, 16);
+      _plotSpritePtr->fillSprite(_plotColor(TFT_BLACK));
+      _markDirty(0, 0, GRAPH_PLOT_W - 1, GRAPH_PLOT_H - 1);
+
+      // Strip charts scroll everything inside the border except the left edge (the right border gets redrawn)
+      _plotSpritePtr->setScrollRect(1, 1, GRAPH_PLOT_W - 1, GRAPH_PLOT_H - 2, _plotColor(TFT_BLACK));
+   }
+}
+
+// Border and internal grid lines of each viewport
+void MyTouchScreen::_drawPlotFrame() {
+   float intervals = _viewportIntervals();
+   for(_vp=0; _vp<_viewports; _vp++) {
+      graphViewport * vp = &_viewport[_vp];
+      int graphWidth = vp->right - vp->left;
+      int graphHeight = vp->bottom - vp->top;
+
+      _plotSegment(vp->left, vp->bottom, vp->right, vp->bottom, TFT_YELLOW);
+      _plotSegment(vp->left, vp->bottom, vp->left, vp->top, TFT_YELLOW);
+      _plotSegment(vp->left, vp->top, vp->right, vp->top, TFT_YELLOW);
+      _plotSegment(vp->right, vp->bottom, vp->right, vp->top, TFT_YELLOW);
+
+      // Vertical internal grid lines (not on a strip chart, they'd scroll away with the trace)
+      for(uint8_t i=1; i<_xAxisIntervals && !_stripActive(); i++) {
+         int x = vp->left + (i * (graphWidth/_xAxisIntervals));
+         _plotSegment(x, vp->bottom, x, vp->top, TFT_BLUE);
+      }
+      // Horizontal internal grid lines
+      for(uint8_t i=1; i<intervals; i++) {
+         int y = vp->bottom - (i * (graphHeight/intervals));
+         _plotSegment(vp->left, y, vp->right, y, TFT_BLUE);
+      }
+   }
+   _vp = 0;
+}
+
+uint16_t MyTouchScreen::_plotColor(uint16_t color) {
+   for(uint8_t i=0; i<PLOT_PALETTE_USED; i++) {
+      if(_plotPalette[i] == color) {
+         return(i);
+      }
+   }
+   return(1);
+}
+
+void MyTouchScreen::_markDirty(int x0, int y0, int x1, int y1) {
+   if(x0 > x1) { int t = x0; x0 = x1; x1 = t; }
+   if(y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+   if(_dirtyX0 > _dirtyX1) {
+      _dirtyX0 = x0; _dirtyY0 = y0; _dirtyX1 = x1; _dirtyY1 = y1;
+      return;
+   }
+   if(x0 < _dirtyX0) { _dirtyX0 = x0; }
+   if(y0 < _dirtyY0) { _dirtyY0 = y0; }
+   if(x1 > _dirtyX1) { _dirtyX1 = x1; }
+   if(y1 > _dirtyY1) { _dirtyY1 = y1; }
+}
+
+// ###########################################################################
+// Zoom/pan helpers.  Markers are drawn straight on the display over the plot 
+// so they can be erased by pushing that column of the plot sprite back out.
+// ###########################################################################
+float MyTouchScreen::pixelToDataX(int x) {
+   return(_xAxisMin + (x - _plotArea.left) * (_xAxisMax - _xAxisMin) / (_plotArea.right - _plotArea.left));
+}
+
+void MyTouchScreen::drawGraphMarker(int x, uint16_t color) {
+   if(x < _plotArea.left || x > _plotArea.right) {
+      return;
+   }
+   _tftPtr->drawFastVLine(x, _plotArea.top, GRAPH_PLOT_H, color);
+}
+
+void MyTouchScreen::eraseGraphMarker(int x) {
+   if(!_plotToSprite || x < _plotArea.left || x > _plotArea.right) {
+      return;
+   }
+   _plotSpritePtr->pushSprite(x, _plotArea.top, x - _plotArea.left, 0, 1, GRAPH_PLOT_H);
+}
+
+// ###########################################################################
+// Graph cursor.  The logged sample nearest to an X value.  The result arrays
+// and the raw file are both in X order, so it's a binary search of the 
+// arrays or, for samples already written to the card, a binary search of the
+// pyramid's finest level (the session index) to land within a few buckets of
+// X in the raw file.  Returns false if there's nothing logged yet.
+// ###########################################################################
+boolean MyTouchScreen::findNearestSample(float dataX, boolean resultArraysFilled, const char * resultFile,
+                                         int resultIndex, float * resultsArrXAxisPtr, float * resultsArrYAxisPtr,
+                                         float * sampleX, float * sampleY) {
+   boolean found = false;
+
+   if(resultIndex > 0) {
+      int lo = 0;
+      int hi = resultIndex - 1;
+      while(lo < hi) {
+         int mid = (lo + hi) / 2;
+         if(*(resultsArrXAxisPtr + mid) < dataX) {
+            lo = mid + 1;
+         } else {
+            hi = mid;
+         }
+      }
+      // lo is the first sample at/after X (or the newest).  The one before it may be closer.
+      if(lo > 0 && fabs(dataX - *(resultsArrXAxisPtr + lo - 1)) < fabs(*(resultsArrXAxisPtr + lo) - dataX)) {
+         lo--;
+      }
+      *sampleX = *(resultsArrXAxisPtr + lo);
+      *sampleY = *(resultsArrYAxisPtr + lo);
+      found = true;
+      if(dataX >= *resultsArrXAxisPtr) {
+         return(true);
+      }
+   }
+
+   // Before anything still in RAM.  Look it up in the raw file.
+   if(resultArraysFilled) {
+      MyCsvReader resReader(_csvBlock, CSV_BLOCK_SIZE);
+      float fields[2];
+      if(!resReader.open(resultFile)){
+         Serial.print("Failed to open "); Serial.print(resultFile); Serial.println(" for reading");
+         return(found);
+      }
+      uint32_t rawStart = _rawOffsetFor(resultFile, dataX);
+      if(rawStart > 0) {
+         resReader.seek(rawStart);
+      }
+      while(resReader.readRow(fields, 2) == 2) {
+         if(!found || fabs(fields[0] - dataX) < fabs(*sampleX - dataX)) {
+            *sampleX = fields[0];
+            *sampleY = fields[1];
+            found = true;
+         }
+         if(fields[0] >= dataX) {
+            break;
+         }
+      }
+      resReader.close();
+   }
+   return(found);
+}
+
+// Crosshair through the sample (a vertical line and a horizontal line per channel) and the readout
+// in the status sprite above the plot.  Everything is drawn straight on the display so erasing it is
+// pushing those lines of the plot sprite back out and restoring the top chrome band.
+void MyTouchScreen::drawGraphCursor(float sampleX, uint8_t channels, float * values) {
+   char buff[FLOAT_STRING_WIDTH];
+   char readout[TEXT_LEN + GRAPH_CHANNELS * (FLOAT_STRING_WIDTH + 1)];
+
+   eraseGraphCursor();
+   if(channels > GRAPH_CHANNELS) {
+      channels = GRAPH_CHANNELS;
+   }
+
+   _cursorX = _dataToPixelX(sampleX);
+   if(_cursorX < _plotArea.left || _cursorX > _plotArea.right) {
+      return;
+   }
+   drawGraphMarker(_cursorX, GRAPH_CURSOR_COLOR);
+   _cursorChannels = channels;
+   for(uint8_t ch=0; ch<channels; ch++) {
+      graphViewport * vp = &_viewport[_channelVp(ch)];
+      _cursorY[ch] = _dataToPixelY(values[ch], ch);
+      if(_cursorY[ch] < vp->top || _cursorY[ch] > vp->bottom) {
+         _cursorY[ch] = -1;   // Off the plot
+      } else {
+         _tftPtr->drawFastHLine(vp->left, _cursorY[ch], vp->right - vp->left + 1, GRAPH_CURSOR_COLOR);
+      }
+   }
+   _cursorShown = true;
+
+   // "time: value value value"
+   dtostrf(sampleX,1,2,readout);
+   strcat(readout, ":");
+   for(uint8_t ch=0; ch<channels; ch++) {
+      dtostrf(values[ch],1,2,buff);
+      strcat(readout, " ");
+      strcat(readout, buff);
+   }
+   _statusSpritePtr->setTextColor(STATUS_COLOR, STATUS_BACKGROUND);
+   _statusSpritePtr->setTextDatum(STATUS_DATUM);
+   _statusSpritePtr->setFreeFont(STATUS_TEXT_FONT);
+   _statusSpritePtr->fillSprite(STATUS_BACKGROUND);
+   _statusSpritePtr->drawString(readout, STATUS_WIDTH/2, STATUS_HEIGHT/2, GFXFF);
+   _statusSpritePtr->pushSprite(STATUS_X, GRAPH_CURSOR_Y);
+   _chromeShownKey[CHROME_TOP] = 0;   // The readout is sitting on the top band
+}
+
+void MyTouchScreen::eraseGraphCursor() {
+   if(!_cursorShown) {
+      return;
+   }
+   _cursorShown = false;
+   eraseGraphMarker(_cursorX);
+   for(uint8_t ch=0; ch<_cursorChannels && _plotToSprite; ch++) {
+      if(_cursorY[ch] >= 0) {
+         _plotSpritePtr->pushSprite(_plotArea.left, _cursorY[ch], 0, _cursorY[ch] - _plotArea.top, GRAPH_PLOT_W, 1);
+      }
+   }
+   // The top band doesn't depend on the X labels so any start will do
+   if(!_showChromeBand(CHROME_TOP, _xAxisMin)) {
+      _tftPtr->fillRect(STATUS_X, GRAPH_CURSOR_Y, STATUS_WIDTH, STATUS_HEIGHT, TFT_BLACK);
+   }
+}
+
+// X pixel the cursor is on (-1 if there isn't one)
+int MyTouchScreen::getGraphCursorX() {
+   return(_cursorShown ? _cursorX : -1);
+}
+
+// ###########################################################################
+// Strip chart scrolling.  When a new sample lands past the right border, the
+// plot sprite is shifted left by that many columns and the window's X range
+// moves with it.  Only the uncovered columns (grid + border) and the new
+// segment get drawn, then the whole plot window is pushed.
+// ###########################################################################
+boolean MyTouchScreen::_stripActive() {
+   return(_graphMode == GRAPH_MODE_STRIP && _plotToSprite);
+}
+
+void MyTouchScreen::_stripScroll(int columns) {
+   int graphWidth = _plotArea.right - _plotArea.left;
+   float shift = columns * (_stripWindow / graphWidth);
+   uint8_t curVp = _vp;
+
+   setXAxis(_xAxisMin + shift, _xAxisMax + shift, _xAxisIntervals, _xAxisLabel);
+   if(columns >= graphWidth) {
+      _plotSpritePtr->fillSprite(_plotColor(TFT_BLACK));
+      _drawPlotFrame();
+   } else {
+      // Every viewport spans the plot area's width so one scroll moves them all
+      _plotSpritePtr->scroll(-columns, 0);
+      float intervals = _viewportIntervals();
+      for(_vp=0; _vp<_viewports; _vp++) {
+         graphViewport * vp = &_viewport[_vp];
+         int graphHeight = vp->bottom - vp->top;
+         for(uint8_t i=1; i<intervals; i++) {
+            int y = vp->bottom - (i * (graphHeight/intervals));
+            _plotSegment(vp->right - columns, y, vp->right, y, TFT_BLUE);
+         }
+         _plotSegment(vp->right, vp->bottom, vp->right, vp->top, TFT_YELLOW);
+      }
+   }
+   _vp = curVp;
+   _markDirty(0, 0, GRAPH_PLOT_W - 1, GRAPH_PLOT_H - 1);
+}
+
+void MyTouchScreen::_pushPlot() {
+   if(!_plotToSprite || _dirtyX0 > _dirtyX1) {
+      return;
+   }
+   _plotSpritePtr->pushSprite(_plotArea.left + _dirtyX0, _plotArea.top + _dirtyY0, _dirtyX0, _dirtyY0,
+                              _dirtyX1 - _dirtyX0 + 1, _dirtyY1 - _dirtyY0 + 1);
+   _dirtyX0 = 1; _dirtyX1 = 0;
+}
+
+// ###########################################################################
+// Plot a summary level of the result pyramid.  Each bucket becomes its mean 
+// with a min..max line through it so spikes still show up.  The records are
+// fixed size binary so we binary search to the left edge of the X axis and
+// read them a block at a time from there, stopping once we're past the right 
+// edge.  pastWindow tells the caller there's no need to read the raw tail.
+// ###########################################################################
+uint32_t MyTouchScreen::_drawPyramidLevel(const char * resultFile, uint8_t level, graphColumn * col, uint8_t channel,
+                                          boolean * pastWindow) {
+   char levelFile[TEXT_PLUS_DATE_LEN + 4];
+   uint16_t color = _channelColor[channel];
+   uint32_t rawEnd = 0;
+   *pastWindow = false;
+
+   MyResultPyramid::getLevelFileName(resultFile, level, levelFile);
+   File levelFH = SD.open(levelFile, FILE_READ);
+   if(!levelFH) {
+      Serial.print("Failed to open "); Serial.print(levelFile); Serial.println(" for reading");
+      return(0);
+   }
+   // Start one bucket left of the window so the trace runs in from the edge
+   uint32_t first = MyResultPyramid::findRecord(&levelFH, _xAxisMin);
+   if(first > 0) {
+      first--;
+   }
+   levelFH.seek(first * sizeof(pyramidRecord));
+
+   pyramidRecord * records = (pyramidRecord *)_csvBlock;
+   const uint16_t maxRecords = CSV_BLOCK_SIZE / sizeof(pyramidRecord);
+   int n;
+   while(!*pastWindow && (n = levelFH.read((uint8_t *)_csvBlock, maxRecords * sizeof(pyramidRecord))) >= (int)sizeof(pyramidRecord)) {
+      n /= sizeof(pyramidRecord);
+      for(int i=0; i<n && !*pastWindow; i++) {
+         int x = _dataToPixelX((records[i].xFirst + records[i].xLast) / 2.0);
+         int mean = _dataToPixelY(records[i].meanY, channel);
+         _columnAdd(col, x, mean, color);
+         _columnAdd(col, x, _dataToPixelY(records[i].minY, channel), color);
+         _columnAdd(col, x, _dataToPixelY(records[i].maxY, channel), color);
+         _columnAdd(col, x, mean, color);
+         rawEnd = records[i].rawEnd;
+         *pastWindow = (records[i].xFirst > _xAxisMax);
+      }
+   }
+   levelFH.close();
+   return(rawEnd);
+}
 
-      // Plot only if the data is within the graph limits
-      if(dataX >= _xAxisMin && dataX <= _xAxisMax && dataY >= _yAxisMin && dataY <= _yAxisMax) {
-         _tftPtr->drawLine(int(((prevDataX-_xAxisMin)/(_xAxisMax-_xAxisMin))*graphWidth + GRAPH_X_ORIGIN), 
-                             int(GRAPH_Y_ORIGIN - ((prevDataY-_yAxisMin)/(_yAxisMax-_yAxisMin))*graphHeight),
-                            int(((dataX-_xAxisMin)/(_xAxisMax-_xAxisMin))*graphWidth + GRAPH_X_ORIGIN), 
-                             int(GRAPH_Y_ORIGIN - ((dataY-_yAxisMin)/(_yAxisMax-_yAxisMin))*graphHeight), TFT_WHITE);
+// ###########################################################################
+// Where to start reading the raw file so we don't parse the results left of 
+// the X axis.  The finest pyramid level is the index (one bucket early so the
+// trace runs in from the edge).  0 if there is no index yet.
+// ###########################################################################
+uint32_t MyTouchScreen::_rawOffsetFor(const char * resultFile, float dataX) {
+   char levelFile[TEXT_PLUS_DATE_LEN + 4];
+   pyramidRecord rec;
+   uint32_t offset = 0;
+
+   MyResultPyramid::getLevelFileName(resultFile, 0, levelFile);
+   File levelFH = SD.open(levelFile, FILE_READ);
+   if(!levelFH) {
+      return(0);
+   }
+   uint32_t idx = MyResultPyramid::findRecord(&levelFH, dataX);
+   if(idx > 1) {
+      levelFH.seek((idx - 2) * sizeof(pyramidRecord));
+      if(levelFH.read((uint8_t *)&rec, sizeof(rec)) == sizeof(rec)) {
+         offset = rec.rawEnd;
       }
    }
+   levelFH.close();
+   return(offset);
+}
+
+// ###########################################################################
+// Per pixel column decimation.  Points come in sorted by time so we only need 
+// to keep the column currently being filled.  When the trace moves on to a new
+// column we draw a line from the last point of the previous column to the first
+// point of this one, plus one vertical line covering the column's min..max.
+// ###########################################################################
+void MyTouchScreen::_columnStart(graphColumn * col) {
+   col->active = false;
+   col->havePrev = false;
+}
+
+void MyTouchScreen::_columnAdd(graphColumn * col, int x, int y, uint16_t color) {
+   if(col->active && x == col->x) {
+      if(y < col->minY) { col->minY = y; }
+      if(y > col->maxY) { col->maxY = y; }
+      col->lastY = y;
+      return;
+   }
+   if(col->active) {
+      _columnFlush(col, color);
+   }
+   col->x = x;
+   col->minY = y;
+   col->maxY = y;
+   col->firstY = y;
+   col->lastY = y;
+   col->active = true;
+}
+
+void MyTouchScreen::_columnFlush(graphColumn * col, uint16_t color) {
+   if(!col->active) {
+      return;
+   }
+   if(col->havePrev) {
+      _plotSegment(col->prevX, col->prevY, col->x, col->firstY, color);
+   }
+   if(col->maxY != col->minY) {
+      _plotSegment(col->x, col->minY, col->x, col->maxY, color);
+   }
+   col->prevX = col->x;
+   col->prevY = col->lastY;
+   col->havePrev = true;
+   col->active = false;
 }
 
 // ##################################
 // Add array datapoints to the graph
 // ##################################
 void MyTouchScreen::addGraphData(int resultIndex, float * resultsArrXAxisPtr, float * resultsArrYAxisPtr){
-   int graphWidth = GRAPH_X_RIGHT - GRAPH_X_ORIGIN;
-   int graphHeight = GRAPH_Y_ORIGIN - GRAPH_Y_TOP;
-
-   float prevDataX = *(resultsArrXAxisPtr + resultIndex - 1);
-   float prevDataY = *(resultsArrYAxisPtr + resultIndex - 1);
-   float dataX = *(resultsArrXAxisPtr + resultIndex);
-   float dataY = *(resultsArrYAxisPtr + resultIndex);
+   addGraphData(resultIndex, resultsArrXAxisPtr, resultsArrYAxisPtr, 0);
+}
 
-   if(dataX >= _xAxisMin && dataX <= _xAxisMax && dataY >= _yAxisMin && dataY <= _yAxisMax) {
-      _tftPtr->drawLine(int(((prevDataX-_xAxisMin)/(_xAxisMax-_xAxisMin))*graphWidth + GRAPH_X_ORIGIN), 
-                          int(GRAPH_Y_ORIGIN - ((prevDataY-_yAxisMin)/(_yAxisMax-_yAxisMin))*graphHeight),
-                         int(((dataX-_xAxisMin)/(_xAxisMax-_xAxisMin))*graphWidth + GRAPH_X_ORIGIN), 
-                          int(GRAPH_Y_ORIGIN - ((dataY-_yAxisMin)/(_yAxisMax-_yAxisMin))*graphHeight), TFT_WHITE);
+// Same for one channel of an overlay graph.  Channels the graph isn't showing are ignored.
+void MyTouchScreen::addGraphData(int resultIndex, float * resultsArrXAxisPtr, float * resultsArrYAxisPtr, uint8_t channel){
+   if(channel >= _overlayChannels) {
+      return;
+   }
+   _vp = _channelVp(channel);
+   if(_stripActive()) {
+      int x = _dataToPixelX(*(resultsArrXAxisPtr + resultIndex));
+      if(x > _plotArea.right) {
+         _stripScroll(x - _plotArea.right);
+      }
    }
+   _plotSegment(_dataToPixelX(*(resultsArrXAxisPtr + resultIndex - 1)), _dataToPixelY(*(resultsArrYAxisPtr + resultIndex - 1), channel),
+                _dataToPixelX(*(resultsArrXAxisPtr + resultIndex)), _dataToPixelY(*(resultsArrYAxisPtr + resultIndex), channel),
+                _channelColor[channel]);
+   _pushPlot();
 }
 
 //###############################
@@ -392,64 +1510,119 @@ void MyTouchScreen::addGraphData(int resultIndex, float * resultsArrXAxisPtr, fl
 // ##############################
 // To enable the button to make it visible on the screen 
 void MyTouchScreen::enableButton(uint8_t buttonNumber, const char *label, callBackPtr btnCallBackPtr) {
-   *(_buttonVisible+buttonNumber) = true;
-   strcpy(_buttonLabels+(sizeof(char)*TITLE_LEN+1)*buttonNumber,label);
+   _buttonVisible[buttonNumber] = true;
+   _buttonLabels[buttonNumber] = label;
+   _buttonValueSize[buttonNumber] = 0;
    _buttonCallBackPtr[buttonNumber] = btnCallBackPtr;
 }
 
 // Get the button label to use the value in the calling code
 const char *  MyTouchScreen::getButtonLabel(uint8_t buttonNumber) {
-   //return(_buttonLabels[buttonNumber]);
-   return(_buttonLabels+(sizeof(char)*TITLE_LEN+1)*buttonNumber);
+   return(_buttonLabels[buttonNumber]);
 }
 
-// To update the label on a button 
+// To update the label on a button.  A setting gets the new value copied into its variable (cut short if it
+// doesn't fit), anything else is pointed at the new string.
 void MyTouchScreen::updateButtonLabel(uint8_t buttonNumber, const char *label) {
-   strcpy(_buttonLabels+(sizeof(char)*TITLE_LEN+1)*buttonNumber,label);
+   uint8_t size = _buttonValueSize[buttonNumber];
+   if(size == 0) {
+      _buttonLabels[buttonNumber] = label;
+   } else if(label != _buttonLabels[buttonNumber]) {
+      char * value = (char *)_buttonLabels[buttonNumber];   // Bound to one of the app's char arrays (see screenButton)
+      strncpy(value, label, size - 1);
+      value[size - 1] = '\0';
+   }
 }
 
 // To disable the button to make it invisible (and unselectable) on the screen
 void MyTouchScreen::disableButton(uint8_t buttonNumber) {
-   *(_buttonVisible+buttonNumber) = false;
+   _buttonVisible[buttonNumber] = false;
 }
 
 
 // Check if button is visible
 boolean MyTouchScreen::isButtonVisible(uint8_t buttonNumber) {
-   if(*(_buttonVisible+buttonNumber)) {
+   if(_buttonVisible[buttonNumber]) {
       return(true);
    } else {
       return(false);
    }
 }
 
-// Check if touch coord is over a button (i.e. a button is being pressed)
+// Check if touch coord is over a button (i.e. a button is being pressed).  Same edges as TFT_eSPI_Button::contains().
 boolean MyTouchScreen::isPressCoordOverButton(uint8_t buttonNumber, uint16_t X, uint16_t Y) {
-   if(_buttonsPtr[buttonNumber].contains(X,Y)) {
+   int left = KEY_X + (buttonNumber % BUTTON_COLUMNS) * (KEY_W + KEY_SPACING_X) - KEY_W/2;
+   int top = KEY_Y + (buttonNumber / BUTTON_COLUMNS) * (KEY_H + KEY_SPACING_Y) - KEY_H/2;
+   if(X >= left && X < left + KEY_W && Y >= top && Y < top + KEY_H) {
       return(true);
    } else {
       return(false);
    }
 }
 
-// Set the buttons "pressed" attribute true or false
+// The buttons sit on a fixed grid so the touched one can be worked out directly rather than asking each
+// button if it contains the point.  Same edges as isPressCoordOverButton().
+int8_t MyTouchScreen::buttonAt(uint16_t X, uint16_t Y) {
+   int x = (int)X - (KEY_X - KEY_W/2);
+   int y = (int)Y - (KEY_Y - KEY_H/2);
+   if(x < 0 || y < 0) {
+      return(-1);
+   }
+   int col = x / (KEY_W + KEY_SPACING_X);
+   int row = y / (KEY_H + KEY_SPACING_Y);
+   if(col >= BUTTON_COLUMNS || row >= BUTTON_ROWS ||
+      x - col * (KEY_W + KEY_SPACING_X) >= KEY_W || y - row * (KEY_H + KEY_SPACING_Y) >= KEY_H) {
+      return(-1);   // Off the grid or in the gap between buttons
+   }
+   uint8_t bIndex = col + row * BUTTON_COLUMNS;
+   if(!_buttonVisible[bIndex]) {
+      return(-1);
+   }
+   return(bIndex);
+}
+
+// Set the buttons "pressed" attribute true or false (the old state is kept for the just pressed/released checks)
 void MyTouchScreen::setButtonPressed(uint8_t buttonNumber, boolean state) {
-   _buttonsPtr[buttonNumber].press(state);
+   _buttonWasPressed = (_buttonWasPressed & ~BUTTON_BIT(buttonNumber)) | (_buttonPressed & BUTTON_BIT(buttonNumber));
+   if(state) {
+      _buttonPressed |= BUTTON_BIT(buttonNumber);
+   } else {
+      _buttonPressed &= ~BUTTON_BIT(buttonNumber);
+   }
+}
+
+// Clear both the current and previous press state so it reports neither a press nor a release
+void MyTouchScreen::clearButtonPress(uint8_t buttonNumber) {
+   _buttonPressed &= ~BUTTON_BIT(buttonNumber);
+   _buttonWasPressed &= ~BUTTON_BIT(buttonNumber);
 }
 
 // Check if button was just Pressed
 boolean MyTouchScreen::wasButtonJustPressed(uint8_t buttonNumber) {
-   return(_buttonsPtr[buttonNumber].justPressed());
+   return((_buttonPressed & ~_buttonWasPressed & BUTTON_BIT(buttonNumber)) != 0);
 }
 
 // Check if button was just Released
 boolean MyTouchScreen::wasButtonJustReleased(uint8_t buttonNumber) {
-   return(_buttonsPtr[buttonNumber].justReleased());
+   return((~_buttonPressed & _buttonWasPressed & BUTTON_BIT(buttonNumber)) != 0);
 }
 
 // Draw the indexed button onto the screen (plain or inverted background)
 void MyTouchScreen::drawButton(uint8_t buttonNumber, boolean inverted) {
-   _buttonsPtr[buttonNumber].drawButton(inverted);
+   _drawKey(buttonNumber, inverted);
+   _buttonTextHash[buttonNumber] = 0;   // Its label overlay needs drawing again
+}
+
+// The button's outline and fill at its spot on the grid.  A TFT_eSPI_Button is only needed for the
+// drawing so it's set up here rather than kept for every button of every screen.
+void MyTouchScreen::_drawKey(uint8_t buttonNumber, boolean inverted) {
+   TFT_eSPI_Button key;
+   // x, y, w, h, outline, fill, button text, textsize
+   key.initButton(_tftPtr, KEY_X + (buttonNumber % BUTTON_COLUMNS) * (KEY_W + KEY_SPACING_X),
+                  KEY_Y + (buttonNumber / BUTTON_COLUMNS) * (KEY_H + KEY_SPACING_Y),
+                  KEY_W, KEY_H, TFT_WHITE, TFT_BLUE, TFT_WHITE, _noLabel, KEY_TEXTSIZE);
+   key.setLabelDatum(0,0,MC_DATUM);
+   key.drawButton(inverted);
 }
 
 // Execute the button callback code
@@ -463,7 +1636,7 @@ void MyTouchScreen::executeButtonCallBack(uint8_t buttonNumber) {
 // To enable a text field to make it visible on the screen
 void MyTouchScreen::enableTextField(uint8_t textFieldNumber, const char *label, int X, int Y) {
    _textVisible[textFieldNumber] = true;
-   strcpy(_textFields+((sizeof(char)*TEXT_LEN)+1)*textFieldNumber,label);
+   _textFields[textFieldNumber] = label;
    _textCoords[textFieldNumber][0] = X;
    _textCoords[textFieldNumber][1] = Y;
 }
@@ -474,25 +1647,26 @@ void MyTouchScreen::enableTextField(uint8_t textFieldNumber, const char *label,
 // To enable a text sprite field to make it visible on the screen
 void MyTouchScreen::enableTextSprite(uint8_t fieldNumber, const char *label, int X, int Y) {
    _textSpriteVisible[fieldNumber] = true;
-   strcpy(_textSpriteFields+((sizeof(char)*TEXT_LEN)+1)*fieldNumber,label);
+   _textSpriteFields[fieldNumber] = label;
    _textSpriteCoords[fieldNumber][0] = X;
    _textSpriteCoords[fieldNumber][1] = Y;
+   _textSpriteHash[fieldNumber] = 0;
 }
 
-// To update the text for the given field's sprite
+// To change the string the given field's sprite shows
 void MyTouchScreen::updateTextSprite(uint8_t fieldNumber, const char *label) {
-   strcpy(_textSpriteFields+((sizeof(char)*TEXT_LEN)+1)*fieldNumber,label);
+   _textSpriteFields[fieldNumber] = label;
 }
 
 // To enable a clock text sprite field to make it visible on the screen
 void MyTouchScreen::enableClockSprite(uint8_t fieldNumber, const char *label, int X, int Y) {
-   strcpy(_clockSpriteFields+(sizeof(char)*TEXT_LEN+1)*fieldNumber,label);
+   _clockSpriteFields[fieldNumber] = label;
    _clockSpriteCoords[fieldNumber][0] = X;
    _clockSpriteCoords[fieldNumber][1] = Y;
+   _clockSpriteHash[fieldNumber] = 0;
 }
 
-// To update the text for the clock field's sprite
+// To change the string the clock field's sprite shows
 void MyTouchScreen::updateClockSprite(uint8_t fieldNumber, const char *label) {
-   strcpy(_clockSpriteFields+(sizeof(char)*TEXT_LEN+1)*fieldNumber,label);
+   _clockSpriteFields[fieldNumber] = label;
 }
-
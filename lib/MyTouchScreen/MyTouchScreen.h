@@ -8,6 +8,10 @@
 #include "Arduino.h"
 #include "MyDisplay.h"
 #include "MyFreeFonts.h"
+#include <MyResultPyramid.h>
+#include <MyGlyphAtlas.h>
+#include <MyScreenCache.h>
+#include <MyGraphTransform.h>
 
 // For sd card
 #include <FS.h>
@@ -17,6 +21,89 @@
 // Uses the Bodmer TFT_eSPI graphics display library
 #include <TFT_eSPI.h>
 
+// When replaying a long session there are many more data points than pixel columns on the graph.
+// Points that land in the same column are collapsed to the min/max/first/last Y pixel of that column
+// so we draw at most a connecting line and a vertical min-max line per column (spikes are kept).
+struct graphColumn {
+   int x;            // Pixel column being accumulated
+   int minY;
+   int maxY;
+   int firstY;
+   int lastY;
+   int prevX;        // Last point of the previous column (where the connecting line starts)
+   int prevY;
+   boolean active;   // A column is being accumulated
+   boolean havePrev; // prevX/prevY are valid
+};
+
+// A plot rectangle on the display (inclusive pixel coords).  The plot renderer draws and clips to one of
+// these, so the same code draws the full size graph or the stacked mini-plots of a split view.
+struct graphViewport {
+   int left;      // Y axis
+   int top;
+   int right;
+   int bottom;    // X axis
+};
+
+// A screen's mutable state: which string each button/field shows, what's visible and what's been drawn.  The
+// strings themselves stay where they are (the layout's text in flash, the settings and results in the app's
+// variables), so this is a few pointers and flags per field.  Each screen gets one of these from a static arena
+// (see the .cpp) so the memory is accounted for at link time instead of coming out of the heap during static
+// construction.
+struct screenStorage {
+   const char * buttonLabels[NUM_BUTTONS];
+   uint8_t buttonValueSize[NUM_BUTTONS];   // Size of the variable a setting's label is bound to (0 = fixed text)
+   boolean buttonVisible[NUM_BUTTONS];
+   uint32_t buttonTextHash[NUM_BUTTONS];
+   const char * textFields[TEXT_ROWS];
+   const char * textSpriteFields[TEXT_ROWS];
+   const char * clockSpriteFields[CLOCK_ROWS];
+};
+
+// Declarative screen layouts.  A layout is a constexpr table (so it stays in flash) listing the buttons, text
+// fields and sprite fields of a screen, and loadLayout() sets the screen up from it.  Nothing is copied: the
+// screen points at the layout's strings.  A button whose label is a char array (rather than a string literal)
+// is a setting.  Its label is bound to that variable, so the button always shows the current value and
+// updateButtonLabel() (the keypad, say) writes the new value straight into it.
+struct screenButton {
+   uint8_t button;
+   const char * label;
+   void (*callBack)(uint8_t);
+   uint8_t valueSize;   // sizeof the bound variable (0 for fixed text)
+
+   constexpr screenButton(uint8_t buttonNumber, const char * text, void (*callBackPtr)(uint8_t)) :
+      button(buttonNumber), label(text), callBack(callBackPtr), valueSize(0) {}
+   template<size_t N> constexpr screenButton(uint8_t buttonNumber, char (&value)[N], void (*callBackPtr)(uint8_t)) :
+      button(buttonNumber), label(value), callBack(callBackPtr), valueSize(N) {
+      static_assert(N <= 255, "Setting buffer too big for screenButton");
+   }
+};
+struct screenText {
+   uint8_t field;
+   const char * text;
+   int x;
+   int y;
+};
+struct screenLayout {
+   const screenButton * buttons;
+   uint8_t numButtons;
+   const screenText * text;         // Fixed text fields
+   uint8_t numText;
+   const screenText * sprites;      // Text sprite (result) fields
+   uint8_t numSprites;
+   const screenText * clocks;       // Clock sprite fields
+   uint8_t numClocks;
+};
+#define LAYOUT_COUNT(table) (sizeof(table) / sizeof((table)[0]))
+
+// Graph display modes
+#define GRAPH_MODE_FULL  0   // X axis runs from 0 to the monitor duration
+#define GRAPH_MODE_STRIP 1   // Strip chart.  A monitor-duration wide window that ends at the newest sample and scrolls left
+#define GRAPH_MODE_OVERLAY 2 // All the result channels on one plot (X axis as GRAPH_MODE_FULL)
+#define GRAPH_MODE_SPLIT 3   // All the result channels in stacked mini-plots sharing the X axis (X axis as GRAPH_MODE_FULL)
+
+#define GRAPH_CHANNELS 3     // Max traces on an overlay graph
+
 class MyTouchScreen  {
 
    public:
@@ -25,7 +112,7 @@ class MyTouchScreen  {
       // Need to supply the screen handle, the sprite handles and the screen 
       // title and the max number of buttons a screen can define
       //#######################################################################
-      MyTouchScreen(TFT_eSPI *,TFT_eSprite *,TFT_eSprite *, TFT_eSprite *, TFT_eSprite *, TFT_eSprite *,  const char *, boolean);
+      MyTouchScreen(TFT_eSPI *,TFT_eSprite *,TFT_eSprite *, TFT_eSprite *, TFT_eSprite *, TFT_eSprite *, TFT_eSprite *, const char *, boolean);
   
       // This is a pointer to a function that takes 1 arg and returns void
       typedef void (*callBackPtr)(uint8_t);
@@ -37,12 +124,29 @@ class MyTouchScreen  {
       // Adds an entry to the screen vector arrays
       void init(MyTouchScreen *); 
 
+      // Set the screen up from a layout table.  Loading the layout that's already on the screen skips the
+      // init() and just clears the press state.
+      void loadLayout(const screenLayout *);
+
       // Get the pointer to a given screen
       MyTouchScreen * getScreenPtr(const char *);
 
       const char * getScreenTitle();
 
-      void setScreenType(const char *);  // Used with screens that are shared (like setup, results, graph, etc.)
+      // Memory accounting.  Bytes each screen takes (object plus its state block, the same for every
+      // screen), and the state arena shared by all the screens.
+      static uint32_t getMemoryUsed();
+      static uint32_t getArenaUsed();
+      static uint32_t getArenaSize();
+      static uint8_t getArenaOverflow();
+
+      // Pre-rendered TEXT_FONT glyphs used for the result fields where they can be (NULL to always use drawString)
+      static void setTextAtlas(MyGlyphAtlas *);
+
+      // Cache of drawn screens drawScreen() restores from when it can (NULL to always draw them)
+      static void setScreenCache(MyScreenCache *);
+
+      void setScreenType(const char *);  // Which results a monitor/graph screen shows (IV, TEMP, AD)
       const char * getScreenType();
 
       // Draw the field text sprite area (the non-button fields where we display 
@@ -62,24 +166,56 @@ class MyTouchScreen  {
       void drawScreenText();
 
       // There is a screen dedicated to plotting sensor data.  This sets up the graphing screen and adds the axis.
-      void drawGraph(boolean, const char *, int, float *, float *);
+      // The result pyramid (may be NULL) lets long sessions be drawn from the summary levels instead of the raw file.
+      void drawGraph(boolean, const char *, int, float *, float *, MyResultPyramid *);
 
       // This adds data points to the graph.  One X Y data point per call of this function..
       // The X Y data are in the graph units (degree, mA, seconds, etc.).  This function translates to pixel coords.
       void addGraphData(int, float *, float *);
+      void addGraphData(int, float *, float *, uint8_t);   // Channel of an overlay graph
+
+      // Overlay graph of several result channels, each with its own color and Y scale.
+      //                   channels, arrays-filled, result files, result index, X arrays, Y arrays, pyramids
+      void drawOverlayGraph(uint8_t, boolean, const char **, int, float **, float **, MyResultPyramid **);
+
+      // Y scale, legend label and color for an overlay channel (setYAxis sets channel 0)
+      //                     channel, min, max, label, color
+      void setOverlayChannel(uint8_t, float, float, const char *, uint16_t);
 
       // Graph variable control
       //             min, max, intervals, label
       void setXAxis(float, float, float, const char *);
       void setYAxis(float, float, float, const char *);
 
+      // Zoom/pan support.  Plot pixel column to X axis units, and a vertical marker line over the plot 
+      // (erasing it restores the plot underneath from the plot sprite).
+      float pixelToDataX(int);
+      void drawGraphMarker(int, uint16_t);
+      void eraseGraphMarker(int);
+
+      // Graph cursor.  Nearest logged sample to an X value (binary searched, see the .cpp), then a crosshair
+      // on it with the values read out above the plot.
+      //                        X, arrays-filled, result file, result index, X array, Y array, -> sample X, sample Y
+      boolean findNearestSample(float, boolean, const char *, int, float *, float *, float *, float *);
+      //                     sample X, channels, channel values
+      void drawGraphCursor(float, uint8_t, float *);
+      void eraseGraphCursor();
+      int getGraphCursorX();
+
+      // GRAPH_MODE_FULL or GRAPH_MODE_STRIP.  Strip charts need the plot sprite, without it we draw the full graph.
+      void setGraphMode(uint8_t);
+
+      // Split view.  drawOverlayGraph stacks the channels in their own mini-plots instead of overlaying them.
+      void setSplitView(boolean);
+
       // Leave the axis in place but clear the data points
       void clearGraphData();
       
-      // Set the button visible and clickable
+      // Set the button visible and clickable.  The label is fixed text (the string has to stay around, it isn't copied).
       void enableButton(uint8_t, const char *, callBackPtr);    
 
-      // Update the button label
+      // Update the button label.  A setting's label (see screenButton) gets the text copied into its variable,
+      // any other button just shows the string passed from now on.
       void updateButtonLabel(uint8_t, const char *);    
 
       // The button label is where we store option values.  Read it so we can use the value in the main code.
@@ -109,19 +245,26 @@ class MyTouchScreen  {
       // Check if the current touch coords land over a button
       boolean isPressCoordOverButton(uint8_t, uint16_t, uint16_t);   
 
+      // Visible button under the touch coords, worked out from the button grid (-1 if none)
+      int8_t buttonAt(uint16_t, uint16_t);
+
+      // Forget a button's press state without it reporting a release
+      void clearButtonPress(uint8_t);
+
       // Set the text field row, the text string and the placement X/Ycoords
       void enableTextField(uint8_t, const char *, int, int);    
 
-      // Set the text sprite field row, the text sprite string and the placement X/Ycoords
+      // Set the text sprite field row, the text sprite string and the placement X/Ycoords.  The field shows
+      // whatever is in the string when it's drawn (usually a result variable the app keeps up to date).
       void enableTextSprite(uint8_t, const char *, int, int);    
 
-      //  Update the sprite text 
+      //  Point the sprite field at another string
       void updateTextSprite(uint8_t, const char *);    
 
       // Set the clock sprite field row, the text sprite string and the placement X/Ycoords
       void enableClockSprite(uint8_t, const char *, int, int);    
 
-      //  Update the clock sprite text 
+      //  Point the clock sprite field at another string
       void updateClockSprite(uint8_t, const char *);    
 
 
@@ -133,39 +276,57 @@ class MyTouchScreen  {
       TFT_eSprite *_statusSpritePtr;
       TFT_eSprite *_yAxisSpritePtr;
 
+      // Off-screen 4-bit palette framebuffer for the plot window.  Grid and traces are drawn into it and only
+      // the rectangle that changed gets pushed to the display.  If it couldn't be allocated we draw direct.
+      TFT_eSprite *_plotSpritePtr;
+      boolean _plotToSprite;
+      int _dirtyX0, _dirtyY0, _dirtyX1, _dirtyY1;   // Sprite coords still to be pushed (X0 > X1 when clean)
+
       // The screen title at the top/center of the display
       const char * _title;
-      const char * _type;  // Used where we share one screen for different resuls (iv, temp, AD)
+      const char * _type;  // Which results a monitor/graph screen shows (iv, temp, AD)
       boolean _titleVisible;
-      char _nopS[TITLE_LEN];
+      const screenLayout * _layout;   // Layout last loaded (NULL after init())
 
-      // Using Malloc to move storage to Heap to make more room for .bss 
-      char * _textSpriteNopS = (char *) malloc(sizeof(char) * TEXT_LEN + 1);
+      // The screen's field pointers live in its screenStorage block.  The pointers below point into it.
+      screenStorage * _storage;
 
       // An array of pointers to callback functions.  Use this to load callbacks for the buttons
       // When a button is pushed, the associated callback function is executed.
       callBackPtr _buttonCallBackPtr[NUM_BUTTONS];
 
-      // Each screen has an array of four columns and six rows of buttons.  Each button may be set visible or 
-      // invisible (not used) so that we can customize each menu as the requirements dictate.
-      TFT_eSPI_Button _buttonsPtr[NUM_BUTTONS];        // Array of button objects
-      char * _buttonLabels = (char *) malloc(sizeof(char) * (TITLE_LEN + 1) * NUM_BUTTONS);
-      boolean * _buttonVisible = (boolean *) malloc((sizeof *_buttonVisible) * NUM_BUTTONS);
+      // Each screen has a grid of four columns and six rows of buttons.  Each button may be set visible or 
+      // invisible (not used) so that we can customize each menu as the requirements dictate.  The grid is
+      // fixed so a button is drawn from its index (see _drawKey) and only its press state is kept, one bit
+      // per button for now and one for the last time it was set (for the just pressed/released checks).
+      uint32_t _buttonPressed;
+      uint32_t _buttonWasPressed;
+      const char ** _buttonLabels;
+      uint8_t * _buttonValueSize;
+      boolean * _buttonVisible;
+      void _drawKey(uint8_t, boolean);
                                                        
-      char * _textFields = (char *) malloc((sizeof(char) * TEXT_LEN + 1) * TEXT_ROWS);
+      const char ** _textFields;
       int _textCoords[TEXT_ROWS][2];            // Array of text X,Y placement coords
       boolean _textVisible[TEXT_ROWS];          // Array of text visibility to display/hide a given field
    
       // Sprites are small text areas where dynamic results are displayed (sensor results, etc.)
       // When a value changes, just the small screen area under the sprite is updated (not the entire display)
       // so we avoid any text flickering issues.
-      char * _textSpriteFields = (char *) malloc((sizeof(char) * TEXT_LEN + 1) * TEXT_ROWS);
+      const char ** _textSpriteFields;
       int _textSpriteCoords[TEXT_ROWS][2];          // Array of sprite text X,Y placement coords
       boolean _textSpriteVisible[TEXT_ROWS];        // Array of sprite text visibility to display/hide a given field
                                                       
       // Special clock sprite for the wide date/time field
-      char * _clockSpriteFields = (char *) malloc((sizeof(char) * TEXT_LEN + 1) * CLOCK_ROWS);
+      const char ** _clockSpriteFields;
       int _clockSpriteCoords[CLOCK_ROWS][2];                    // Sprite text X,Y placement coords
+
+      // Hash of the text each sprite field/button label last drew on the display (0 = needs drawing).
+      // Redrawing a field is skipped while its text hashes the same.
+      uint32_t _textSpriteHash[TEXT_ROWS];
+      uint32_t _clockSpriteHash[CLOCK_ROWS];
+      uint32_t * _buttonTextHash;
+      void _invalidateFields();
                                                       
       // Graphing variables
       float _xAxisMin;
@@ -176,6 +337,83 @@ class MyTouchScreen  {
       float _yAxisIntervals;
       const char * _xAxisLabel;
       const char * _yAxisLabel;
+
+      // Fixed point data to pixel transforms.  Worked out once in setXAxis/setYAxis so plotting a
+      // point is integer only (no floats, no divides).
+      graphTransform _xTransform;
+      graphTransform _yTransform[GRAPH_CHANNELS];
+
+      // Where things get drawn.  The plot area is the whole plot window (what the plot sprite covers).  Each 
+      // channel is drawn in one of the viewports (all of them the plot area unless it's a split view) and
+      // _vp is the one _plotSegment is currently clipping to.
+      graphViewport _plotArea;
+      graphViewport _viewport[GRAPH_CHANNELS];
+      uint8_t _viewports;
+      uint8_t _vp;
+      boolean _splitView;
+      void _layoutViewports();
+      uint8_t _channelVp(uint8_t);
+      float _viewportIntervals();
+
+      // Data to pixel coordinate transforms for the current axis settings
+      int _dataToPixelX(float);
+      int _dataToPixelY(float, uint8_t);
+
+      // Cohen-Sutherland clipping of a line segment to the plot window.  Returns false if nothing is visible.
+      uint8_t _outCode(int, int);
+      boolean _clipSegment(int *, int *, int *, int *);
+      void _plotSegment(int, int, int, int, uint16_t);
+
+      // Plot window drawing (to the plot sprite when we have one)
+      void _plotBegin();
+      void _drawPlotFrame();
+      uint16_t _plotColor(uint16_t);
+      void _markDirty(int, int, int, int);
+      void _pushPlot();
+
+      // Strip chart.  The X axis slides along with the data so the newest sample sits on the right border.
+      uint8_t _graphMode;
+      float _stripWindow;         // Width of the window in X axis units
+      boolean _stripActive();
+      void _stripScroll(int);
+
+      // Plot the summary buckets of a pyramid level.  Returns the raw file offset where the buckets end.
+      uint32_t _drawPyramidLevel(const char *, uint8_t, graphColumn *, uint8_t, boolean *);
+
+      // Raw file offset to start reading from for a given X (uses the finest pyramid level as an index)
+      uint32_t _rawOffsetFor(const char *, float);
+
+      // Overlay channels (channel 0 is the regular single trace graph)
+      uint8_t _overlayChannels;
+      float _channelMin[GRAPH_CHANNELS];
+      float _channelMax[GRAPH_CHANNELS];
+      const char * _channelLabel[GRAPH_CHANNELS];
+      uint16_t _channelColor[GRAPH_CHANNELS];
+
+      // Graph cursor (drawn over the plot on the display, not in the plot sprite)
+      boolean _cursorShown;
+      int _cursorX;
+      int _cursorY[GRAPH_CHANNELS];
+      uint8_t _cursorChannels;
+
+      // Pieces of drawGraph/drawOverlayGraph
+      void _drawGraphFrame(int, float *);
+      void _drawChrome(TFT_eSprite *, int, int, float);
+
+      // Graph chrome cache (the labels around the plot window, see _chromeBands)
+      boolean _showChromeBand(uint8_t, float);
+      uint32_t _chromeKey(uint8_t, float);
+
+      // Screen cache key (everything drawScreen() draws except the button labels)
+      uint32_t _screenKey();
+      boolean _chromeEncode(uint8_t, TFT_eSprite *);
+      void _chromeDecode(uint8_t);
+      void _replayChannel(uint8_t, boolean, const char *, int, float *, float *, MyResultPyramid *);
+
+      // Per pixel column decimation of long traces (see graphColumn)
+      void _columnStart(graphColumn *);
+      void _columnAdd(graphColumn *, int, int, uint16_t);
+      void _columnFlush(graphColumn *, uint16_t);
                                                 
 };
 #endif
@@ -20,7 +20,7 @@ void toggleAdAlarm(uint8_t buttonNumber) {
       strcpy(adAlarmArmedS,"Enabled");
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,adAlarmArmedS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 void clearCount(uint8_t buttonNumber) {
@@ -37,19 +37,12 @@ void cycleAdAinMax(uint8_t buttonNumber) {
       strcpy(maxAinVoltageS,"3.0");
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,maxAinVoltageS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 
    // NOTE: User MUST match the Ain range setting (knob on side of box) to the maxAinVoltage selected
    char txt[TEXT_LEN] = "Pls Set Range Knob To ";
    strcat(txt,maxAinVoltageS);
-   statusSprite.setTextColor(STATUS_COLOR, STATUS_BACKGROUND);
-   statusSprite.setTextDatum(STATUS_DATUM);
-   statusSprite.setFreeFont(STATUS_TEXT_FONT);
-   statusSprite.fillSprite(STATUS_BACKGROUND);
-   statusSprite.drawString(txt, STATUS_WIDTH/2,STATUS_HEIGHT/2,GFXFF);
-   statusSprite.pushSprite(STATUS_X, STATUS_Y);
-   delay(2000);
-   curScreenPtr->drawScreen();
+   toastShow(txt, TOAST_LONG_MS);
 }
 
 //##############################
@@ -64,28 +57,28 @@ void updateDoutPwmDutyCycle() {
    int mapHigh = 100;
 
    // If running in PWM-Inv mode, then flip the dutyCycle hi/low (e.g. 10% dutyCycle pulse would be high 90%, low 10%)
-   if(!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(3), "PWM-Inv")) {
+   if(!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_OUTPUT_BTN), "PWM-Inv")) {
       mapLow = 100;
       mapHigh = 0;
    }
 
    // PWM Fixed so just grab the pwm duty cycle setting directly
-   if(!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(15), "Fixed")) {
-      doutPwmDutyCycle = atoi(getScreenPtr(DOUT_MENU)->getButtonLabel(11));
+   if(!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_FOLLOWS_BTN), "Fixed")) {
+      doutPwmDutyCycle = atoi(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_DUTY_CYCLE_BTN));
       ledcWrite(pwmChannel, constrain(map(doutPwmDutyCycle,mapLow,mapHigh,0,1023),0,1023));  // 10-bit pwm gives 0-1023 range for pwm
 
    // PWM can follow Ain/Temperature/Humidity/Current so get the measured value and map it to the pwm range
-   } else if(!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(15), "Ain")) {     
-      ledcWrite(pwmChannel, constrain(map((ainVoltage/atof(getScreenPtr(SETUP_MENU)->getButtonLabel(11)))*100,mapLow,mapHigh,0,1023),0,1023));  
+   } else if(!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_FOLLOWS_BTN), "Ain")) {     
+      ledcWrite(pwmChannel, constrain(map((ainVoltage/atof(getScreenPtr(SCREEN_AD_SETUP)->getButtonLabel(SETUP_LIMIT1_BTN)))*100,mapLow,mapHigh,0,1023),0,1023));  
 
-   } else if(!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(15), "Temp")) {     
-      ledcWrite(pwmChannel, constrain(map((curModuleTemp/atof(getScreenPtr(SETUP_MENU)->getButtonLabel(7)))*100,mapLow,mapHigh,0,1023),0,1023)); 
+   } else if(!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_FOLLOWS_BTN), "Temp")) {     
+      ledcWrite(pwmChannel, constrain(map((curModuleTemp/atof(getScreenPtr(SCREEN_TEMP_SETUP)->getButtonLabel(SETUP_LIMIT0_BTN)))*100,mapLow,mapHigh,0,1023),0,1023)); 
       
-   } else if(!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(15), "Humidity")) {   
-      ledcWrite(pwmChannel, constrain(map((curModuleHumidity/atof(getScreenPtr(SETUP_MENU)->getButtonLabel(11)))*100,mapLow,mapHigh,0,1023),0,1023)); 
+   } else if(!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_FOLLOWS_BTN), "Humidity")) {   
+      ledcWrite(pwmChannel, constrain(map((curModuleHumidity/atof(getScreenPtr(SCREEN_TEMP_SETUP)->getButtonLabel(SETUP_LIMIT1_BTN)))*100,mapLow,mapHigh,0,1023),0,1023)); 
 
-   } else if(!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(15), "Current")) {   
-      ledcWrite(pwmChannel, constrain(map((current_mA/atof(getScreenPtr(SETUP_MENU)->getButtonLabel(7)))*100,mapLow,mapHigh,0,1023),0,1023));
+   } else if(!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_FOLLOWS_BTN), "Current")) {   
+      ledcWrite(pwmChannel, constrain(map((current_mA/atof(getScreenPtr(SCREEN_IV_SETUP)->getButtonLabel(SETUP_LIMIT0_BTN)))*100,mapLow,mapHigh,0,1023),0,1023));
    }
 }
 
@@ -97,7 +90,7 @@ void cycleDoutOutput(uint8_t buttonNumber) {
    } else if(!strcmp(doutOutputS,"High")) {
       strcpy(doutOutputS,"PWM");
       // Set up and turn on PWM
-      doutPwmDutyCycle = atoi(getScreenPtr(DOUT_MENU)->getButtonLabel(11));
+      doutPwmDutyCycle = atoi(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_DUTY_CYCLE_BTN));
       ledcAttachPin(DOUTPIN, pwmChannel);  
       ledcSetup(pwmChannel, pwmFrequency, pwmResolution); 
       ledcWrite(pwmChannel, constrain(map(doutPwmDutyCycle,0,100,0,1023),0,1023));  // 10-bit pwm gives 0-1023 range for pwm
@@ -112,7 +105,7 @@ void cycleDoutOutput(uint8_t buttonNumber) {
       digitalWrite(DOUTPIN,0);
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,doutOutputS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 void cycleDoutPwmFrequency(uint8_t buttonNumber) {
@@ -130,7 +123,7 @@ void cycleDoutPwmFrequency(uint8_t buttonNumber) {
       pwmFrequency=1000;
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,doutPwmFrequencyS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
    ledcSetup(pwmChannel, pwmFrequency, pwmResolution);
    ledcWrite(pwmChannel, constrain(map(doutPwmDutyCycle,0,100,0,1023),0,1023));  // 10-bit pwm gives 0-1023 range for pwm
 }
@@ -148,7 +141,7 @@ void cycleDoutPwmFollows(uint8_t buttonNumber) {
       strcpy(doutPwmFollowsS,"Ain");
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,doutPwmFollowsS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 void cycleDoutActionOnAlarm(uint8_t buttonNumber) {
@@ -164,7 +157,7 @@ void cycleDoutActionOnAlarm(uint8_t buttonNumber) {
       strcpy(doutActionOnAlarmS,"None");
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,doutActionOnAlarmS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 //##############################
@@ -179,7 +172,7 @@ void cycle110vActionOnAlarm(uint8_t buttonNumber) {
       strcpy(action110vOnAlarmS,"Turn On");
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,action110vOnAlarmS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 void cycle110vActionOnClock(uint8_t buttonNumber) {
@@ -191,7 +184,7 @@ void cycle110vActionOnClock(uint8_t buttonNumber) {
       strcpy(action110vOnClockS,"Turn On");
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,action110vOnClockS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 void manual110vAction(uint8_t buttonNumber) {
@@ -203,7 +196,37 @@ void manual110vAction(uint8_t buttonNumber) {
       digitalWrite(EXT_POWER_RELAY, HIGH);
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,manual110vActionS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
+}
+
+//##############################
+// Serial Streaming Callbacks
+//##############################
+void toggleStream(uint8_t buttonNumber) {
+   if(!strcmp(streamStateS,"StreamOn")) {
+      strcpy(streamStateS,"StreamOff");
+      streamEnd();
+   } else {
+      strcpy(streamStateS,"StreamOn");
+   }
+   curScreenPtr->updateButtonLabel(curButtonPressed,streamStateS);
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
+}
+
+// Full graph (0 to monitor duration), a strip chart of the last few minutes of results, all the
+// results overlaid on one graph, or all the results in stacked plots
+void cycleGraphMode(uint8_t buttonNumber) {
+   if(!strcmp(graphModeS,"ViewFull")) {
+      strcpy(graphModeS,"ViewStrip");
+   } else if(!strcmp(graphModeS,"ViewStrip")) {
+      strcpy(graphModeS,"ViewOvrly");
+   } else if(!strcmp(graphModeS,"ViewOvrly")) {
+      strcpy(graphModeS,"ViewSplit");
+   } else {
+      strcpy(graphModeS,"ViewFull");
+   }
+   curScreenPtr->updateButtonLabel(curButtonPressed,graphModeS);
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 //##############################
@@ -218,7 +241,7 @@ void toggleIvAlarm(uint8_t buttonNumber) {
       strcpy(ivAlarmArmedS,"Enabled");
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,ivAlarmArmedS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 //##############################
@@ -233,7 +256,7 @@ void toggleTempAlarm(uint8_t buttonNumber) {
       strcpy(tempAlarmArmedS,"Enabled");
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,tempAlarmArmedS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 // #########################
@@ -280,21 +303,13 @@ void toggleClockAlarm(uint8_t buttonNumber) {
       strcpy(clockAlarmArmedS,"AlarmOn");
    }
    curScreenPtr->updateButtonLabel(curButtonPressed,clockAlarmArmedS);
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 //#################################################
 // Placeholder for buttons with no callback defined 
 //#################################################
 void nop(uint8_t buttonNumber) {
-   char txt[] = "Not Yet Implemented";
-   statusSprite.setTextColor(STATUS_COLOR, STATUS_BACKGROUND);
-   statusSprite.setTextDatum(STATUS_DATUM);
-   statusSprite.setFreeFont(STATUS_TEXT_FONT);
-   statusSprite.fillSprite(STATUS_BACKGROUND);
-   statusSprite.drawString(txt, STATUS_WIDTH/2,STATUS_HEIGHT/2,GFXFF);
-   statusSprite.pushSprite(STATUS_X, STATUS_Y);
-   delay(1500);
-   curScreenPtr->drawScreen();
+   toastShow("Not Yet Implemented", TOAST_SHORT_MS);
 }
 
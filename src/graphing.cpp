@@ -6,60 +6,262 @@
 
 #include <graphing.h>
 
+// The "ViewFull/ViewStrip/ViewOvrly/ViewSplit" option on the monitor screens.  A strip chart shows a monitor-duration
+// wide window that follows the newest results, so a long running session never runs off the graph.
+uint8_t curGraphMode() {
+   if(!strcmp(graphModeS,"ViewStrip")) {
+      return(GRAPH_MODE_STRIP);
+   }
+   if(!strcmp(graphModeS,"ViewOvrly")) {
+      return(GRAPH_MODE_OVERLAY);
+   }
+   if(!strcmp(graphModeS,"ViewSplit")) {
+      return(GRAPH_MODE_SPLIT);
+   }
+   return(GRAPH_MODE_FULL);
+}
+
+static screenId graphSetupMenu = SCREEN_IV_SETUP;   // Setup menu of the results being graphed (for the duration)
+
+// Full graphs run from 0 to the monitor duration (setup-menu button-15).  Strip charts show the
+// last "Strip Window" minutes (axis-menu button-19).  A zoomed/panned graph keeps its own range
+// while switching between results, but coming from the monitor screen starts over at the full range.
+void setGraphXAxis(screenId monitorMenu, screenId setupMenu) {
+   graphSetupMenu = setupMenu;
+   if(prevScreenPtr == getScreenPtr(monitorMenu)) {
+      graphZoomed = false;
+   }
+   applyGraphXAxis();
+}
+
+void applyGraphXAxis() {
+   curScreenPtr->setSplitView(curGraphMode() == GRAPH_MODE_SPLIT);
+   if(graphZoomed) {
+      curScreenPtr->setGraphMode(GRAPH_MODE_FULL);
+      curScreenPtr->setXAxis(graphZoomMin, graphZoomMax, 10, "Time (Min)");
+      return;
+   }
+   curScreenPtr->setGraphMode(curGraphMode());
+   if(curGraphMode() == GRAPH_MODE_STRIP) {
+      curScreenPtr->setXAxis(0, stripWindow, 10, "Time (Min)");
+   } else {
+      curScreenPtr->setXAxis(0, atof(getScreenPtr(graphSetupMenu)->getButtonLabel(SETUP_DURATION_BTN)), 10, "Time (Min)");
+   }
+}
+
+// The overlay and split views show all the channels of a session at once
+boolean allChannelsView() {
+   return(curGraphMode() == GRAPH_MODE_OVERLAY || curGraphMode() == GRAPH_MODE_SPLIT);
+}
+
+// All the channels of the session on one graph (overlaid, or stacked for a split view).  The Y axis of each
+// channel must already be set up (setYAxis for channel 0, setOverlayChannel for the others).
+void drawOverlayGraph(uint8_t channels) {
+   const char * files[GRAPH_CHANNELS] = {resF0, resF1, resF2};
+   float * xArrs[GRAPH_CHANNELS] = {monitoredResultsXAxis0, monitoredResultsXAxis1, monitoredResultsXAxis2};
+   float * yArrs[GRAPH_CHANNELS] = {monitoredResultsYAxis0, monitoredResultsYAxis1, monitoredResultsYAxis2};
+   MyResultPyramid * pyramids[GRAPH_CHANNELS] = {&resPyramid0, &resPyramid1, &resPyramid2};
+
+   strcpy(currentlyGraphing,GRAPH_OVERLAY);
+   curScreenPtr->drawOverlayGraph(channels,resultArraysFilled,files,resArrIdx,xArrs,yArrs,pyramids);
+}
+
+// Redraw whatever is on the graph screen (the Y axis are already set up) after a zoom or pan
+void redrawGraph() {
+   applyGraphXAxis();
+   if(!strcmp(currentlyGraphing,GRAPH_OVERLAY)) {
+      drawOverlayGraph(!strcmp(curResType,"AD") ? 2 : 3);
+   } else if(!strcmp(currentlyGraphing,resF0)) {
+      curScreenPtr->drawGraph(resultArraysFilled,resF0,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0,&resPyramid0);
+   } else if(!strcmp(currentlyGraphing,resF1)) {
+      curScreenPtr->drawGraph(resultArraysFilled,resF1,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1,&resPyramid1);
+   } else if(!strcmp(currentlyGraphing,resF2)) {
+      curScreenPtr->drawGraph(resultArraysFilled,resF2,resArrIdx,monitoredResultsXAxis2,monitoredResultsYAxis2,&resPyramid2);
+   }
+}
+
+//#################################################################################
+// Touch zoom and pan.  Called every loop while the graph screen is up.
+//   Drag across the plot          -> zoom in on the time range between the two ends
+//   Drag along the X axis labels  -> pan the time range
+//   Tap on the X axis labels      -> back to the full range
+//   Tap on the plot               -> cursor readout (see graphCursor)
+// The zoomed range is redrawn from the result pyramid/raw file index so only the 
+// part of the session in view gets read.
+//#################################################################################
+void graphTouch(boolean touchPressed, uint16_t touchX, uint16_t touchY) {
+   static uint8_t gesture = GESTURE_NONE;
+   static uint16_t startX;
+   static uint16_t lastX;
+
+   if(touchPressed) {
+      boolean inPlotX = (touchX >= GRAPH_X_ORIGIN && touchX <= GRAPH_X_RIGHT);
+      if(gesture == GESTURE_NONE) {
+         if(inPlotX && touchY >= GRAPH_Y_TOP && touchY <= GRAPH_Y_ORIGIN) {
+            gesture = GESTURE_ZOOM;
+            curScreenPtr->drawGraphMarker(touchX, TFT_RED);
+         } else if(inPlotX && touchY > GRAPH_Y_ORIGIN && touchY <= GRAPH_PAN_Y_BOTTOM) {
+            gesture = GESTURE_PAN;
+         } else {
+            return;
+         }
+         startX = touchX;
+         lastX = touchX;
+         return;
+      }
+      if(!inPlotX || touchX == lastX) {
+         return;
+      }
+      // Rubber band the other end of the zoom range
+      if(gesture == GESTURE_ZOOM) {
+         if(lastX != startX) {
+            curScreenPtr->eraseGraphMarker(lastX);
+         }
+         curScreenPtr->drawGraphMarker(touchX, TFT_RED);
+      }
+      lastX = touchX;
+      return;
+   }
+
+   // Released
+   if(gesture == GESTURE_NONE) {
+      return;
+   }
+   int dragged = (int)lastX - (int)startX;
+   if(gesture == GESTURE_ZOOM) {
+      if(abs(dragged) >= GRAPH_MIN_DRAG) {
+         graphZoomMin = curScreenPtr->pixelToDataX(min(startX, lastX));
+         graphZoomMax = curScreenPtr->pixelToDataX(max(startX, lastX));
+         graphZoomed = true;
+         redrawGraph();
+      } else {
+         curScreenPtr->eraseGraphMarker(startX);
+         curScreenPtr->eraseGraphMarker(lastX);
+         graphCursor(startX);
+      }
+   } else if(abs(dragged) >= GRAPH_MIN_DRAG) {
+      // Dragging right moves the window back in time
+      float shift = curScreenPtr->pixelToDataX(startX) - curScreenPtr->pixelToDataX(lastX);
+      graphZoomMin = curScreenPtr->pixelToDataX(GRAPH_X_ORIGIN) + shift;
+      graphZoomMax = curScreenPtr->pixelToDataX(GRAPH_X_RIGHT) + shift;
+      graphZoomed = true;
+      redrawGraph();
+   } else if(graphZoomed) {
+      graphZoomed = false;
+      redrawGraph();
+   }
+   gesture = GESTURE_NONE;
+}
+
+// Tap on the plot.  Crosshair on the nearest logged sample with its time and value(s) shown above the
+// plot (tapping the cursor again removes it).  The lookup is a binary search so it's just as quick at
+// the end of a multi-hour session.
+void graphCursor(uint16_t touchX) {
+   const char * files[GRAPH_CHANNELS] = {resF0, resF1, resF2};
+   float * xArrs[GRAPH_CHANNELS] = {monitoredResultsXAxis0, monitoredResultsXAxis1, monitoredResultsXAxis2};
+   float * yArrs[GRAPH_CHANNELS] = {monitoredResultsYAxis0, monitoredResultsYAxis1, monitoredResultsYAxis2};
+   float values[GRAPH_CHANNELS];
+   float sampleX = 0.0;
+   float chX;
+   uint8_t first = 0;
+   uint8_t channels = 1;
+
+   int cursorX = curScreenPtr->getGraphCursorX();
+   if(cursorX >= 0 && abs((int)touchX - cursorX) < GRAPH_MIN_DRAG) {
+      curScreenPtr->eraseGraphCursor();
+      return;
+   }
+
+   if(!strcmp(currentlyGraphing,GRAPH_OVERLAY)) {
+      channels = !strcmp(curResType,"AD") ? 2 : 3;
+   } else {
+      while(first < GRAPH_CHANNELS && strcmp(currentlyGraphing,files[first])) {
+         first++;
+      }
+      if(first == GRAPH_CHANNELS) {
+         return;
+      }
+   }
+
+   float dataX = curScreenPtr->pixelToDataX(touchX);
+   for(uint8_t ch=0; ch<channels; ch++) {
+      if(!curScreenPtr->findNearestSample(dataX,resultArraysFilled,files[first+ch],resArrIdx,xArrs[first+ch],yArrs[first+ch],
+                                          &chX,&values[ch])) {
+         return;
+      }
+      if(ch == 0) {
+         sampleX = chX;
+      }
+   }
+   curScreenPtr->drawGraphCursor(sampleX, channels, values);
+}
+
 //#################################
 // AD (Analog-in/Digital-in) graphs
 //#################################
 void drawAdGraph(uint8_t buttonNumber) {
    prevScreenPtr = curScreenPtr;
-   curScreenPtr = getScreenPtr(GRAPH);
+   curScreenPtr = getScreenPtr(SCREEN_AD_GRAPH);
    strcpy(curResType,"AD");
-   curScreenPtr->setScreenType(curResType);
 
    // Fix the number of intervals at 10 as that's about the most we can fit grid labels for
-   // Use the "Monitor-Duration" button as the X-Axis maximum
-   curScreenPtr->setXAxis(0, atof(getScreenPtr(SETUP_MENU)->getButtonLabel(15)), 10, "Time (Min)");
+   // Use the "Monitor-Duration" button as the X-Axis maximum (or the strip window for strip charts)
+   setGraphXAxis(SCREEN_AD_MONITOR, SCREEN_AD_SETUP);
 
-   // The "graph" button will initially display the current-ma graph
-   if(!strcmp(prevScreenPtr->getScreenTitle(), MONITOR_MENU) || buttonNumber == 20) {
+   // The "graph" button will initially display the current-ma graph (or both results for the overlay/split views)
+   if(prevScreenPtr == getScreenPtr(SCREEN_AD_MONITOR) && allChannelsView()) {
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_AD_AXIS)->getButtonLabel(AD_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_AD_AXIS)->getButtonLabel(AD_AXIS_DIN_BTN)), 10, "Din Count");
+      curScreenPtr->setOverlayChannel(1, atof(getScreenPtr(SCREEN_AD_AXIS)->getButtonLabel(AD_AXIS_MIN_BTN)), 
+                                      atof(getScreenPtr(SCREEN_AD_AXIS)->getButtonLabel(AD_AXIS_AIN_BTN)), "Ain Voltage", TFT_CYAN);
+      drawOverlayGraph(2);
+   } else if(prevScreenPtr == getScreenPtr(SCREEN_AD_MONITOR) || buttonNumber == 20) {
       strcpy(currentlyGraphing,resF0);
-      curScreenPtr->setYAxis(atof(getScreenPtr(AXIS_MENU)->getButtonLabel(11)), 
-                             atof(getScreenPtr(AXIS_MENU)->getButtonLabel(3)), 10, "Din Count");
-      curScreenPtr->drawGraph(resultArraysFilled,resF0,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0);
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_AD_AXIS)->getButtonLabel(AD_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_AD_AXIS)->getButtonLabel(AD_AXIS_DIN_BTN)), 10, "Din Count");
+      curScreenPtr->drawGraph(resultArraysFilled,resF0,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0,&resPyramid0);
    } else if(buttonNumber == 21) {
       strcpy(currentlyGraphing,resF1);
-      curScreenPtr->setYAxis(atof(getScreenPtr(AXIS_MENU)->getButtonLabel(11)), 
-                             atof(getScreenPtr(AXIS_MENU)->getButtonLabel(7)), 10, "Ain Voltage");
-      curScreenPtr->drawGraph(resultArraysFilled,resF1,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1);
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_AD_AXIS)->getButtonLabel(AD_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_AD_AXIS)->getButtonLabel(AD_AXIS_AIN_BTN)), 10, "Ain Voltage");
+      curScreenPtr->drawGraph(resultArraysFilled,resF1,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1,&resPyramid1);
    } 
 }
 
 // IV (current/voltage) graphs
 void drawIvGraph(uint8_t buttonNumber) {
    prevScreenPtr = curScreenPtr;
-   curScreenPtr = getScreenPtr(GRAPH);
+   curScreenPtr = getScreenPtr(SCREEN_IV_GRAPH);
    strcpy(curResType,"IV");
-   curScreenPtr->setScreenType(curResType);
 
    // Fix the number of intervals at 10 as that's about the most we can fit grid labels for
-   // Use the "Monitor-Duration" button as the X-Axis maximum
-   curScreenPtr->setXAxis(0, atof(getScreenPtr(SETUP_MENU)->getButtonLabel(15)), 10, "Time (Min)");
+   // Use the "Monitor-Duration" button as the X-Axis maximum (or the strip window for strip charts)
+   setGraphXAxis(SCREEN_IV_MONITOR, SCREEN_IV_SETUP);
 
-   // The "graph" button will initially display the current-ma graph
-   if(!strcmp(prevScreenPtr->getScreenTitle(), MONITOR_MENU) || buttonNumber == 20) {
+   // The "graph" button will initially display the current-ma graph (or all three for the overlay/split views)
+   if(prevScreenPtr == getScreenPtr(SCREEN_IV_MONITOR) && allChannelsView()) {
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_CURRENT_BTN)), 10, "Current (mA)");
+      curScreenPtr->setOverlayChannel(1, atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_MIN_BTN)), 
+                                      atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_VOLTAGE_BTN)), "Voltage (V)", TFT_CYAN);
+      curScreenPtr->setOverlayChannel(2, atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_MIN_BTN)), 
+                                      atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_POWER_BTN)), "Power (mW)", TFT_MAGENTA);
+      drawOverlayGraph(3);
+   } else if(prevScreenPtr == getScreenPtr(SCREEN_IV_MONITOR) || buttonNumber == 20) {
       strcpy(currentlyGraphing,resF0);
-      curScreenPtr->setYAxis(atof(getScreenPtr(AXIS_MENU)->getButtonLabel(15)), 
-                             atof(getScreenPtr(AXIS_MENU)->getButtonLabel(3)), 10, "Current (mA)");
-      curScreenPtr->drawGraph(resultArraysFilled,resF0,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0);
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_CURRENT_BTN)), 10, "Current (mA)");
+      curScreenPtr->drawGraph(resultArraysFilled,resF0,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0,&resPyramid0);
    } else if(buttonNumber == 21) {
       strcpy(currentlyGraphing,resF1);
-      curScreenPtr->setYAxis(atof(getScreenPtr(AXIS_MENU)->getButtonLabel(15)), 
-                             atof(getScreenPtr(AXIS_MENU)->getButtonLabel(7)), 10, "Voltage (V)");
-      curScreenPtr->drawGraph(resultArraysFilled,resF1,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1);
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_VOLTAGE_BTN)), 10, "Voltage (V)");
+      curScreenPtr->drawGraph(resultArraysFilled,resF1,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1,&resPyramid1);
    } else if(buttonNumber == 22) {
       strcpy(currentlyGraphing,resF2);
-      curScreenPtr->setYAxis(atof(getScreenPtr(AXIS_MENU)->getButtonLabel(15)), 
-                             atof(getScreenPtr(AXIS_MENU)->getButtonLabel(11)), 10, "Power (mW)");
-      curScreenPtr->drawGraph(resultArraysFilled,resF2,resArrIdx,monitoredResultsXAxis2,monitoredResultsYAxis2);
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_IV_AXIS)->getButtonLabel(IV_AXIS_POWER_BTN)), 10, "Power (mW)");
+      curScreenPtr->drawGraph(resultArraysFilled,resF2,resArrIdx,monitoredResultsXAxis2,monitoredResultsYAxis2,&resPyramid2);
    }
 }
 
@@ -68,28 +270,35 @@ void drawIvGraph(uint8_t buttonNumber) {
 //###############################
 void drawTempGraph(uint8_t buttonNumber) {
    prevScreenPtr = curScreenPtr;
-   curScreenPtr = getScreenPtr(GRAPH);
+   curScreenPtr = getScreenPtr(SCREEN_TEMP_GRAPH);
    strcpy(curResType,"TEMP");
-   curScreenPtr->setScreenType(curResType);
 
    // Fix the number of intervals at 10 as that's about the most we can fit grid labels for
-   curScreenPtr->setXAxis(0, atof(getScreenPtr(SETUP_MENU)->getButtonLabel(15)), 10, "Time (Min)");
+   setGraphXAxis(SCREEN_TEMP_MONITOR, SCREEN_TEMP_SETUP);
 
-   // The "graph" button will initially display the probe-temp graph
-   if(!strcmp(prevScreenPtr->getScreenTitle(), MONITOR_MENU) || buttonNumber == 20) {
+   // The "graph" button will initially display the probe-temp graph (or all three for the overlay/split views)
+   if(prevScreenPtr == getScreenPtr(SCREEN_TEMP_MONITOR) && allChannelsView()) {
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(TEMP_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(TEMP_AXIS_MAX_BTN)), 10, "Probe Temp (F)");
+      curScreenPtr->setOverlayChannel(1, atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(TEMP_AXIS_MIN_BTN)), 
+                                      atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(TEMP_AXIS_MAX_BTN)), "Module Temp (F)", TFT_CYAN);
+      curScreenPtr->setOverlayChannel(2, atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(HUM_AXIS_MIN_BTN)), 
+                                      atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(HUM_AXIS_MAX_BTN)), "Humidity(%)", TFT_MAGENTA);
+      drawOverlayGraph(3);
+   } else if(prevScreenPtr == getScreenPtr(SCREEN_TEMP_MONITOR) || buttonNumber == 20) {
       strcpy(currentlyGraphing,resF0);
-      curScreenPtr->setYAxis(atof(getScreenPtr(AXIS_MENU)->getButtonLabel(7)), 
-                             atof(getScreenPtr(AXIS_MENU)->getButtonLabel(3)), 10, "Probe Temp (F)");
-      curScreenPtr->drawGraph(resultArraysFilled,resF0,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0);
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(TEMP_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(TEMP_AXIS_MAX_BTN)), 10, "Probe Temp (F)");
+      curScreenPtr->drawGraph(resultArraysFilled,resF0,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0,&resPyramid0);
    } else if(buttonNumber == 21) {
       strcpy(currentlyGraphing,resF1);
-      curScreenPtr->setYAxis(atof(getScreenPtr(AXIS_MENU)->getButtonLabel(7)), 
-                             atof(getScreenPtr(AXIS_MENU)->getButtonLabel(3)), 10, "Module Temp (F)");
-      curScreenPtr->drawGraph(resultArraysFilled,resF1,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1);
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(TEMP_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(TEMP_AXIS_MAX_BTN)), 10, "Module Temp (F)");
+      curScreenPtr->drawGraph(resultArraysFilled,resF1,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1,&resPyramid1);
    } else if(buttonNumber == 22) {
       strcpy(currentlyGraphing,resF2);
-      curScreenPtr->setYAxis(atof(getScreenPtr(AXIS_MENU)->getButtonLabel(15)), 
-                             atof(getScreenPtr(AXIS_MENU)->getButtonLabel(11)), 10, "Humidity(%)");
-      curScreenPtr->drawGraph(resultArraysFilled,resF2,resArrIdx,monitoredResultsXAxis2,monitoredResultsYAxis2);
+      curScreenPtr->setYAxis(atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(HUM_AXIS_MIN_BTN)), 
+                             atof(getScreenPtr(SCREEN_TEMP_AXIS)->getButtonLabel(HUM_AXIS_MAX_BTN)), 10, "Humidity(%)");
+      curScreenPtr->drawGraph(resultArraysFilled,resF2,resArrIdx,monitoredResultsXAxis2,monitoredResultsYAxis2,&resPyramid2);
    }
 }
\ No newline at end of file
@@ -59,6 +59,9 @@
 #include <callbacks.h>
 #include <menus.h>
 #include <results.h>
+#include <streaming.h>
+#include <render.h>
+#include <toast.h>
 
 // For INA219 current/voltage measuring module
 #include "Wire.h"
@@ -99,6 +102,16 @@ MyTouchScreen * curScreenPtr;
 MyTouchScreen * prevScreenPtr;
 uint8_t curButtonPressed;
 uint8_t prevButtonNumber;
+int8_t lastTouchedButton = -1;             // Button under the touch last time around the loop (-1 if none)
+MyTouchScreen * touchScreenPtr = NULL;     // Screen lastTouchedButton belongs to
+boolean touchHeldOverScreenChange = false; // Touch that changed screens hasn't lifted yet
+
+// Touch panel sampling (see sampleTouch())
+#if TOUCH_IRQ_PIN >= 0
+volatile boolean touchIrqFlag = false;     // Set by the PENIRQ interrupt, cleared when we sample
+#endif
+unsigned long lastTouchPollTime = 0;
+boolean touchWasPressed = false;
 
 // Timers used to read sensors at a specified interval
 unsigned long lastClockReadTime = millis(); 
@@ -115,7 +128,12 @@ char dateString[2][DATE_LEN];
 char resF0[TEXT_LEN+25];
 char resF1[TEXT_LEN+25];
 char resF2[TEXT_LEN+25];
-char resMenu[TEXT_LEN];
+screenId resScreen = SCREEN_MAIN;   // Screen with the StartLog/StopLog buttons
+
+// Summary pyramids kept alongside the three result files so long sessions can be graphed quickly
+MyResultPyramid resPyramid0;
+MyResultPyramid resPyramid1;
+MyResultPyramid resPyramid2;
 
 // Global alarm flag. Set if alarm condition exists on any enabled alarms
 boolean alarmTripped = false;
@@ -235,6 +253,13 @@ int resArrIdx;
 char  keypadStackArr[TITLE_LEN]; // Keep the keypad results in a simple stack LIFO
 uint8_t keypadStackIdx = 0;  // Stack pointer
 char curStartResumeState[TITLE_LEN];  //Need to keep track of the button label when leaving/returning to a monitor-results screen
+char streamStateS[TITLE_LEN] = {"StreamOff"};  // Send logged samples out the serial port as binary frames (StreamOn/StreamOff)
+char graphModeS[TITLE_LEN] = {"ViewFull"};     // How the graph screen shows results (ViewFull/ViewStrip/ViewOvrly/ViewSplit)
+float stripWindow = 10.0;                      // Minutes of results shown by the strip chart (all result types)
+char  stripWindowS[FLOAT_STRING_WIDTH] = {"10.0"};
+boolean graphZoomed = false;                   // Graph X axis has been zoomed/panned with touch gestures
+float graphZoomMin;
+float graphZoomMax;
 
 
 //##########################
@@ -251,6 +276,14 @@ TFT_eSprite btnTextSprite = TFT_eSprite(&tft);
 // sprite for displaying results text (along the right side of the screen)
 TFT_eSprite textSprite = TFT_eSprite(&tft);
 
+// Pre-rendered digits etc. for drawing the results text quickly
+MyGlyphAtlas textAtlas;
+
+// Images of recently shown screens
+#if USE_SCREEN_CACHE
+MyScreenCache screenCache(&tft);
+#endif
+
 // sprite for displaying status/error messages in a pop-up window
 TFT_eSprite statusSprite = TFT_eSprite(&tft);
 
@@ -260,6 +293,9 @@ TFT_eSprite yAxisSprite = TFT_eSprite(&tft);
 // sprite for displaying the clock string
 TFT_eSprite clockSprite = TFT_eSprite(&tft);
 
+// off-screen framebuffer for the graph plot window (grid + traces)
+TFT_eSprite plotSprite = TFT_eSprite(&tft);
+
 // Current/voltage measuring module
 Adafruit_INA219 ivModule;
 
@@ -279,20 +315,27 @@ RTC_DS1307 RTC;  // rtc object
 
 
 // Create screen objects for each of data logger menus
-// Note: each screen object uses ~8K bytes of memory.  I ran out of memory after creating 13 screens...
-// So, I am now sharing multiple menus on some screens (the ones that were laid out identically but just 
-// had different field values (e.g. IV_SETUP_MENU, TEMP_SETUP_MENU, etc.).  It means you need to save off 
-// and restore the menu fields to the screen object each time you leave/enter a screen.
+// Note: a screen's fixed layout lives in flash and its labels point at the layout or at the app's strings, so
+// a screen is only a few hundred bytes of state.  The IV, temperature and Ain/Din results each get their own
+// setup/axis/monitor/graph screens rather than sharing one set and swapping the fields in and out.
 MyTouchScreen * screenPtrs[MAX_SCREEN_NUM];
-MyTouchScreen mainMenuScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, MAIN_MENU,1);
-MyTouchScreen keypad(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, KEYPAD,1);    // last field is the "title-visible" flag
-MyTouchScreen clockScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, CLOCK_MENU,1);
-MyTouchScreen graphScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, GRAPH,0);
-MyTouchScreen axisScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, AXIS_MENU,1);
-MyTouchScreen screen110v(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, MENU_110V,1);
-MyTouchScreen setupScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, SETUP_MENU,1);
-MyTouchScreen monitorScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, MONITOR_MENU,1);
-MyTouchScreen doutScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, DOUT_MENU,1);
+MyTouchScreen mainMenuScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, MAIN_MENU,1);
+MyTouchScreen keypad(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, KEYPAD,1);    // last field is the "title-visible" flag
+MyTouchScreen clockScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, CLOCK_MENU,1);
+MyTouchScreen screen110v(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, MENU_110V,1);
+MyTouchScreen doutScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, DOUT_MENU,1);
+MyTouchScreen ivSetupScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, SETUP_MENU,1);
+MyTouchScreen ivAxisScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, AXIS_MENU,1);
+MyTouchScreen ivMonitorScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, MONITOR_MENU,1);
+MyTouchScreen ivGraphScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, GRAPH,0);
+MyTouchScreen tempSetupScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, SETUP_MENU,1);
+MyTouchScreen tempAxisScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, AXIS_MENU,1);
+MyTouchScreen tempMonitorScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, MONITOR_MENU,1);
+MyTouchScreen tempGraphScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, GRAPH,0);
+MyTouchScreen adSetupScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, SETUP_MENU,1);
+MyTouchScreen adAxisScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, AXIS_MENU,1);
+MyTouchScreen adMonitorScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, MONITOR_MENU,1);
+MyTouchScreen adGraphScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, GRAPH,0);
 
 // This is the file name used to store the calibration data
 // You can change this to create new calibration files.
@@ -303,6 +346,10 @@ MyTouchScreen doutScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxi
 // Repeat calibration if you change the screen rotation.
 #define REPEAT_CAL false
 
+// Set GLYPH_BENCHMARK to true to print how fast the results text draws with and without the glyph atlas at boot.
+#define GLYPH_BENCHMARK false
+#define GLYPH_BENCHMARK_LOOPS 500
+
 
 //###########################################################################
 //###########################################################################
@@ -405,6 +452,193 @@ boolean checkSwitch(int pin) {
     }
 }
 
+//##################################################################
+// Time drawing a typical result value into the results text sprite
+// with drawString and with the glyph atlas (see GLYPH_BENCHMARK)
+//##################################################################
+void glyphBenchmark() {
+   const char * value = "-123.4";
+   uint32_t glyphs = (uint32_t)strlen(value) * GLYPH_BENCHMARK_LOOPS;
+
+   textSprite.setFreeFont(TEXT_FONT);
+   textSprite.setTextColor(TFT_WHITE, TFT_BLACK);
+   textSprite.setTextDatum(TEXT_DATUM);
+   unsigned long start = micros();
+   for(uint16_t i=0; i<GLYPH_BENCHMARK_LOOPS; i++) {
+      textSprite.setViewport(0, 0, TEXT_SP_WIDTH, TEXT_SP_HEIGHT);
+      textSprite.fillSprite(TFT_BLACK);
+      textSprite.drawString(value, 0, 0, GFXFF);
+      textSprite.resetViewport();
+   }
+   unsigned long fontUs = micros() - start;
+
+   start = micros();
+   for(uint16_t i=0; i<GLYPH_BENCHMARK_LOOPS; i++) {
+      textAtlas.drawString(&textSprite, value, 0, 0, TEXT_SP_WIDTH, TEXT_SP_HEIGHT);
+   }
+   unsigned long atlasUs = micros() - start;
+
+   Serial.print(F("drawString glyphs/sec: "));Serial.println((unsigned long)(glyphs * 1000000.0 / max(fontUs, 1UL)));
+   Serial.print(F("Glyph atlas glyphs/sec: "));Serial.println((unsigned long)(glyphs * 1000000.0 / max(atlasUs, 1UL)));
+}
+
+//##################################################################
+// Touch panel sampling.  tft.getTouch() is a full SPI transaction to the
+// touch controller on the bus shared with the display and SD card, so 
+// only do it when it can tell us something.  With PENIRQ wired up 
+// (TOUCH_IRQ_PIN) the panel is only read while it is being touched, plus 
+// once more after it lets go so the release gets seen.  Either way it is
+// never read more often than every TOUCH_POLL_MS.
+// Returns true if the panel was read (touchPressed/X/Y are then valid).
+//##################################################################
+#if TOUCH_IRQ_PIN >= 0
+void IRAM_ATTR touchIrq() {
+   touchIrqFlag = true;   // Panel gets read on the next pass even if the line is already back high
+}
+#endif
+
+boolean sampleTouch(boolean * touchPressed, uint16_t * touchX, uint16_t * touchY) {
+#if TOUCH_IRQ_PIN >= 0
+   if(!touchWasPressed && !touchIrqFlag && digitalRead(TOUCH_IRQ_PIN) == HIGH) {
+      return false;   // Nobody touching and the last release has already been handled
+   }
+#endif
+   if(millis() - lastTouchPollTime < TOUCH_POLL_MS) {
+      return false;
+   }
+   lastTouchPollTime = millis();
+   *touchPressed = tft.getTouch(touchX, touchY);
+   touchWasPressed = *touchPressed;
+#if TOUCH_IRQ_PIN >= 0
+   // PENIRQ bounces while the controller is converting, so clear it after the read.  A press that 
+   // really is still there holds the line low and is picked up by the digitalRead() above.  A tap
+   // that had already lifted by the time of the read is lost, the same as when polling (the 
+   // interrupt can't read where it was).
+   touchIrqFlag = false;
+#endif
+   return true;
+}
+
+
+//##################################################################
+// Layouts of the fixed screens (see screenLayout in MyTouchScreen.h).
+// The IV/temperature/Ain-Din setup, axis, monitor and graph layouts are in menus.cpp.
+//##################################################################
+// Main menu
+static constexpr screenButton mainMenuButtons[] = {
+   { 5,  "I/V",   drawIvSetupMenu },
+   { 6,  "Temp",  drawTempSetupMenu },
+   { 9,  "A-In/D-In",  drawAdSetupMenu },
+   { 10, "D-Out",      drawDoutMenu },
+   { 13, "Clock", drawClockScreen },
+   { 14, "110v",  draw110vMenu },
+};
+static constexpr screenLayout mainMenuLayout = {
+   mainMenuButtons, LAYOUT_COUNT(mainMenuButtons),
+   NULL, 0,
+   NULL, 0,
+   NULL, 0
+};
+
+// Clock menu
+static constexpr screenButton clockButtons[] = {
+   { 9, curYearS, drawKeypad },
+   { 10, curMonthS, drawKeypad },
+   { 11, curDayS, drawKeypad },
+   { 13, curHourS, drawKeypad },
+   { 14, curMinS, drawKeypad },
+   { 15, curSecS, drawKeypad },
+   { 20, clockAlarmArmedS,toggleClockAlarm },
+   { 21, "SetAlrm", setAlarmTime },
+   { 22, "SetClk",  setClockTime },
+   { 23, "Back", drawMainMenu },
+};
+static constexpr screenText clockText[] = {
+   { 0, "Current Time:", TEXT_LEFT, TEXT_LINE0 },
+   { 1, "Alarm Time:",   TEXT_LEFT, TEXT_LINE1 },
+   { 2, "Y/M/D",    TEXT_LEFT, TEXT_LINE2 },
+   { 3, "H/M/S",    TEXT_LEFT, TEXT_LINE3 },
+};
+static constexpr screenText clockClocks[] = {
+   { 0,dateString[0], CLOCK_SP_X, CLOCK_SP_Y },
+   { 1,dateString[1], CLOCK_SP_X, ALARM_SP_Y },
+};
+static constexpr screenLayout clockLayout = {
+   clockButtons, LAYOUT_COUNT(clockButtons),
+   clockText, LAYOUT_COUNT(clockText),
+   NULL, 0,
+   clockClocks, LAYOUT_COUNT(clockClocks)
+};
+
+// 110v control menu
+static constexpr screenButton menu110vButtons[] = {
+   { 7,  action110vOnAlarmS,      cycle110vActionOnAlarm },
+   { 11, action110vOnClockS,      cycle110vActionOnClock },
+   { 15, manual110vActionS,       manual110vAction },
+   { 23, "Back",                  drawMainMenu },
+};
+static constexpr screenText menu110vText[] = {
+   { 1, "Action On Alarm",        TEXT_LEFT, TEXT_LINE1 },
+   { 2, "Action On Clk-Alarm",    TEXT_LEFT, TEXT_LINE2 },
+   { 3, "Manual On/Off",          TEXT_LEFT, TEXT_LINE3 },
+};
+static constexpr screenLayout menu110vLayout = {
+   menu110vButtons, LAYOUT_COUNT(menu110vButtons),
+   menu110vText, LAYOUT_COUNT(menu110vText),
+   NULL, 0,
+   NULL, 0
+};
+
+// Digital-out menu
+static constexpr screenButton doutButtons[] = {
+   { 3,  doutOutputS,          cycleDoutOutput },
+   { 7,  doutPwmFrequencyS,    cycleDoutPwmFrequency },
+   { 11, doutPwmDutyCycleS,    drawKeypad },
+   { 15, doutPwmFollowsS,      cycleDoutPwmFollows },
+   { 19, doutActionOnAlarmS,   cycleDoutActionOnAlarm },
+   { 23, "Back",               drawMainMenu },
+};
+static constexpr screenText doutText[] = {
+   { 0, "Dout Output",             TEXT_LEFT, TEXT_LINE0 },
+   { 1, "PWM Frequency",           TEXT_LEFT, TEXT_LINE1 },
+   { 2, "PWM Duty Cycle",          TEXT_LEFT, TEXT_LINE2 },
+   { 3, "PWM Duty Cycle Follows",  TEXT_LEFT, TEXT_LINE3 },
+   { 4, "Dout Action On Alarm",    TEXT_LEFT, TEXT_LINE4 },
+};
+static constexpr screenLayout doutLayout = {
+   doutButtons, LAYOUT_COUNT(doutButtons),
+   doutText, LAYOUT_COUNT(doutText),
+   NULL, 0,
+   NULL, 0
+};
+
+// Keypad screen
+static constexpr screenButton keypadButtons[] = {
+   { 4,  "7",      updateKeypad },
+   { 5,  "8",      updateKeypad },
+   { 6,  "9",      updateKeypad },
+   { 7,  "Enter",  updateKeypad },
+   { 8,  "4",      updateKeypad },
+   { 9,  "5",      updateKeypad },
+   { 10, "6",      updateKeypad },
+   { 12, "1",      updateKeypad },
+   { 13, "2",      updateKeypad },
+   { 14, "3",      updateKeypad },
+   { 16, "0",      updateKeypad },
+   { 17, ".",      updateKeypad },
+   { 18, "<--",    updateKeypad },
+   { 19, "Clear",  updateKeypad },
+   { 23, "Cancel", updateKeypad },
+};
+static constexpr screenText keypadText[] = {
+   { 0, keypadStackArr, KEYPAD_RESULT_X, TEXT_LINE0 },
+};
+static constexpr screenLayout keypadLayout = {
+   keypadButtons, LAYOUT_COUNT(keypadButtons),
+   keypadText, LAYOUT_COUNT(keypadText),
+   NULL, 0,
+   NULL, 0
+};
 
 //##################################################################
 //##################################################################
@@ -413,10 +647,18 @@ boolean checkSwitch(int pin) {
 //##################################################################
 void setup() {
 
-   Serial.begin(115200);
+   streamBegin();
    while(!Serial) { }
    delay(1000);
 
+   // More screen objects than the screen state arena has blocks for
+   if(MyTouchScreen::getArenaOverflow()) {
+      Serial.print(MyTouchScreen::getArenaOverflow());
+      Serial.println(F(" screens don't fit the screen arena.  Raise MAX_SCREENS"));
+      while(1) {
+      }
+   }
+
    uint32_t Freq ;
 
    // Display interesting chip info
@@ -447,8 +689,19 @@ void setup() {
    btnTextSprite.createSprite(BUTTON_TEXT_SP_WIDTH,BUTTON_TEXT_SP_HEIGHT);   // Each button text has a small sprite for updating it
    btnTextSprite.setColorDepth(8); // Using color in the buttons so need at least 8-bit color depth
 
-   textSprite.createSprite(TEXT_SP_WIDTH,TEXT_SP_HEIGHT);   // Size is X by Y pixels
+   textSprite.createSprite(TEXT_SP_WIDTH,TEXT_COLUMN_HEIGHT);   // Size is X by Y pixels.  Holds the whole result column.
    textSprite.setColorDepth(1); // Save memory since we are just printing text
+#if USE_SCREEN_CACHE
+   MyTouchScreen::setScreenCache(&screenCache);
+#endif
+   if(textAtlas.begin(TEXT_FONT, GLYPH_ATLAS_CHARS)) {
+      MyTouchScreen::setTextAtlas(&textAtlas);
+      if(GLYPH_BENCHMARK) {
+         glyphBenchmark();
+      }
+   } else {
+      Serial.println(F("Glyph atlas too small.  Results text will use drawString."));
+   }
 
    statusSprite.createSprite(STATUS_WIDTH, STATUS_HEIGHT);  // Used for displaying pop-up messages
    statusSprite.setColorDepth(1); 
@@ -463,6 +716,13 @@ void setup() {
    yAxisSprite.setPivot(0, GRAPH_LABEL_SP_H/2);      // Set pivot around the midpoint/left side of the sprite
    yAxisSprite.fillSprite(TFT_BLACK); // Fill the Sprite with black
 
+   // The graph's plot window is drawn off-screen and pushed in one go (no chopped up lines, no flicker).
+   // A 4-bit palette keeps it around 35K.  If the heap can't spare that, the graph draws straight to the tft.
+   plotSprite.setColorDepth(4);
+   if(plotSprite.createSprite(GRAPH_PLOT_W, GRAPH_PLOT_H) == NULL) {
+      Serial.println(F("Not enough memory for the plot sprite.  Graphs will draw direct to the display"));
+   }
+
    // Calibrate the touch screen and retrieve the scaling factors
    touchCalibrate();
 
@@ -519,6 +779,10 @@ void setup() {
    pinMode(DINPIN, INPUT_PULLUP);
    pinMode(AINPIN, INPUT);
    pinMode(DOUTPIN, OUTPUT);
+#if TOUCH_IRQ_PIN >= 0
+   pinMode(TOUCH_IRQ_PIN, INPUT_PULLUP);
+   attachInterrupt(digitalPinToInterrupt(TOUCH_IRQ_PIN), touchIrq, FALLING);
+#endif
 
    // Initiate the temp libs
    Serial.println(F("Initialize Temp Probe and Module"));
@@ -542,7 +806,6 @@ void setup() {
    tft.drawString("Hobby Hacker Designs",SCREEN_WIDTH/2,SCREEN_HEIGHT/4+95,GFXFF);
    delay(2000);
 
-
    //#############################################################################################################
    // Initialize all the screens and buttons (by button number: 0 at the top left, count across each row)
    // 0 1 2 3
@@ -551,72 +814,39 @@ void setup() {
    //#############################################################################################################
 
    // Set up the screen Pointers array with all the defined screens.  Later we use this to get the 
-   // screen pointer by looping through the array and matching against the screenPtr->getScreenTitle
-   screenPtrs[0] = &mainMenuScreen;
-   screenPtrs[1] = &keypad;
-   screenPtrs[2] = &clockScreen;
-   screenPtrs[3] = &screen110v;
-   screenPtrs[4] = &axisScreen;
-   screenPtrs[5] = &graphScreen;
-   screenPtrs[6] = &setupScreen;
-   screenPtrs[7] = &monitorScreen;
-   screenPtrs[8] = &doutScreen;
+   // screen pointer straight from its screenId (see main.h)
+   screenPtrs[SCREEN_MAIN] = &mainMenuScreen;
+   screenPtrs[SCREEN_KEYPAD] = &keypad;
+   screenPtrs[SCREEN_CLOCK] = &clockScreen;
+   screenPtrs[SCREEN_110V] = &screen110v;
+   screenPtrs[SCREEN_DOUT] = &doutScreen;
+   screenPtrs[SCREEN_IV_SETUP] = &ivSetupScreen;
+   screenPtrs[SCREEN_IV_AXIS] = &ivAxisScreen;
+   screenPtrs[SCREEN_IV_MONITOR] = &ivMonitorScreen;
+   screenPtrs[SCREEN_IV_GRAPH] = &ivGraphScreen;
+   screenPtrs[SCREEN_TEMP_SETUP] = &tempSetupScreen;
+   screenPtrs[SCREEN_TEMP_AXIS] = &tempAxisScreen;
+   screenPtrs[SCREEN_TEMP_MONITOR] = &tempMonitorScreen;
+   screenPtrs[SCREEN_TEMP_GRAPH] = &tempGraphScreen;
+   screenPtrs[SCREEN_AD_SETUP] = &adSetupScreen;
+   screenPtrs[SCREEN_AD_AXIS] = &adAxisScreen;
+   screenPtrs[SCREEN_AD_MONITOR] = &adMonitorScreen;
+   screenPtrs[SCREEN_AD_GRAPH] = &adGraphScreen;
 
    //#########################################################################################
    // Main menu buttons
    //#########################################################################################
-   mainMenuScreen.init(&mainMenuScreen);
-   mainMenuScreen.enableButton(5,  "I/V",   drawIvSetupMenu);
-   mainMenuScreen.enableButton(6,  "Temp",  drawTempSetupMenu);
-   mainMenuScreen.enableButton(9,  "A-In/D-In",  drawAdSetupMenu);
-   mainMenuScreen.enableButton(10, "D-Out",      drawDoutMenu);
-   mainMenuScreen.enableButton(13, "Clock", drawClockScreen);
-   mainMenuScreen.enableButton(14, "110v",  draw110vMenu);
-
-   //####################
-   // Shared graph screen
-   //####################
-   graphScreen.init(&graphScreen);
+   mainMenuScreen.loadLayout(&mainMenuLayout);
 
    //###############
    // Clock menu
    //###############
-   clockScreen.init(&clockScreen);
-   // (button number, button label,  button callback)
-   clockScreen.enableButton(9, curYearS, drawKeypad);
-   clockScreen.enableButton(10, curMonthS, drawKeypad);
-   clockScreen.enableButton(11, curDayS, drawKeypad);
-   clockScreen.enableButton(13, curHourS, drawKeypad);
-   clockScreen.enableButton(14, curMinS, drawKeypad);
-   clockScreen.enableButton(15, curSecS, drawKeypad);
-   clockScreen.enableButton(20, clockAlarmArmedS,toggleClockAlarm);
-   clockScreen.enableButton(21, "SetAlrm", setAlarmTime);
-   clockScreen.enableButton(22, "SetClk",  setClockTime);
-   clockScreen.enableButton(23, "Back", drawMainMenu);
-
-   // (Text field, Text string,  text placement X,Y)
-   clockScreen.enableTextField(0, "Current Time:", TEXT_LEFT, TEXT_LINE0);
-   clockScreen.enableTextField(1, "Alarm Time:",   TEXT_LEFT, TEXT_LINE1);
-   clockScreen.enableTextField(2, "Y/M/D",    TEXT_LEFT, TEXT_LINE2);
-   clockScreen.enableTextField(3, "H/M/S",    TEXT_LEFT, TEXT_LINE3);
-
-   // (Text Sprite field, Text Sprite string,  text placement within sprite X,Y)
-   clockScreen.enableClockSprite(0,dateString[0], CLOCK_SP_X, CLOCK_SP_Y);
-   clockScreen.enableClockSprite(1,dateString[1], CLOCK_SP_X, ALARM_SP_Y);
+   clockScreen.loadLayout(&clockLayout);
 
    //####################
    // 110v control menu
    //####################
-   screen110v.init(&screen110v);
-   // (button number, button label,  button callback)
-   screen110v.enableButton(7,  action110vOnAlarmS,      cycle110vActionOnAlarm);
-   screen110v.enableButton(11, action110vOnClockS,      cycle110vActionOnClock);
-   screen110v.enableButton(15, manual110vActionS,       manual110vAction);
-   screen110v.enableButton(23, "Back",                  drawMainMenu);
-
-   screen110v.enableTextField(1, "Action On Alarm",        TEXT_LEFT, TEXT_LINE1);
-   screen110v.enableTextField(2, "Action On Clk-Alarm",    TEXT_LEFT, TEXT_LINE2);
-   screen110v.enableTextField(3, "Manual On/Off",          TEXT_LEFT, TEXT_LINE3);
+   screen110v.loadLayout(&menu110vLayout);
 
    //#########################################################################################
    // Current/Voltage menus
@@ -662,55 +892,34 @@ void setup() {
    dtostrf(ainVoltage,3,1,ainVoltageS);
    dtostrf(timeMonitored,3,1,timeMonitoredS);
 
+   // Setup/axis/monitor/graph screens of the IV, temperature and Ain/Din results
+   initResultScreens();
 
    //#########################################################################################
    // Digital-out menu
    //#########################################################################################
 
    dtostrf(doutPwmDutyCycle,3,1,doutPwmDutyCycleS);
-   doutScreen.init(&doutScreen);
-
-   // (button number, button label,  button callback)
-   doutScreen.enableButton(3,  doutOutputS,          cycleDoutOutput);
-   doutScreen.enableButton(7,  doutPwmFrequencyS,    cycleDoutPwmFrequency);
-   doutScreen.enableButton(11, doutPwmDutyCycleS,    drawKeypad);
-   doutScreen.enableButton(15, doutPwmFollowsS,      cycleDoutPwmFollows);
-   doutScreen.enableButton(19, doutActionOnAlarmS,   cycleDoutActionOnAlarm);
-   doutScreen.enableButton(23, "Back",               drawMainMenu);
-
-   doutScreen.enableTextField(0, "Dout Output",             TEXT_LEFT, TEXT_LINE0);
-   doutScreen.enableTextField(1, "PWM Frequency",           TEXT_LEFT, TEXT_LINE1);
-   doutScreen.enableTextField(2, "PWM Duty Cycle",          TEXT_LEFT, TEXT_LINE2);
-   doutScreen.enableTextField(3, "PWM Duty Cycle Follows",  TEXT_LEFT, TEXT_LINE3);
-   doutScreen.enableTextField(4, "Dout Action On Alarm",    TEXT_LEFT, TEXT_LINE4);
-
 
+   doutScreen.loadLayout(&doutLayout);
 
    //#########################################################################################
    // Keypad Screen - Used for entering numbers for the options buttons
    //#########################################################################################
    // Initialize the strings used in the keypad screen
    strcpy(keypadStackArr,"");
-   keypad.init(&keypad);
-
-   // (button number, button label,  button callback)
-   keypad.enableButton(4,  "7",      updateKeypad);
-   keypad.enableButton(5,  "8",      updateKeypad);
-   keypad.enableButton(6,  "9",      updateKeypad);
-   keypad.enableButton(7,  "Enter",  updateKeypad);
-   keypad.enableButton(8,  "4",      updateKeypad);
-   keypad.enableButton(9,  "5",      updateKeypad);
-   keypad.enableButton(10, "6",      updateKeypad);
-   keypad.enableButton(12, "1",      updateKeypad);
-   keypad.enableButton(13, "2",      updateKeypad);
-   keypad.enableButton(14, "3",      updateKeypad);
-   keypad.enableButton(16, "0",      updateKeypad);
-   keypad.enableButton(17, ".",      updateKeypad);
-   keypad.enableButton(18, "<--",    updateKeypad);
-   keypad.enableButton(19, "Clear",  updateKeypad);
-   keypad.enableButton(23, "Cancel", updateKeypad);
-
-   keypad.enableTextField(0, keypadStackArr, KEYPAD_RESULT_X, TEXT_LINE0);
+
+   keypad.loadLayout(&keypadLayout);
+
+   // Memory used by the screens
+   Serial.print(NUM_SCREENS);Serial.print(F(" screens of "));Serial.print(MyTouchScreen::getMemoryUsed());Serial.println(F(" bytes"));
+   Serial.print(F("Screen arena bytes used: "));Serial.print(MyTouchScreen::getArenaUsed());
+   Serial.print(F(" of "));Serial.println(MyTouchScreen::getArenaSize());
+   Serial.print(F("Glyph atlas bytes used: "));Serial.print(textAtlas.getMemoryUsed());
+   Serial.print(F(" of "));Serial.println(GLYPH_ATLAS_BYTES);
+#if USE_SCREEN_CACHE
+   Serial.print(F("Screen cache bytes: "));Serial.println(SCREEN_CACHE_BYTES);
+#endif
 
    Serial.print(F("Free Heap Memory Left: "));Serial.println(esp_get_free_heap_size());
    drawMainMenu(0);
@@ -746,14 +955,14 @@ void loop() {
       now = RTC.now();
       strcpy(dateStringFormat, "YYYY-MM-DD hh:mm:ss");
       strcpy(dateString[0],now.toString(dateStringFormat));
-      if(!strcmp(curScreenPtr->getScreenTitle(), CLOCK_MENU)) {
+      if(curScreenPtr == getScreenPtr(SCREEN_CLOCK)) {
          updateClock();
       }
       lastClockReadTime = millis();
    }
 
    // Periodically check the current/voltage sensors
-   unsigned long measureIvInterval = atof(getScreenPtr(SETUP_MENU)->getButtonLabel(19))*60*1000;  //button-19 is monitor-interval 
+   unsigned long measureIvInterval = atof(getScreenPtr(SCREEN_IV_SETUP)->getButtonLabel(SETUP_INTERVAL_BTN))*60*1000;  //button-19 is monitor-interval 
    if(millis() - lastIvReadTime >= measureIvInterval) {
       float shuntVoltage = 0.0;
       float busVoltage = 0.0;
@@ -768,9 +977,9 @@ void loop() {
       lastIvReadTime = millis();
    }
    // Periodically check the Analog-in voltage
-   unsigned long measureAdInterval = atof(getScreenPtr(SETUP_MENU)->getButtonLabel(19))*60*1000;  //button-19 is monitor-interval 
-   //float ainRangeSelect = atof(getScreenPtr(SETUP_MENU)->getButtonLabel(11));
-   //float ainRangeSelect = atof(getScreenPtr(SETUP_MENU)->getButtonLabel(11));
+   unsigned long measureAdInterval = atof(getScreenPtr(SCREEN_AD_SETUP)->getButtonLabel(SETUP_INTERVAL_BTN))*60*1000;  //button-19 is monitor-interval 
+   //float ainRangeSelect = atof(getScreenPtr(SCREEN_AD_SETUP)->getButtonLabel(SETUP_LIMIT1_BTN));
+   //float ainRangeSelect = atof(getScreenPtr(SCREEN_AD_SETUP)->getButtonLabel(SETUP_LIMIT1_BTN));
    if(millis() - lastAdReadTime >= measureAdInterval) {
 
       // ESP32 uses 12bit adc so 0-4095 counts
@@ -789,7 +998,7 @@ void loop() {
 
    // Periodically check the temperature and humidity from the probe and module
    // Note:  The sensor needs at least 750ms between samples.
-   unsigned long measureTempInterval = atof(getScreenPtr(SETUP_MENU)->getButtonLabel(19))*60*1000;  //button-19 is monitor-interval 
+   unsigned long measureTempInterval = atof(getScreenPtr(SCREEN_TEMP_SETUP)->getButtonLabel(SETUP_INTERVAL_BTN))*60*1000;  //button-19 is monitor-interval 
    if(measureTempInterval < 750) { measureTempInterval = 750; }
    if(millis() - lastTempReadTime >= measureTempInterval) { 
       curProbeTemp = tempSensor.getTempFByIndex(0);
@@ -805,142 +1014,173 @@ void loop() {
    // Check the touch panel.  See if a button was pushed.
    uint16_t touchX=0, touchY=0;
 
-   // Will be true if there is a valid touch on the screen
-   bool touchPressed = tft.getTouch(&touchX,&touchY);
-
-   // Loop through all the buttons (for the currently displayed menu) to see 
-   // if the touch coord is over one.  If so, execute that button's callback
-   for(uint8_t bIndex=0; bIndex < NUM_BUTTONS; bIndex++) {
-      if(curScreenPtr->isButtonVisible(bIndex)) {    // Only check buttons that are visible
-         if(touchPressed && curScreenPtr->isPressCoordOverButton(bIndex,touchX,touchY)) {
-            curScreenPtr->setButtonPressed(bIndex, true);
-         } else {
-            curScreenPtr->setButtonPressed(bIndex, false);
-         }
+   // touchPressed will be true if there is a valid touch on the screen
+   boolean touchPressed = false;
+   if(sampleTouch(&touchPressed, &touchX, &touchY)) {
+      // The graph screen's plot and X axis take zoom/pan gestures
+      if(isGraphScreen(curScreenPtr)) {
+         graphTouch(touchPressed, touchX, touchY);
       }
-   }
-   for(uint8_t bIndex=0; bIndex < NUM_BUTTONS; bIndex++) {
-      if(curScreenPtr->isButtonVisible(bIndex)) {    // Only check buttons that are visible
-         if(curScreenPtr->wasButtonJustReleased(bIndex)) {
-            curScreenPtr->drawButton(bIndex, false);          // Back to normal to show it was released
 
-            // Need to redraw the text as we stored a blank "" in the button object itself (we are adding our own labels over the top of the buttons)
-            curScreenPtr->drawButtonTextSprite();
+      // Only the button under the touch and the one that was under it last time around can change state,
+      // so look the touched one up from the button grid and just update those two (nothing at all when
+      // the screen isn't being touched).  If so, execute that button's callback
+      int8_t touchedButton = touchPressed ? curScreenPtr->buttonAt(touchX, touchY) : -1;
+      if(curScreenPtr != touchScreenPtr) {
+         // A callback changed screens while its button was held.  Forget that press, and ignore the touch
+         // until it lifts so it doesn't also press the button in the same spot on the new screen.
+         if(lastTouchedButton >= 0) {
+            touchScreenPtr->clearButtonPress(lastTouchedButton);
+            touchHeldOverScreenChange = touchPressed;
          }
-         if(curScreenPtr->wasButtonJustPressed(bIndex)) {
-            curScreenPtr->drawButton(bIndex, true);          // Hilite button to show it was pressed
-
-            // Execute the callback for the button that was pressed 
-            curButtonPressed = bIndex;
-            curScreenPtr->executeButtonCallBack(bIndex);
-            break;
+         lastTouchedButton = -1;
+         touchScreenPtr = curScreenPtr;
+      }
+      if(touchHeldOverScreenChange) {
+         touchHeldOverScreenChange = touchPressed;
+         touchedButton = -1;
+      }
+      int8_t activeButtons[2] = { lastTouchedButton, touchedButton };
+      if(touchedButton == lastTouchedButton) {
+         activeButtons[0] = -1;
+      } else {
+         toastSuspend();    // A button is about to be redrawn, maybe under a toast
+      }
+      lastTouchedButton = touchedButton;
+      for(uint8_t i=0; i < 2; i++) {
+         if(activeButtons[i] >= 0) {
+            curScreenPtr->setButtonPressed(activeButtons[i], activeButtons[i] == touchedButton);
          }
       }
+      for(uint8_t i=0; i < 2; i++) {
+         if(activeButtons[i] >= 0) {
+            uint8_t bIndex = activeButtons[i];
+            if(curScreenPtr->wasButtonJustReleased(bIndex)) {
+               curScreenPtr->drawButton(bIndex, false);          // Back to normal to show it was released
+
+               // Need to redraw the text as we stored a blank "" in the button object itself (we are adding our own labels over the top of the buttons)
+               renderRequest(RENDER_BUTTONS);
+            }
+            if(curScreenPtr->wasButtonJustPressed(bIndex)) {
+               curScreenPtr->drawButton(bIndex, true);          // Hilite button to show it was pressed
+
+               // Execute the callback for the button that was pressed 
+               curButtonPressed = bIndex;
+               curScreenPtr->executeButtonCallBack(bIndex);
+               break;
+            }
+         }
+      }
+      toastResume();
    }
 
    // See if the Dout PWM duty-cycle needs updating (i.e. user changed the % in the Dout setup menu)
    if((!clockAlarmTripped && !alarmTripped) && 
-      (!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(3), "PWM") || !strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(3), "PWM-Inv"))) {   
+      (!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_OUTPUT_BTN), "PWM") || !strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_OUTPUT_BTN), "PWM-Inv"))) {   
          updateDoutPwmDutyCycle();
    } else {
-      if(!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(3), "Low")) {   //button-19 is "Dout Action On Alarm" button
+      if(!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_OUTPUT_BTN), "Low")) {   //button-19 is "Dout Action On Alarm" button
          ledcDetachPin(DOUTPIN);  
          digitalWrite(DOUTPIN, 0);
-      } else if (!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(3), "High")) {
+      } else if (!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_OUTPUT_BTN), "High")) {
          ledcDetachPin(DOUTPIN);  
          digitalWrite(DOUTPIN, 1);
       }
    }
 
    // Update any results that we're monitoring
-   updateResults(MONITOR_MENU, GRAPH, "AD", SETUP_MENU, resF0, resF1, resF2, &dinCount, &ainVoltage, &ainVoltage, &drawAdResults);
-   updateResults(MONITOR_MENU, GRAPH, "IV", SETUP_MENU, resF0, resF1, resF2, &current_mA, &loadVoltage, &power_mW, &drawIvResults);
-   updateResults(MONITOR_MENU, GRAPH, "TEMP", SETUP_MENU, resF0, resF1, resF2, &curProbeTemp, &curModuleTemp, &curModuleHumidity, &drawTempResults);
+   updateResults(SCREEN_AD_MONITOR, SCREEN_AD_GRAPH, "AD", SCREEN_AD_SETUP, resF0, resF1, resF2, &dinCount, &ainVoltage, &ainVoltage, &drawAdResults);
+   updateResults(SCREEN_IV_MONITOR, SCREEN_IV_GRAPH, "IV", SCREEN_IV_SETUP, resF0, resF1, resF2, &current_mA, &loadVoltage, &power_mW, &drawIvResults);
+   updateResults(SCREEN_TEMP_MONITOR, SCREEN_TEMP_GRAPH, "TEMP", SCREEN_TEMP_SETUP, resF0, resF1, resF2, &curProbeTemp, &curModuleTemp, &curModuleHumidity, &drawTempResults);
 
 
    // Check if alarms are being monitored.  If so, see if any alarm conditions exist
    // Alarms are triggered if a monitored input alarm is enabled and it exceeds a user defined value.
-   if(!strcmp(curScreenPtr->getScreenType(), "AD") && !strcmp(getScreenPtr(SETUP_MENU)->getButtonLabel(3), "Enabled")) {   //button-3 is Alarm Enable/Disable 
-      if(dinCount > atof(getScreenPtr(SETUP_MENU)->getButtonLabel(7))) {
+   if(!strcmp(curScreenPtr->getScreenType(), "AD") && !strcmp(getScreenPtr(SCREEN_AD_SETUP)->getButtonLabel(SETUP_ALARM_BTN), "Enabled")) {   //button-3 is Alarm Enable/Disable 
+      if(dinCount > atof(getScreenPtr(SCREEN_AD_SETUP)->getButtonLabel(SETUP_LIMIT0_BTN))) {
          alarmTripped = true;
-      } else if(ainVoltage > atof(getScreenPtr(SETUP_MENU)->getButtonLabel(11))) { //Maximum analog in level
+      } else if(ainVoltage > atof(getScreenPtr(SCREEN_AD_SETUP)->getButtonLabel(SETUP_LIMIT1_BTN))) { //Maximum analog in level
          alarmTripped = true;
       } else {
          alarmTripped = false;
       }
    }
-   if(!strcmp(curScreenPtr->getScreenType(), "IV") && !strcmp(getScreenPtr(SETUP_MENU)->getButtonLabel(3), "Enabled")) {   //button-3 is Alarm Enable/Disable 
-      if(current_mA > atof(getScreenPtr(SETUP_MENU)->getButtonLabel(7))) {  //Max Current Limit
+   if(!strcmp(curScreenPtr->getScreenType(), "IV") && !strcmp(getScreenPtr(SCREEN_IV_SETUP)->getButtonLabel(SETUP_ALARM_BTN), "Enabled")) {   //button-3 is Alarm Enable/Disable 
+      if(current_mA > atof(getScreenPtr(SCREEN_IV_SETUP)->getButtonLabel(SETUP_LIMIT0_BTN))) {  //Max Current Limit
          alarmTripped = true;
-      } else if(loadVoltage > atof(getScreenPtr(SETUP_MENU)->getButtonLabel(11))) {  //Max Voltage Limit
+      } else if(loadVoltage > atof(getScreenPtr(SCREEN_IV_SETUP)->getButtonLabel(SETUP_LIMIT1_BTN))) {  //Max Voltage Limit
          alarmTripped = true;
       } else {
          alarmTripped = false;
       }
    }
-   if(!strcmp(curScreenPtr->getScreenType(), "TEMP") && !strcmp(getScreenPtr(SETUP_MENU)->getButtonLabel(3), "Enabled")) {   //button-3 is Alarm Enable/Disable 
-      if(curModuleTemp > atof(getScreenPtr(SETUP_MENU)->getButtonLabel(7)) ||
-         curProbeTemp > atof(getScreenPtr(SETUP_MENU)->getButtonLabel(7))) {  //Max Temperature Limit
+   if(!strcmp(curScreenPtr->getScreenType(), "TEMP") && !strcmp(getScreenPtr(SCREEN_TEMP_SETUP)->getButtonLabel(SETUP_ALARM_BTN), "Enabled")) {   //button-3 is Alarm Enable/Disable 
+      if(curModuleTemp > atof(getScreenPtr(SCREEN_TEMP_SETUP)->getButtonLabel(SETUP_LIMIT0_BTN)) ||
+         curProbeTemp > atof(getScreenPtr(SCREEN_TEMP_SETUP)->getButtonLabel(SETUP_LIMIT0_BTN))) {  //Max Temperature Limit
          alarmTripped = true;
-      } else if(curModuleHumidity > atof(getScreenPtr(SETUP_MENU)->getButtonLabel(11))) {  //Max Humidity Limit
+      } else if(curModuleHumidity > atof(getScreenPtr(SCREEN_TEMP_SETUP)->getButtonLabel(SETUP_LIMIT1_BTN))) {  //Max Humidity Limit
          alarmTripped = true;
       } else {
          alarmTripped = false;
       }
    }
-   if(!clockAlarmTripped && !strcmp(getScreenPtr(CLOCK_MENU)->getButtonLabel(20), "AlarmOn")) {   //clock menu ->button-20 is alarm enable/disable button
+   if(!clockAlarmTripped && !strcmp(getScreenPtr(SCREEN_CLOCK)->getButtonLabel(CLOCK_ALARM_BTN), "AlarmOn")) {   //clock menu ->button-20 is alarm enable/disable button
       if(!strcmp(dateString[0], dateString[1])) {
          clockAlarmTripped = true;
       }
    }
    // Turn the general alarm off only if the clock alarm was on and just got turned off
-   if(clockAlarmTripped && !strcmp(getScreenPtr(CLOCK_MENU)->getButtonLabel(20), "AlarmOff")) {
+   if(clockAlarmTripped && !strcmp(getScreenPtr(SCREEN_CLOCK)->getButtonLabel(CLOCK_ALARM_BTN), "AlarmOff")) {
       clockAlarmTripped = false;
    }
 
    // The external 110v power controller can be turned on via alarm triggers.  Check if any triggers exist or
    // have been cleared and turn on/off the 110v power box accordingly.
-   if(alarmTripped && !strcmp(getScreenPtr(MENU_110V)->getButtonLabel(7), "Turn On")) {   //button-7 is "Action On Alarm" button
+   if(alarmTripped && !strcmp(getScreenPtr(SCREEN_110V)->getButtonLabel(V110_ON_ALARM_BTN), "Turn On")) {   //button-7 is "Action On Alarm" button
       digitalWrite(EXT_POWER_RELAY, HIGH);
    }
-   if(alarmTripped && !strcmp(getScreenPtr(MENU_110V)->getButtonLabel(7), "Turn Off")) {   //button-7 is "Action On Alarm" button
+   if(alarmTripped && !strcmp(getScreenPtr(SCREEN_110V)->getButtonLabel(V110_ON_ALARM_BTN), "Turn Off")) {   //button-7 is "Action On Alarm" button
       digitalWrite(EXT_POWER_RELAY, LOW);
    }
-   if(clockAlarmTripped && !strcmp(getScreenPtr(MENU_110V)->getButtonLabel(11), "Turn On")) {   //button-11 is "Action On Clk-Alarm" button
+   if(clockAlarmTripped && !strcmp(getScreenPtr(SCREEN_110V)->getButtonLabel(V110_ON_CLOCK_BTN), "Turn On")) {   //button-11 is "Action On Clk-Alarm" button
       digitalWrite(EXT_POWER_RELAY, HIGH);
    }
-   if(clockAlarmTripped && !strcmp(getScreenPtr(MENU_110V)->getButtonLabel(11), "Turn Off")) {   //button-11 is "Action On Clk-Alarm" button
+   if(clockAlarmTripped && !strcmp(getScreenPtr(SCREEN_110V)->getButtonLabel(V110_ON_CLOCK_BTN), "Turn Off")) {   //button-11 is "Action On Clk-Alarm" button
       digitalWrite(EXT_POWER_RELAY, LOW);
    }
 
    // Reset the 110v box to the manual-control value once the alarm condition has passed
-   if(!clockAlarmTripped && !alarmTripped && !strcmp(getScreenPtr(MENU_110V)->getButtonLabel(15), "Off")) {   //button-15 is manual On/Off button
+   if(!clockAlarmTripped && !alarmTripped && !strcmp(getScreenPtr(SCREEN_110V)->getButtonLabel(V110_MANUAL_BTN), "Off")) {   //button-15 is manual On/Off button
       digitalWrite(EXT_POWER_RELAY, LOW);
    }
-   if(!clockAlarmTripped && !alarmTripped && !strcmp(getScreenPtr(MENU_110V)->getButtonLabel(15), "On")) {   //button-15 is manual On/Off button
+   if(!clockAlarmTripped && !alarmTripped && !strcmp(getScreenPtr(SCREEN_110V)->getButtonLabel(V110_MANUAL_BTN), "On")) {   //button-15 is manual On/Off button
       digitalWrite(EXT_POWER_RELAY, HIGH);
    }
 
 
    //  Dout can be triggered/changed by an alarm if enabled
-   if((clockAlarmTripped || alarmTripped) && (strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(19), "None") != 0)) {
-      if(!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(19), "Low")) {   //button-19 is "Dout Action On Alarm" button
+   if((clockAlarmTripped || alarmTripped) && (strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_ON_ALARM_BTN), "None") != 0)) {
+      if(!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_ON_ALARM_BTN), "Low")) {   //button-19 is "Dout Action On Alarm" button
          ledcDetachPin(DOUTPIN);  
          digitalWrite(DOUTPIN, 0);
-      } else if (!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(19), "High")) {
+      } else if (!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_ON_ALARM_BTN), "High")) {
          ledcDetachPin(DOUTPIN);  
          digitalWrite(DOUTPIN, 1);
-      } else if (!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(19), "PWM")) {
+      } else if (!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_ON_ALARM_BTN), "PWM")) {
          ledcAttachPin(DOUTPIN, pwmChannel);  
          ledcSetup(pwmChannel, pwmFrequency, pwmResolution); 
-         doutPwmDutyCycle = atoi(getScreenPtr(DOUT_MENU)->getButtonLabel(11));
+         doutPwmDutyCycle = atoi(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_DUTY_CYCLE_BTN));
          ledcWrite(pwmChannel, constrain(map(doutPwmDutyCycle,0,100,0,1023),0,1023));  // 10-bit pwm gives 0-1023 range for pwm
-      } else if (!strcmp(getScreenPtr(DOUT_MENU)->getButtonLabel(19), "PWM-Inv")) {
+      } else if (!strcmp(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_ON_ALARM_BTN), "PWM-Inv")) {
          ledcAttachPin(DOUTPIN, pwmChannel);  
          ledcSetup(pwmChannel, pwmFrequency, pwmResolution); 
-         doutPwmDutyCycle = atoi(getScreenPtr(DOUT_MENU)->getButtonLabel(11));
+         doutPwmDutyCycle = atoi(getScreenPtr(SCREEN_DOUT)->getButtonLabel(DOUT_DUTY_CYCLE_BTN));
          ledcWrite(pwmChannel, constrain(map(doutPwmDutyCycle,100,0,0,1023),0,1023));  // 10-bit pwm gives 0-1023 range for pwm
       }
    }
+
+   // Draw any display updates that were asked for during this pass of the loop
+   toastService();
+   renderFrame();
 }
 
@@ -0,0 +1,109 @@
+
+#include <render.h>
+
+//#################################################################################################
+// Display refresh scheduler (see render.h).
+// Requests are just bits in renderPending.  They belong to the screen that was up when they were
+// made; if the screen changes before the frame, drawScreen() has already repainted everything so
+// the pending bits are dropped.
+//#################################################################################################
+
+uint8_t renderPending = 0;                  // RENDER_* bits waiting for the next frame
+MyTouchScreen * renderScreenPtr = NULL;     // Screen the pending bits were requested for
+unsigned long renderLastDrawn[3] = {0,0,0}; // millis() each kind was last drawn (buttons/clock/text)
+const unsigned long renderInterval[3] = {RENDER_BUTTONS_INTERVAL_MS, RENDER_CLOCK_INTERVAL_MS, RENDER_TEXT_INTERVAL_MS};
+
+// Frame time statistics (in microseconds) since they were last printed
+uint32_t renderFrames = 0;
+uint32_t renderOverruns = 0;      // Frames that went over RENDER_FRAME_BUDGET_US
+uint32_t renderTotalUs = 0;
+uint32_t renderMaxUs = 0;
+unsigned long renderStatsTime = 0;
+
+// Index into renderLastDrawn/renderInterval for a single RENDER_* bit
+static uint8_t renderSlot(uint8_t what) {
+   if(what == RENDER_BUTTONS) {
+      return(0);
+   } else if(what == RENDER_CLOCK) {
+      return(1);
+   }
+   return(2);
+}
+
+// Ask for something to be redrawn at the next frame
+void renderRequest(uint8_t what) {
+   if(curScreenPtr != renderScreenPtr) {
+      renderPending = 0;
+      renderScreenPtr = curScreenPtr;
+   }
+   renderPending |= what;
+}
+
+// True if enough time has passed since the given kind was last drawn that it would be drawn again.
+// Lets the result code skip formatting values that wouldn't make it to the display.
+boolean renderDue(uint8_t what) {
+   uint8_t slot = renderSlot(what);
+   return(millis() - renderLastDrawn[slot] >= renderInterval[slot]);
+}
+
+// Draw whatever is pending and due.  Called once at the end of every pass of the main loop.
+// Nothing is drawn while a toast is up (it would draw over it); it stays pending until it goes.
+void renderFrame() {
+   if(curScreenPtr != renderScreenPtr) {
+      renderPending = 0;
+      renderScreenPtr = curScreenPtr;
+   }
+
+   if(renderPending && !toastVisible()) {
+      unsigned long start = micros();
+      boolean drew = false;
+      for(uint8_t what=RENDER_BUTTONS; what<=RENDER_TEXT; what<<=1) {
+         if(!(renderPending & what) || !renderDue(what)) {
+            continue;
+         }
+         // Out of time for this frame.  Leave the rest for the next one.
+         if(drew && micros() - start >= RENDER_FRAME_BUDGET_US) {
+            break;
+         }
+         switch(what) {
+            case RENDER_BUTTONS: curScreenPtr->drawButtonTextSprite(); break;
+            case RENDER_CLOCK:   curScreenPtr->drawClockSprite(); break;
+            case RENDER_TEXT:    curScreenPtr->drawTextSprite(); break;
+         }
+         renderPending &= ~what;
+         renderLastDrawn[renderSlot(what)] = millis();
+         drew = true;
+      }
+
+      if(drew) {
+         uint32_t frameUs = micros() - start;
+         renderFrames++;
+         renderTotalUs += frameUs;
+         if(frameUs > renderMaxUs) {
+            renderMaxUs = frameUs;
+         }
+         if(frameUs > RENDER_FRAME_BUDGET_US) {
+            renderOverruns++;
+         }
+      }
+   }
+
+   if(RENDER_STATS_INTERVAL_MS && millis() - renderStatsTime >= RENDER_STATS_INTERVAL_MS) {
+      if(strcmp(streamStateS, "StreamOn")) {
+         renderPrintStats();
+      }
+      renderFrames = 0;
+      renderOverruns = 0;
+      renderTotalUs = 0;
+      renderMaxUs = 0;
+      renderStatsTime = millis();
+   }
+}
+
+// Print the frame time statistics gathered since they were last reset
+void renderPrintStats() {
+   Serial.print(F("Frames: "));Serial.print(renderFrames);
+   Serial.print(F("  Avg us: "));Serial.print(renderFrames ? renderTotalUs/renderFrames : 0UL);
+   Serial.print(F("  Max us: "));Serial.print(renderMaxUs);
+   Serial.print(F("  Over budget: "));Serial.println(renderOverruns);
+}
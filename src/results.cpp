@@ -6,12 +6,15 @@
 // NOTE:  This assumes we use the same buttons in all the setup screens (i.e. 19 is the monitor-interval, etc.)
 //        We can change this if we start changing layouts by passing the button numbers in the parameter list
 //##############################################################################################################
-void updateResults(const char * resultMenu, const char * graphMenu, const char * resType, const char * setupMenu, 
+void updateResults(screenId resultMenu, screenId graphMenu, const char * resType, screenId setupMenu, 
                    const char * res0File,   const char * res1File,  const char * res2File,
                    float * res0ptr, float * res1ptr, float * res2ptr, void (*funcPtr)()) {
 
-   if(!strcmp(curScreenPtr->getScreenType(), resType) && (!strcmp(curScreenPtr->getScreenTitle(), resultMenu) || !strcmp(curScreenPtr->getScreenTitle(), graphMenu))) {
-       (*funcPtr)();  // Read the sensor results and update the text sprite fields
+   if(!strcmp(curScreenPtr->getScreenType(), resType) && (curScreenPtr == getScreenPtr(resultMenu) || curScreenPtr == getScreenPtr(graphMenu))) {
+      // Only format the results when the text fields are due for a redraw anyway
+      if(renderDue(RENDER_TEXT)) {
+         (*funcPtr)();  // Read the sensor results and update the text sprite fields
+      }
 
       // Need to store the current measured results and draw the monitored results on the graph if graphing
       if(monitoringResults) {
@@ -32,7 +35,7 @@ void updateResults(const char * resultMenu, const char * graphMenu, const char *
          }
          // Only log to the array in time increments set by the "Monitor Interval" (Button (19) in the setup menu)
          curMonitorTime = (millis() - lastResultsLoggedTime)/1000.0/60.0;
-         if(curMonitorTime >= atof(getScreenPtr(setupMenu)->getButtonLabel(19))){
+         if(curMonitorTime >= atof(getScreenPtr(setupMenu)->getButtonLabel(SETUP_INTERVAL_BTN))){
             monitoredResultsXAxis0[resArrIdx] = timeMonitored; 
             monitoredResultsXAxis1[resArrIdx] = timeMonitored; 
             monitoredResultsXAxis2[resArrIdx] = timeMonitored; 
@@ -43,19 +46,24 @@ void updateResults(const char * resultMenu, const char * graphMenu, const char *
 
             lastResultsLoggedTime = millis();
 
+            // Send the sample out the serial port too if streaming is turned on
+            if(!strcmp(streamStateS, "StreamOn")) {
+               streamResults(resType, *res0ptr, *res1ptr, *res2ptr);
+            }
+
             // Displaying the graph so go plot the latest data
-            if(!strcmp(curScreenPtr->getScreenTitle(), graphMenu)) {
+            if(curScreenPtr == getScreenPtr(graphMenu)) {
                if(!strcmp(currentlyGraphing,res0File)) {
                   curScreenPtr->addGraphData(resArrIdx, monitoredResultsXAxis0, monitoredResultsYAxis0);
                } else if(!strcmp(currentlyGraphing,res1File)) {
                   curScreenPtr->addGraphData(resArrIdx, monitoredResultsXAxis1, monitoredResultsYAxis1);
                } else if(!strcmp(currentlyGraphing,res2File)) {
                   curScreenPtr->addGraphData(resArrIdx, monitoredResultsXAxis2, monitoredResultsYAxis2);
+               } else if(!strcmp(currentlyGraphing,GRAPH_OVERLAY)) {
+                  curScreenPtr->addGraphData(resArrIdx, monitoredResultsXAxis0, monitoredResultsYAxis0, 0);
+                  curScreenPtr->addGraphData(resArrIdx, monitoredResultsXAxis1, monitoredResultsYAxis1, 1);
+                  curScreenPtr->addGraphData(resArrIdx, monitoredResultsXAxis2, monitoredResultsYAxis2, 2);
                }
-               // Need to delay after drawing the updates before trying to update again else the graph lines get chopped up.
-               // Looks like a minimum time requrement for drawing.  More investigation needed...
-               delay(10);
-
             } 
             resArrIdx++;
          }
@@ -65,14 +73,14 @@ void updateResults(const char * resultMenu, const char * graphMenu, const char *
          if(resArrIdx == MAX_RESULT_POINTS ) { 
 
            // NOTE:  Be sure to include "/" in front of the file name (starts at root directory) or the file opening will fail...
-            writeResultsToFile(0,res0File,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0);
-            writeResultsToFile(0,res1File,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1);
-            writeResultsToFile(0,res2File,resArrIdx,monitoredResultsXAxis2,monitoredResultsYAxis2);
+            writeResultsToFile(0,res0File,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0,&resPyramid0);
+            writeResultsToFile(0,res1File,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1,&resPyramid1);
+            writeResultsToFile(0,res2File,resArrIdx,monitoredResultsXAxis2,monitoredResultsYAxis2,&resPyramid2);
             resArrIdx = 1;  // Reset to "1" not "0" as writeResultsToFile(0) moves the upper result back to entry 0
             resultArraysFilled = true;
          }
          // setup-menu button-15 is monitor duration.
-         if(timeMonitored > atof(getScreenPtr(setupMenu)->getButtonLabel(15))) { 
+         if(timeMonitored > atof(getScreenPtr(setupMenu)->getButtonLabel(SETUP_DURATION_BTN))) { 
             monitorResults(22);   // Virtually "press" the "Stop" monitoring button (button-22)
          }
       }
@@ -94,7 +102,7 @@ void drawAdResults() {
    curScreenPtr->updateTextSprite(2,ainVoltageS);
    curScreenPtr->updateTextSprite(3,timeMonitoredS);
 
-   curScreenPtr->drawTextSprite();  // Update the text result fields
+   renderRequest(RENDER_TEXT);  // Update the text result fields at the next frame
 }
 
 
@@ -113,7 +121,7 @@ void drawIvResults() {
    curScreenPtr->updateTextSprite(2,power_mWS);
    curScreenPtr->updateTextSprite(3,timeMonitoredS);
 
-   curScreenPtr->drawTextSprite();  // Update the text result fields
+   renderRequest(RENDER_TEXT);  // Update the text result fields at the next frame
 }
 
 //#######################################################################
@@ -131,7 +139,7 @@ void drawTempResults() {
    curScreenPtr->updateTextSprite(2,curModuleHumidityS);
    curScreenPtr->updateTextSprite(3,timeMonitoredS);
 
-   curScreenPtr->drawTextSprite();  // Update the text result fields
+   renderRequest(RENDER_TEXT);  // Update the text result fields at the next frame
 }
 
 //######################################################
@@ -144,14 +152,19 @@ void monitorResults(uint8_t buttonNumber) {
    strcpy(dateStringFormat, "YYYY-MM-DD_hh-mm-ss");
    strcpy(dateString[0],now.toString(dateStringFormat));
 
-   if(!strcmp(curScreenPtr->getScreenTitle(), MONITOR_MENU) || !strcmp(curResType, "IV") || !strcmp(curResType, "TEMP") || !strcmp(curResType, "AD")) {
-      strcpy(resMenu , MONITOR_MENU);
+   // The monitor screen of the results being logged
+   if(!strcmp(curResType, "TEMP")) {
+      resScreen = SCREEN_TEMP_MONITOR;
+   } else if(!strcmp(curResType, "AD")) {
+      resScreen = SCREEN_AD_MONITOR;
+   } else {
+      resScreen = SCREEN_IV_MONITOR;
    }
 
    // StartLog button
    if(buttonNumber == 21) { 
       strcpy(curStartResumeState, "Restart"); 
-      getScreenPtr(resMenu)->updateButtonLabel(21,curStartResumeState);
+      getScreenPtr(resScreen)->updateButtonLabel(MONITOR_START_BTN,curStartResumeState);
 
       // Start tracking the monitoring time
       monitoringResults = true;
@@ -163,33 +176,40 @@ void monitorResults(uint8_t buttonNumber) {
       resultArraysFilled = false;
 
       // NOTE:  Be sure to include "/" in front of the file name (starts at root directory) or the file opening will fail...
-      if(!strcmp(curScreenPtr->getScreenTitle(), MONITOR_MENU) || !strcmp(curResType, "IV")) {
+      if(curScreenPtr == getScreenPtr(SCREEN_IV_MONITOR) || !strcmp(curResType, "IV")) {
          strcpy(resF0 , "/ivCurrent_"); strcat(resF0 , dateString[0]); strcat(resF0, ".csv");
          strcpy(resF1 , "/ivVoltage_"); strcat(resF1 , dateString[0]); strcat(resF1, ".csv");
          strcpy(resF2 , "/ivPower_"); strcat(resF2 , dateString[0]); strcat(resF2, ".csv");
-      } else if(!strcmp(curScreenPtr->getScreenTitle(), MONITOR_MENU) || !strcmp(curResType, "TEMP")) {
+      } else if(curScreenPtr == getScreenPtr(SCREEN_TEMP_MONITOR) || !strcmp(curResType, "TEMP")) {
          strcpy(resF0 , "/probeTemp_"); strcat(resF0 , dateString[0]); strcat(resF0, ".csv");
          strcpy(resF1 , "/moduleTemp_"); strcat(resF1 , dateString[0]); strcat(resF1, ".csv");
          strcpy(resF2 , "/moduleHumidity_"); strcat(resF2 , dateString[0]); strcat(resF2, ".csv");
-      } else if(!strcmp(curScreenPtr->getScreenTitle(), MONITOR_MENU) || !strcmp(curResType, "AD")) {
+      } else if(curScreenPtr == getScreenPtr(SCREEN_AD_MONITOR) || !strcmp(curResType, "AD")) {
          strcpy(resF0 , "/dinCount_"); strcat(resF0 , dateString[0]); strcat(resF0, ".csv");
          strcpy(resF1 , "/ainVoltage_"); strcat(resF1 , dateString[0]); strcat(resF1, ".csv");
+         strcpy(resF2 , "");   // A/D only logs two channels (the third file and its pyramid are left off)
       }
+      resPyramid0.begin(resF0);
+      resPyramid1.begin(resF1);
+      resPyramid2.begin(resF2);
 
    // Stop button
    } else if(buttonNumber == 22) {
       monitoringResults = false;
       strcpy(curStartResumeState, "StartLog");
-      getScreenPtr(resMenu)->updateButtonLabel(21,curStartResumeState);
-
-      writeResultsToFile(1, resF0,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0);
-      writeResultsToFile(1, resF1,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1);
-      writeResultsToFile(1, resF2,resArrIdx,monitoredResultsXAxis2,monitoredResultsYAxis2);
+      getScreenPtr(resScreen)->updateButtonLabel(MONITOR_START_BTN,curStartResumeState);
+
+      writeResultsToFile(1, resF0,resArrIdx,monitoredResultsXAxis0,monitoredResultsYAxis0,&resPyramid0);
+      resPyramid0.finish();
+      writeResultsToFile(1, resF1,resArrIdx,monitoredResultsXAxis1,monitoredResultsYAxis1,&resPyramid1);
+      resPyramid1.finish();
+      writeResultsToFile(1, resF2,resArrIdx,monitoredResultsXAxis2,monitoredResultsYAxis2,&resPyramid2);
+      resPyramid2.finish();
       resArrIdx = 0;
       resultArraysFilled = true;
    }
 
-   curScreenPtr->drawButtonTextSprite();  // Add the labels to the buttons
+   renderRequest(RENDER_BUTTONS);  // Add the labels to the buttons
 }
 
 
@@ -198,7 +218,13 @@ void monitorResults(uint8_t buttonNumber) {
 // We actually move the last entry in the array buffer 
 // to the 0th entry and reset the index to the 1st entry.
 //###########################################################
-void writeResultsToFile(boolean writeAllEntries, const char * filename, int arrIndex, float * xAxisArrPtr, float * yAxisArrPtr) {
+void writeResultsToFile(boolean writeAllEntries, const char * filename, int arrIndex, float * xAxisArrPtr, float * yAxisArrPtr,
+                        MyResultPyramid * pyramidPtr) {
+
+   // No file for this channel (the result type doesn't log it)
+   if(filename[0] == '\0') {
+      return;
+   }
 
    myFile = SD.open(filename, FILE_APPEND);
    uint8_t indexToStopAt;
@@ -217,8 +243,12 @@ void writeResultsToFile(boolean writeAllEntries, const char * filename, int arrI
          myFile.print(*(xAxisArrPtr+i));
          myFile.print(",");
          myFile.println(*(yAxisArrPtr+i));
+
+         // Roll the sample into the summary pyramid (it needs to know where the sample ends in the file)
+         pyramidPtr->add(*(xAxisArrPtr+i), *(yAxisArrPtr+i), myFile.position());
       }
       myFile.close();
+      pyramidPtr->flush();
 
       if(!writeAllEntries) {
          // If we're not flushing the buffer, move the last array entry to the 0th entry.  That leaves 
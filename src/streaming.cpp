@@ -0,0 +1,63 @@
+
+#include <streaming.h>
+
+//#################################################################################################
+// Live sample streaming over the USB serial port.  When streaming is turned on (StreamOn button on
+// the monitor screens), every sample that gets logged to the result arrays is also sent out the
+// serial port as a small COBS framed binary record (see streamFrame.h for the layout).
+// tools/streamReceiver has a host program that reads the frames and writes them to a CSV file.
+//
+// We never wait on the UART.  The serial driver gets a large TX ring buffer that the UART interrupt
+// drains in the background.  If there isn't room for a whole frame we drop it rather than stall the
+// sampling loop.  The sequence number still increments so the receiver can count what was lost.
+//#################################################################################################
+
+uint32_t streamSeq = 0;            // Sequence number of the next frame
+uint32_t streamSentFrames = 0;     // Frames queued since streaming was turned on
+uint32_t streamDroppedFrames = 0;  // Frames we dropped because the TX buffer was full
+
+// Set up the serial port.  The TX buffer size must be set before Serial.begin()
+void streamBegin() {
+   Serial.setTxBufferSize(STREAM_TX_BUFFER_SIZE);
+   Serial.begin(SERIAL_BAUD);
+}
+
+// Send one sample frame for the given result type (AD, IV or TEMP)
+void streamResults(const char * resType, float res0, float res1, float res2) {
+   streamSample sample;
+   uint8_t raw[STREAM_RAW_LEN];
+   uint8_t wire[STREAM_WIRE_LEN];
+
+   if(!strcmp(resType, "IV")) {
+      sample.type = STREAM_TYPE_IV;
+   } else if(!strcmp(resType, "TEMP")) {
+      sample.type = STREAM_TYPE_TEMP;
+   } else {
+      sample.type = STREAM_TYPE_AD;
+   }
+   sample.seq = streamSeq++;
+   sample.timeMs = millis() - monitoringStartTime;
+   sample.result[0] = res0;
+   sample.result[1] = res1;
+   sample.result[2] = res2;
+
+   streamPackFrame(&sample, raw);
+   uint16_t wireLen = streamCobsEncode(raw, STREAM_RAW_LEN, wire);
+
+   // Only queue whole frames.  A partial frame would just fail the CRC on the other end anyway.
+   if(Serial.availableForWrite() >= wireLen) {
+      Serial.write(wire, wireLen);
+      streamSentFrames++;
+   } else {
+      streamDroppedFrames++;
+   }
+}
+
+// Streaming was turned off.  The port is back to text, so say how many frames went out and how many
+// had to be dropped (the receiver only sees the gaps), then start the counts over for the next time.
+void streamEnd() {
+   Serial.print(F("Stream frames sent: "));Serial.print(streamSentFrames);
+   Serial.print(F("  dropped (TX buffer full): "));Serial.println(streamDroppedFrames);
+   streamSentFrames = 0;
+   streamDroppedFrames = 0;
+}
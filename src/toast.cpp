@@ -0,0 +1,105 @@
+
+#include <toast.h>
+#include <graphing.h>
+
+//#################################################################################################
+// Timed status pop-ups (see toast.h).
+// The toast belongs to the screen that was up when it was shown.  If the screen changes, drawScreen()
+// has already painted over it so it is just forgotten.  Anything that has to draw where the toast
+// sits (button presses) brackets the drawing with toastSuspend()/toastResume(): the underlying pixels
+// go back, the drawing happens, then the (possibly changed) screen is saved again and the toast put
+// back on top for the rest of its time.
+// Saving the pixels reads the display back, which needs MISO (the same as the screen cache).  Without
+// USE_SCREEN_CACHE the screen is drawn again instead of putting the saved pixels back.
+//#################################################################################################
+
+#define TOAST_NONE      0
+#define TOAST_SHOWN     1
+#define TOAST_SUSPENDED 2
+
+uint8_t toastState = TOAST_NONE;
+MyTouchScreen * toastScreenPtr = NULL;
+unsigned long toastExpires = 0;
+char toastText[TEXT_LEN + 1];
+#if USE_SCREEN_CACHE
+uint16_t toastUnderlay[STATUS_WIDTH * STATUS_HEIGHT];   // Screen pixels under the status box
+#endif
+
+// Save what is under the status box and draw the message over it
+static void toastDraw() {
+#if USE_SCREEN_CACHE
+   tft.readRect(STATUS_X, STATUS_Y, STATUS_WIDTH, STATUS_HEIGHT, toastUnderlay);
+#endif
+   statusSprite.setTextColor(STATUS_COLOR, STATUS_BACKGROUND);
+   statusSprite.setTextDatum(STATUS_DATUM);
+   statusSprite.setFreeFont(STATUS_TEXT_FONT);
+   statusSprite.fillSprite(STATUS_BACKGROUND);
+   statusSprite.drawString(toastText, STATUS_WIDTH/2, STATUS_HEIGHT/2, GFXFF);
+   statusSprite.pushSprite(STATUS_X, STATUS_Y);
+}
+
+// Put the saved pixels back (or draw the screen again if they couldn't be saved)
+static void toastRestore() {
+#if USE_SCREEN_CACHE
+   tft.pushImage(STATUS_X, STATUS_Y, STATUS_WIDTH, STATUS_HEIGHT, toastUnderlay);
+#else
+   toastScreenPtr->drawScreen();
+   if(isGraphScreen(toastScreenPtr)) {
+      redrawGraph();
+   }
+#endif
+}
+
+// Pop up a message for ms milliseconds.  Replaces any toast already showing.
+void toastShow(const char * text, unsigned long ms) {
+   if(toastVisible()) {
+      toastRestore();
+   }
+   strncpy(toastText, text, TEXT_LEN);
+   toastText[TEXT_LEN] = '\0';
+   toastScreenPtr = curScreenPtr;
+   toastExpires = millis() + ms;
+   toastDraw();
+   toastState = TOAST_SHOWN;
+}
+
+// Take the toast down once its time is up.  Called every pass of the main loop.
+void toastService() {
+   if(toastState == TOAST_NONE) {
+      return;
+   }
+   if(curScreenPtr != toastScreenPtr) {
+      toastState = TOAST_NONE;
+      return;
+   }
+   if(toastState == TOAST_SHOWN && (long)(millis() - toastExpires) >= 0) {
+      toastRestore();
+      toastState = TOAST_NONE;
+   }
+}
+
+// True while a toast is on the current screen
+boolean toastVisible() {
+   return(toastState == TOAST_SHOWN && curScreenPtr == toastScreenPtr);
+}
+
+// Temporarily take the toast down so something can be drawn underneath it
+void toastSuspend() {
+   if(toastVisible()) {
+      toastRestore();
+      toastState = TOAST_SUSPENDED;
+   }
+}
+
+// Put a suspended toast back up (if it is still on the same screen)
+void toastResume() {
+   if(toastState != TOAST_SUSPENDED) {
+      return;
+   }
+   if(curScreenPtr != toastScreenPtr) {
+      toastState = TOAST_NONE;
+      return;
+   }
+   toastDraw();
+   toastState = TOAST_SHOWN;
+}
@@ -0,0 +1,133 @@
+//#################################################################################################
+// Points per second read back from a result file, the way drawGraph() replays a long session: the
+// MyCsvReader block reader at a couple of block sizes, against the byte at a time File.read() and
+// atof() loop it replaced.  The file is written like writeResultsToFile() writes the logged results.
+//#################################################################################################
+
+#include <nativeBench.h>
+#include <MyCsvReader.h>
+
+#define BENCH_FILE   "/benchResults.csv"
+#define BENCH_POINTS 20000
+#define BENCH_PASSES 10
+#define FIELD_WIDTH  16     // Old loop's field buffers (the logger's were FLOAT_STRING_WIDTH)
+
+static char block[CSV_BLOCK_SIZE];
+static double sumX;         // Checksums so the readers can be compared (and aren't optimized away)
+static double sumY;
+
+// A logging session's worth of X,Y rows (seconds, a slow sine), printed like writeResultsToFile()
+static void recordFile() {
+   SD.remove(BENCH_FILE);
+   File f = SD.open(BENCH_FILE, FILE_APPEND);
+   TEST_ASSERT_TRUE(f);
+   for(int i=0; i<BENCH_POINTS; i++) {
+      f.print(i * 0.5);
+      f.print(",");
+      f.println(250.0 + 200.0 * sin(i * 0.01));
+   }
+   f.close();
+}
+
+// The drawGraph() loop from before MyCsvReader
+static unsigned long readByteAtATime() {
+   unsigned long points = 0;
+   char fieldX[FIELD_WIDTH];
+   char fieldY[FIELD_WIDTH];
+   File resFH = SD.open(BENCH_FILE, FILE_READ);
+   while(resFH.available()) {
+      uint8_t idx = 0;
+      uint8_t c;
+      while((c = resFH.read()) != ',') {
+         fieldX[idx++] = c;
+      }
+      fieldX[idx] = '\0';
+      idx = 0;
+      while((c = resFH.read()) != 13) {
+         fieldY[idx++] = c;
+      }
+      resFH.read();   // LF
+      fieldY[idx] = '\0';
+      sumX += atof(fieldX);
+      sumY += atof(fieldY);
+      points++;
+   }
+   resFH.close();
+   return(points);
+}
+
+static unsigned long readBlocks(uint16_t blockSize) {
+   unsigned long points = 0;
+   float fields[2];
+   MyCsvReader reader(block, blockSize);
+   TEST_ASSERT_TRUE(reader.open(BENCH_FILE));
+   while(reader.readRow(fields, 2) == 2) {
+      sumX += fields[0];
+      sumY += fields[1];
+      points++;
+   }
+   reader.close();
+   return(points);
+}
+
+// Read the file BENCH_PASSES times with the reader given and report points/sec
+static void benchRead(const char * name, unsigned long (*readFile)(uint16_t), uint16_t blockSize) {
+   unsigned long points = 0;
+   sumX = 0.0;
+   sumY = 0.0;
+   unsigned long start = hostMicros();
+   for(int i=0; i<BENCH_PASSES; i++) {
+      points += readFile(blockSize);
+   }
+   unsigned long hostUs = hostMicros() - start;
+   TEST_ASSERT_EQUAL_UINT32(BENCH_POINTS * BENCH_PASSES, points);
+   benchReport(name, points, hostUs);
+}
+
+static unsigned long readOld(uint16_t) {
+   return(readByteAtATime());
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// Both readers get the same numbers out of the file
+void bench_readers_agree(void) {
+   recordFile();
+   sumX = 0.0;
+   sumY = 0.0;
+   TEST_ASSERT_EQUAL_UINT32(BENCH_POINTS, readByteAtATime());
+   double oldX = sumX;
+   double oldY = sumY;
+   sumX = 0.0;
+   sumY = 0.0;
+   TEST_ASSERT_EQUAL_UINT32(BENCH_POINTS, readBlocks(CSV_BLOCK_SIZE));
+   TEST_ASSERT_FLOAT_WITHIN(0.01 * BENCH_POINTS, oldX, sumX);
+   TEST_ASSERT_FLOAT_WITHIN(0.01 * BENCH_POINTS, oldY, sumY);
+}
+
+void bench_byte_at_a_time(void) {
+   benchRead("read()+atof() per point", readOld, 0);
+}
+
+void bench_block_512(void) {
+   benchRead("MyCsvReader 512 B blocks", readBlocks, 512);
+}
+
+void bench_block_4k(void) {
+   benchRead("MyCsvReader 4 KB blocks", readBlocks, CSV_BLOCK_SIZE);
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+
+   UNITY_BEGIN();
+   RUN_TEST(bench_readers_agree);
+   RUN_TEST(bench_byte_at_a_time);
+   RUN_TEST(bench_block_512);
+   RUN_TEST(bench_block_4k);
+   return(UNITY_END());
+}
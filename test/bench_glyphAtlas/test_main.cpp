@@ -0,0 +1,61 @@
+//#################################################################################################
+// GLYPH_BENCHMARK on the host: glyphs/sec drawing a result value into the results text sprite with
+// drawString and with the glyph atlas.  Same loops as glyphBenchmark() in main.cpp, timed with the
+// host clock (micros() is the fake one here) on the sprite and atlas setup() made.
+//#################################################################################################
+
+#include <nativeBench.h>
+#include <MyGlyphAtlas.h>
+
+#define BENCH_LOOPS 20000
+
+extern TFT_eSprite textSprite;
+extern MyGlyphAtlas textAtlas;
+
+static const char * const values[] = {"-123.4", "   0.00", " 4981.25"};
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void bench_draw_string(void) {
+   textSprite.setFreeFont(TEXT_FONT);
+   textSprite.setTextColor(TFT_WHITE, TFT_BLACK);
+   textSprite.setTextDatum(TEXT_DATUM);
+   for(const char * value : values) {
+      char name[40];
+      snprintf(name, sizeof(name), "drawString '%s'", value);
+      unsigned long start = hostMicros();
+      for(int i=0; i<BENCH_LOOPS; i++) {
+         textSprite.setViewport(0, 0, TEXT_SP_WIDTH, TEXT_SP_HEIGHT);
+         textSprite.fillSprite(TFT_BLACK);
+         textSprite.drawString(value, 0, 0, GFXFF);
+         textSprite.resetViewport();
+      }
+      benchReport(name, strlen(value) * BENCH_LOOPS, hostMicros() - start);
+   }
+}
+
+void bench_glyph_atlas(void) {
+   for(const char * value : values) {
+      char name[40];
+      snprintf(name, sizeof(name), "atlas '%s'", value);
+      TEST_ASSERT_TRUE(textAtlas.drawString(&textSprite, value, 0, 0, TEXT_SP_WIDTH, TEXT_SP_HEIGHT));
+      unsigned long start = hostMicros();
+      for(int i=0; i<BENCH_LOOPS; i++) {
+         textAtlas.drawString(&textSprite, value, 0, 0, TEXT_SP_WIDTH, TEXT_SP_HEIGHT);
+      }
+      benchReport(name, strlen(value) * BENCH_LOOPS, hostMicros() - start);
+   }
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+
+   UNITY_BEGIN();
+   RUN_TEST(bench_draw_string);
+   RUN_TEST(bench_glyph_atlas);
+   return(UNITY_END());
+}
@@ -0,0 +1,101 @@
+//#################################################################################################
+// Time to put a graph's worth of points through the data to pixel transform: the float one MyTouchScreen used
+// (subtract, divide by the axis range and scale, per coordinate), against the fixed point one set up
+// once per axis by setGraphTransform().  Same samples through both, a slow sine across the axes
+// like a logged session.
+//#################################################################################################
+
+#include <nativeBench.h>
+#include <MyGraphTransform.h>
+#include <math.h>
+
+#define BENCH_POINTS 4096
+#define BENCH_PASSES 2000
+
+#define X_MIN 0.0
+#define X_MAX 60.0
+#define Y_MIN -5.0
+#define Y_MAX 120.0
+
+static float xs[BENCH_POINTS];
+static float ys[BENCH_POINTS];
+static long sumX;           // Checksums so the transforms can be compared (and aren't optimized away)
+static long sumY;
+
+// The axis limits were members the float transform read on every call
+struct floatAxes {
+   float xAxisMin;
+   float xAxisMax;
+   float yAxisMin;
+   float yAxisMax;
+};
+static floatAxes axes = {X_MIN, X_MAX, Y_MIN, Y_MAX};
+
+// MyTouchScreen::_dataToPixelX/Y from before the fixed point transform
+static int floatPixelX(const floatAxes * a, float dataX) {
+   int graphWidth = GRAPH_X_RIGHT - GRAPH_X_ORIGIN;
+   return(int(((dataX-a->xAxisMin)/(a->xAxisMax-a->xAxisMin))*graphWidth + GRAPH_X_ORIGIN));
+}
+static int floatPixelY(const floatAxes * a, float dataY) {
+   int graphHeight = GRAPH_Y_ORIGIN - GRAPH_Y_TOP;
+   return(int(GRAPH_Y_ORIGIN - ((dataY-a->yAxisMin)/(a->yAxisMax-a->yAxisMin))*graphHeight));
+}
+
+void setUp(void) {
+   for(int i=0; i<BENCH_POINTS; i++) {
+      xs[i] = X_MIN + (X_MAX - X_MIN) * i / BENCH_POINTS;
+      ys[i] = (Y_MIN + Y_MAX) / 2.0 + (Y_MAX - Y_MIN) / 2.1 * sin(i * 0.01);
+   }
+   sumX = 0;
+   sumY = 0;
+}
+
+void tearDown(void) {
+}
+
+void bench_float_transform(void) {
+   const floatAxes * volatile a = &axes;   // Read through a pointer, as the members were
+   unsigned long start = hostMicros();
+   for(int pass=0; pass<BENCH_PASSES; pass++) {
+      for(int i=0; i<BENCH_POINTS; i++) {
+         sumX += floatPixelX(a, xs[i]);
+         sumY += floatPixelY(a, ys[i]);
+      }
+   }
+   benchReport("float transform 4096 pts", BENCH_PASSES, hostMicros() - start);
+}
+
+void bench_fixed_point_transform(void) {
+   graphTransform x, y;
+   setGraphTransform(X_MIN, X_MAX, GRAPH_X_RIGHT - GRAPH_X_ORIGIN, GRAPH_X_ORIGIN, &x);
+   setGraphTransform(Y_MIN, Y_MAX, -(GRAPH_Y_ORIGIN - GRAPH_Y_TOP), GRAPH_Y_ORIGIN, &y);
+   const graphTransform * volatile xt = &x;
+   const graphTransform * volatile yt = &y;
+   unsigned long start = hostMicros();
+   for(int pass=0; pass<BENCH_PASSES; pass++) {
+      for(int i=0; i<BENCH_POINTS; i++) {
+         sumX += graphDataToPixel(xs[i], xt);
+         sumY += graphDataToPixel(ys[i], yt);
+      }
+   }
+   benchReport("fixed point transform 4096 pts", BENCH_PASSES, hostMicros() - start);
+}
+
+// Both put the samples on the same pixels (give or take the rounding of the last bit)
+void test_transforms_agree(void) {
+   graphTransform x, y;
+   setGraphTransform(X_MIN, X_MAX, GRAPH_X_RIGHT - GRAPH_X_ORIGIN, GRAPH_X_ORIGIN, &x);
+   setGraphTransform(Y_MIN, Y_MAX, -(GRAPH_Y_ORIGIN - GRAPH_Y_TOP), GRAPH_Y_ORIGIN, &y);
+   for(int i=0; i<BENCH_POINTS; i++) {
+      TEST_ASSERT_INT_WITHIN(1, floatPixelX(&axes, xs[i]), graphDataToPixel(xs[i], &x));
+      TEST_ASSERT_INT_WITHIN(1, floatPixelY(&axes, ys[i]), graphDataToPixel(ys[i], &y));
+   }
+}
+
+int main(int argc, char ** argv) {
+   UNITY_BEGIN();
+   RUN_TEST(test_transforms_agree);
+   RUN_TEST(bench_float_transform);
+   RUN_TEST(bench_fixed_point_transform);
+   return(UNITY_END());
+}
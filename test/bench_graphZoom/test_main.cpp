@@ -0,0 +1,126 @@
+//#################################################################################################
+// Touch zoom and pan on the graph of a 24 hour I/V session logged once a second.  The session (the
+// raw CSV file and its summary pyramid) is written the way updateResults() writes it, then the
+// gestures go through graphTouch() like the loop's touch reads do.  Each operation is one redraw
+// after the finger lifts; the SD bytes are what that redraw read off the card.
+//#################################################################################################
+
+#include <nativeBench.h>
+#include <results.h>
+#include <graphing.h>
+#include <menus.h>
+#include <math.h>
+
+#define SESSION_MIN   1440          // 24 hours
+#define SESSION_SECS  (SESSION_MIN * 60)
+#define ZOOM_LEVELS   4             // Each zoom shows a tenth of the range before it
+#define BENCH_PANS    10
+#define PLOT_W        (GRAPH_X_RIGHT - GRAPH_X_ORIGIN)
+#define PAN_Y         ((GRAPH_Y_ORIGIN + GRAPH_PAN_Y_BOTTOM) / 2)
+#define ZOOM_Y        ((GRAPH_Y_TOP + GRAPH_Y_ORIGIN) / 2)
+
+static uint32_t rawFileSize;
+
+// One sample a second of a current that drifts over the day with a little ripple on it
+static void logSession() {
+   strcpy(resF0, "/benchCurrent.csv");
+   SD.remove(resF0);
+   resPyramid0.begin(resF0);
+   int idx = 0;
+   for(long sec=0; sec<=SESSION_SECS; sec++) {
+      monitoredResultsXAxis0[idx] = sec / 60.0;
+      monitoredResultsYAxis0[idx] = 5.0 + 3.0 * sin(sec * 2.0 * M_PI / SESSION_SECS) + 0.5 * sin(sec * 0.05);
+      idx++;
+      if(idx == MAX_RESULT_POINTS) {
+         writeResultsToFile(0, resF0, idx, monitoredResultsXAxis0, monitoredResultsYAxis0, &resPyramid0);
+         idx = 1;
+      }
+   }
+   writeResultsToFile(1, resF0, idx, monitoredResultsXAxis0, monitoredResultsYAxis0, &resPyramid0);
+   resPyramid0.finish();
+   resArrIdx = 0;
+   resultArraysFilled = true;
+
+   File f = SD.open(resF0, FILE_READ);
+   rawFileSize = f.size();
+   f.close();
+}
+
+// Drag from x0 to x1 at y and time the redraw when the finger comes up
+static void benchGesture(const char * name, int repeats, uint16_t y, uint16_t x0, uint16_t x1) {
+   unsigned long hostUs = 0;
+   tftStats stats = {0, 0};
+   fsStats reads = {0, 0};
+   for(int i=0; i<repeats; i++) {
+      // Pans go back and forth so the window stays over the session
+      uint16_t from = (i & 1) ? x1 : x0;
+      uint16_t to = (i & 1) ? x0 : x1;
+      graphTouch(true, from, y);
+      graphTouch(true, to, y);
+      tft.resetStats();
+      SD.resetStats();
+      unsigned long start = hostMicros();
+      graphTouch(false, to, y);
+      hostUs += hostMicros() - start;
+      stats.drawCalls += tft.getStats().drawCalls;
+      stats.pixels += tft.getStats().pixels;
+      reads.opens += SD.getStats().opens;
+      reads.bytesRead += SD.getStats().bytesRead;
+   }
+   benchReport(name, repeats, hostUs, &stats, &reads);
+
+   // Only the part of the session in view (or its summary) gets read
+   TEST_ASSERT_TRUE(graphZoomed);
+   TEST_ASSERT_LESS_THAN(rawFileSize / 4, reads.bytesRead / repeats);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void bench_full_graph(void) {
+   logSession();
+   TEST_ASSERT_EQUAL_UINT32(SESSION_SECS + 1, resPyramid0.getSampleCount());
+   char line[80];
+   snprintf(line, sizeof(line), "24 h session: %lu samples, %lu byte raw file", (unsigned long)resPyramid0.getSampleCount(),
+            (unsigned long)rawFileSize);
+   TEST_MESSAGE(line);
+   strcpy(monitorIvDurationS, "1440");
+   strcpy(graphModeS, "ViewFull");
+
+   tft.resetStats();
+   SD.resetStats();
+   unsigned long start = hostMicros();
+   drawIvGraph(20);
+   unsigned long hostUs = hostMicros() - start;
+   tftStats stats = tft.getStats();
+   fsStats reads = SD.getStats();
+   benchReport("open 24 h graph", 1, hostUs, &stats, &reads);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_IV_GRAPH));
+   TEST_ASSERT_FALSE(graphZoomed);
+}
+
+// Zoom in a tenth at a time (144, 14.4, 1.44 and 0.144 minutes) and pan at each range
+void bench_zoom_and_pan(void) {
+   char name[40];
+   for(int level=0; level<ZOOM_LEVELS; level++) {
+      float range = SESSION_MIN / pow(10.0, level + 1);
+      snprintf(name, sizeof(name), "zoom to %g min", range);
+      benchGesture(name, 1, ZOOM_Y, GRAPH_X_ORIGIN + PLOT_W * 45 / 100, GRAPH_X_ORIGIN + PLOT_W * 55 / 100);
+      TEST_ASSERT_FLOAT_WITHIN(range * 0.05, range, graphZoomMax - graphZoomMin);
+
+      snprintf(name, sizeof(name), "pan %g min window", range);
+      benchGesture(name, BENCH_PANS, PAN_Y, GRAPH_X_ORIGIN + PLOT_W / 4, GRAPH_X_ORIGIN + PLOT_W / 2);
+   }
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+
+   UNITY_BEGIN();
+   RUN_TEST(bench_full_graph);
+   RUN_TEST(bench_zoom_and_pan);
+   return(UNITY_END());
+}
@@ -0,0 +1,61 @@
+//#################################################################################################
+// Cost of one loop() pass on the screens the logger spends its time on: the idle main menu, the
+// I/V monitor screen while logging, and the graph of a logging session.
+//#################################################################################################
+
+#include <nativeBench.h>
+#include <results.h>
+
+#define BENCH_PASSES 1000   // Short enough that both logging runs fit in the 1 minute session
+
+// Time BENCH_PASSES loop() passes, TEST_LOOP_MS of fake time apart
+static void benchLoop(const char * name) {
+   unsigned long hostUs = 0;
+   tft.resetStats();
+   for(unsigned long i=0; i<BENCH_PASSES; i++) {
+      unsigned long start = hostMicros();
+      loop();
+      hostUs += hostMicros() - start;
+      halAdvanceMicros(TEST_LOOP_MS * 1000UL);
+   }
+   tftStats stats = tft.getStats();
+   benchReport(name, BENCH_PASSES, hostUs, &stats);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void bench_main_menu_idle(void) {
+   runFor(1000);
+   benchLoop("loop() main menu idle");
+}
+
+void bench_monitor_logging(void) {
+   tapButton(5);
+   tapButton(21);
+   tapButton(MONITOR_START_BTN);
+   benchLoop("loop() I/V monitor logging");
+   TEST_ASSERT_TRUE(monitoringResults);
+}
+
+// Voltage, as the fake current runs off the top of the default current axis
+void bench_graph_logging(void) {
+   tapButton(20);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_IV_GRAPH));
+   tapButton(21);
+   benchLoop("loop() I/V graph logging");
+   TEST_ASSERT_TRUE(monitoringResults);
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+
+   UNITY_BEGIN();
+   RUN_TEST(bench_main_menu_idle);
+   RUN_TEST(bench_monitor_logging);
+   RUN_TEST(bench_graph_logging);
+   return(UNITY_END());
+}
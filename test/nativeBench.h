@@ -0,0 +1,34 @@
+//#################################################################################################
+// Shared by the native benchmarks (pio test -e native_bench).  Host time for a piece of the logger
+// (the fake clock doesn't move while it runs) and the display and SD card traffic it caused, printed as a
+// Unity message so it shows up in the test output.
+//#################################################################################################
+
+#ifndef nativeBench_h
+#define nativeBench_h
+
+#include <nativeTest.h>
+#include <chrono>
+
+inline unsigned long hostMicros() {
+   static const auto start = std::chrono::steady_clock::now();
+   return(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+// One result line:  name  us/op  ops/sec  [calls/op  pixels/op]  [SD bytes/op]
+inline void benchReport(const char * name, unsigned long ops, unsigned long hostUs, const tftStats * stats = NULL,
+                        const fsStats * reads = NULL) {
+   char line[200];
+   double perOp = hostUs / (double)max(ops, 1UL);
+   int n = snprintf(line, sizeof(line), "%-28s %10.2f us/op %12.0f ops/sec", name, perOp, perOp > 0 ? 1000000.0 / perOp : 0.0);
+   if(stats) {
+      n += snprintf(line + n, sizeof(line) - n, " %8.2f calls/op %10.1f pixels/op",
+                    stats->drawCalls / (double)max(ops, 1UL), stats->pixels / (double)max(ops, 1UL));
+   }
+   if(reads) {
+      snprintf(line + n, sizeof(line) - n, " %10.0f SD bytes/op", reads->bytesRead / (double)max(ops, 1UL));
+   }
+   TEST_MESSAGE(line);
+}
+
+#endif
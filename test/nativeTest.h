@@ -0,0 +1,87 @@
+//#################################################################################################
+// Shared by the native test suites (pio test -e native).  Runs the data logger on the fakes in
+// tools/nativeHal with an empty SD card and SPIFFS under /tmp, and drives it the way a user would:
+// taps on the touch panel and fake time going by.
+//#################################################################################################
+
+#ifndef nativeTest_h
+#define nativeTest_h
+
+#include <Arduino.h>
+#include <nativeHal.h>
+#include <TFT_eSPI.h>
+#include <unity.h>
+#include <main.h>
+#include <stdlib.h>
+#include <string>
+
+#define TEST_LOOP_MS 10     // Fake time between loop() passes (same as the native runner's default)
+#define TEST_TAP_MS  100    // How long a tap holds the panel down (a few TOUCH_POLL_MS reads)
+
+// Center of button b on the 4x6 button grid (see KEY_X/KEY_Y/KEY_W/KEY_H in MyDisplay.h)
+#define BTN_X(b) (KEY_X + ((b) % 4) * (KEY_W + KEY_SPACING_X))
+#define BTN_Y(b) (KEY_Y + ((b) / 4) * (KEY_H + KEY_SPACING_Y))
+
+extern TFT_eSPI tft;
+
+// Where this suite's SD card lives
+inline std::string & sdRoot() {
+   static std::string root;
+   return(root);
+}
+
+// Fresh SD card and SPIFFS directories for the suite, then the sketch's setup()
+inline void nativeBegin() {
+   char sdTemplate[] = "/tmp/loggerSdXXXXXX";
+   char spiffsTemplate[] = "/tmp/loggerSpiffsXXXXXX";
+   sdRoot() = mkdtemp(sdTemplate);
+   setenv("SD_ROOT", sdRoot().c_str(), 1);
+   setenv("SPIFFS_ROOT", mkdtemp(spiffsTemplate), 1);
+   setup();
+}
+
+// Run loop() for ms of fake time
+inline void runFor(unsigned long ms) {
+   unsigned long start = millis();
+   while(millis() - start < ms) {
+      loop();
+      halAdvanceMicros(TEST_LOOP_MS * 1000UL);
+   }
+}
+
+// Touch x,y, let go and let the screen settle
+inline void tapAt(uint16_t x, uint16_t y) {
+   halTouch(x, y);
+   runFor(TEST_TAP_MS);
+   halRelease();
+   runFor(TEST_TAP_MS);
+}
+
+inline void tapButton(uint8_t buttonNumber) {
+   tapAt(BTN_X(buttonNumber), BTN_Y(buttonNumber));
+}
+
+// Contents of a file on the fake SD card ("" if there isn't one)
+inline std::string readSdFile(const char * name) {
+   std::string text;
+   FILE * f = fopen((sdRoot() + name).c_str(), "rb");
+   if(f) {
+      char buf[512];
+      size_t n;
+      while((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+         text.append(buf, n);
+      }
+      fclose(f);
+   }
+   return(text);
+}
+
+inline bool sdFileExists(const char * name) {
+   FILE * f = fopen((sdRoot() + name).c_str(), "rb");
+   if(f) {
+      fclose(f);
+   }
+   return(f != NULL);
+}
+
+#endif
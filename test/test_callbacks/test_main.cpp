@@ -0,0 +1,211 @@
+//#################################################################################################
+// callbacks.cpp: the option buttons, driven from the touch screen, and what they do to the outputs.
+//#################################################################################################
+
+#include <nativeTest.h>
+#include <callbacks.h>
+#include <menus.h>
+
+// Every test starts from the main menu with the options (and outputs) as they are at power up
+void setUp(void) {
+   strcpy(doutOutputS, "Low");
+   ledcDetachPin(DOUTPIN);
+   digitalWrite(DOUTPIN, 0);
+   doutPwmDutyCycle = 50;
+   dtostrf(doutPwmDutyCycle, 3, 1, doutPwmDutyCycleS);
+   strcpy(doutPwmFrequencyS, "4 KHz");
+   pwmFrequency = 4000;
+   strcpy(manual110vActionS, "Off");
+   digitalWrite(EXT_POWER_RELAY, LOW);
+   strcpy(action110vOnAlarmS, "None");
+   if(!strcmp(streamStateS, "StreamOn")) {
+      streamEnd();
+   }
+   strcpy(streamStateS, "StreamOff");
+   strcpy(graphModeS, "ViewFull");
+   strcpy(ivAlarmArmedS, "Disabled");
+   strcpy(tempAlarmArmedS, "Disabled");
+   strcpy(maxAinVoltageS, "24.0");
+   maxAinVoltage = 24.0;
+   drawMainMenu(0);
+   runFor(TEST_TAP_MS);
+}
+
+void tearDown(void) {
+}
+
+// D-Out output cycles Low -> High -> PWM -> PWM-Inv -> Low
+void test_dout_output_cycle(void) {
+   tapButton(10);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_DOUT));
+   TEST_ASSERT_EQUAL_STRING("Low", doutOutputS);
+
+   tapButton(DOUT_OUTPUT_BTN);
+   TEST_ASSERT_EQUAL_STRING("High", curScreenPtr->getButtonLabel(DOUT_OUTPUT_BTN));
+   TEST_ASSERT_EQUAL(1, halGetPin(DOUTPIN));
+   TEST_ASSERT_EQUAL(-1, halGetPwmChannel(DOUTPIN));
+
+   tapButton(DOUT_OUTPUT_BTN);
+   TEST_ASSERT_EQUAL_STRING("PWM", doutOutputS);
+   TEST_ASSERT_EQUAL(pwmChannel, halGetPwmChannel(DOUTPIN));
+   TEST_ASSERT_EQUAL_UINT32(map(50, 0, 100, 0, 1023), halGetPwm(pwmChannel));
+
+   tapButton(DOUT_OUTPUT_BTN);
+   TEST_ASSERT_EQUAL_STRING("PWM-Inv", doutOutputS);
+   TEST_ASSERT_EQUAL_UINT32(map(50, 100, 0, 0, 1023), halGetPwm(pwmChannel));
+
+   tapButton(DOUT_OUTPUT_BTN);
+   TEST_ASSERT_EQUAL_STRING("Low", doutOutputS);
+   TEST_ASSERT_EQUAL(0, halGetPin(DOUTPIN));
+   TEST_ASSERT_EQUAL(-1, halGetPwmChannel(DOUTPIN));
+}
+
+// A duty cycle typed in on the keypad is used once the output goes to PWM
+void test_dout_duty_cycle_from_keypad(void) {
+   tapButton(10);
+   tapButton(DOUT_DUTY_CYCLE_BTN);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_KEYPAD));
+   tapButton(13);   // 2
+   tapButton(9);    // 5
+   tapButton(7);    // Enter
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_DOUT));
+   TEST_ASSERT_EQUAL_STRING("25", curScreenPtr->getButtonLabel(DOUT_DUTY_CYCLE_BTN));
+
+   tapButton(DOUT_OUTPUT_BTN);   // High
+   tapButton(DOUT_OUTPUT_BTN);   // PWM
+   TEST_ASSERT_EQUAL(25, doutPwmDutyCycle);
+   TEST_ASSERT_EQUAL_UINT32(map(25, 0, 100, 0, 1023), halGetPwm(pwmChannel));
+}
+
+// Cancel on the keypad leaves the value alone
+void test_keypad_cancel(void) {
+   tapButton(10);
+   char before[TITLE_LEN];
+   strcpy(before, curScreenPtr->getButtonLabel(DOUT_DUTY_CYCLE_BTN));
+   tapButton(DOUT_DUTY_CYCLE_BTN);
+   tapButton(4);    // 7
+   tapButton(23);   // Cancel
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_DOUT));
+   TEST_ASSERT_EQUAL_STRING(before, curScreenPtr->getButtonLabel(DOUT_DUTY_CYCLE_BTN));
+}
+
+// PWM frequency cycles 4 -> 8 -> 1 -> 2 -> 4 KHz
+void test_dout_pwm_frequency_cycle(void) {
+   static const char * labels[] = {"8 KHz", "1 KHz", "2 KHz", "4 KHz"};
+   static const int frequencies[] = {8000, 1000, 2000, 4000};
+   tapButton(10);
+   for(uint8_t i=0; i<4; i++) {
+      tapButton(7);
+      TEST_ASSERT_EQUAL_STRING(labels[i], curScreenPtr->getButtonLabel(7));
+      TEST_ASSERT_EQUAL(frequencies[i], pwmFrequency);
+   }
+}
+
+// Manual 110v on/off drives the relay
+void test_manual_110v_relay(void) {
+   tapButton(14);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_110V));
+
+   tapButton(15);
+   TEST_ASSERT_EQUAL_STRING("On", manual110vActionS);
+   TEST_ASSERT_EQUAL(HIGH, halGetPin(EXT_POWER_RELAY));
+
+   tapButton(15);
+   TEST_ASSERT_EQUAL_STRING("Off", manual110vActionS);
+   TEST_ASSERT_EQUAL(LOW, halGetPin(EXT_POWER_RELAY));
+}
+
+// 110v action on alarm cycles None -> Turn On -> Turn Off -> None
+void test_110v_action_on_alarm_cycle(void) {
+   tapButton(14);
+   tapButton(7);
+   TEST_ASSERT_EQUAL_STRING("Turn On", curScreenPtr->getButtonLabel(7));
+   tapButton(7);
+   TEST_ASSERT_EQUAL_STRING("Turn Off", curScreenPtr->getButtonLabel(7));
+   tapButton(7);
+   TEST_ASSERT_EQUAL_STRING("None", action110vOnAlarmS);
+}
+
+// Monitor screen options: serial streaming and the graph view
+void test_stream_and_graph_mode(void) {
+   tapButton(5);
+   tapButton(21);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_IV_MONITOR));
+
+   tapButton(19);
+   TEST_ASSERT_EQUAL_STRING("StreamOn", streamStateS);
+   tapButton(19);
+   TEST_ASSERT_EQUAL_STRING("StreamOff", curScreenPtr->getButtonLabel(19));
+
+   static const char * modes[] = {"ViewStrip", "ViewOvrly", "ViewSplit", "ViewFull"};
+   for(uint8_t i=0; i<4; i++) {
+      tapButton(18);
+      TEST_ASSERT_EQUAL_STRING(modes[i], graphModeS);
+   }
+}
+
+// Alarm enable toggles on the setup screen and is kept when leaving it
+void test_iv_alarm_toggle_kept(void) {
+   tapButton(5);
+   tapButton(SETUP_ALARM_BTN);
+   TEST_ASSERT_EQUAL_STRING("Enabled", curScreenPtr->getButtonLabel(SETUP_ALARM_BTN));
+   tapButton(23);
+   TEST_ASSERT_EQUAL_STRING("Enabled", ivAlarmArmedS);
+
+   tapButton(5);
+   TEST_ASSERT_EQUAL_STRING("Enabled", curScreenPtr->getButtonLabel(SETUP_ALARM_BTN));
+   tapButton(SETUP_ALARM_BTN);
+   tapButton(23);
+   TEST_ASSERT_EQUAL_STRING("Disabled", ivAlarmArmedS);
+}
+
+// Each result type has its own setup screen, so the I/V alarm isn't shown on (or changed from) the temperature one
+void test_setup_screens_per_type(void) {
+   tapButton(5);
+   tapButton(SETUP_ALARM_BTN);
+   tapButton(23);
+   tapButton(6);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_TEMP_SETUP));
+   TEST_ASSERT_EQUAL_STRING("Disabled", curScreenPtr->getButtonLabel(SETUP_ALARM_BTN));
+   TEST_ASSERT_EQUAL_STRING("Enabled", getScreenPtr(SCREEN_IV_SETUP)->getButtonLabel(SETUP_ALARM_BTN));
+   tapButton(23);
+
+   tapButton(5);
+   tapButton(SETUP_ALARM_BTN);
+   tapButton(23);
+   TEST_ASSERT_EQUAL_STRING("Disabled", ivAlarmArmedS);
+   TEST_ASSERT_EQUAL_STRING("Disabled", tempAlarmArmedS);
+}
+
+// A-In max voltage range cycles 24 -> 3 -> 9 -> 24 on the A-In/D-In axis screen and is picked up on the way back
+void test_ad_ain_max_cycle(void) {
+   static const char * ranges[] = {"3.0", "9.0", "24.0"};
+   tapButton(9);
+   tapButton(20);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_AD_AXIS));
+   for(uint8_t i=0; i<3; i++) {
+      tapButton(7);
+      TEST_ASSERT_EQUAL_STRING(ranges[i], curScreenPtr->getButtonLabel(7));
+   }
+   tapButton(7);
+   tapButton(23);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_AD_SETUP));
+   TEST_ASSERT_FLOAT_WITHIN(0.001, 3.0, maxAinVoltage);
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+
+   UNITY_BEGIN();
+   RUN_TEST(test_dout_output_cycle);
+   RUN_TEST(test_dout_duty_cycle_from_keypad);
+   RUN_TEST(test_keypad_cancel);
+   RUN_TEST(test_dout_pwm_frequency_cycle);
+   RUN_TEST(test_manual_110v_relay);
+   RUN_TEST(test_110v_action_on_alarm_cycle);
+   RUN_TEST(test_stream_and_graph_mode);
+   RUN_TEST(test_iv_alarm_toggle_kept);
+   RUN_TEST(test_setup_screens_per_type);
+   RUN_TEST(test_ad_ain_max_cycle);
+   return(UNITY_END());
+}
@@ -0,0 +1,191 @@
+//#################################################################################################
+// MyTouchScreen graph clipping: segments running off the plot window are cut at its edges, not
+// dropped.  Each segment is graphed on its own and the trace pixels on the display are checked
+// against the same segment clipped exactly (Liang-Barsky, in doubles).
+//
+// The axes are one data unit per pixel, so data (x,y) is display pixel (GRAPH_X_ORIGIN + x,
+// GRAPH_Y_ORIGIN - y) and a segment can be given in display pixels.
+//#################################################################################################
+
+#include <nativeTest.h>
+#include <math.h>
+
+#define PLOT_W (GRAPH_X_RIGHT - GRAPH_X_ORIGIN)
+#define PLOT_H (GRAPH_Y_ORIGIN - GRAPH_Y_TOP)
+#define TRACE_TOLERANCE 2.0   // Pixels a trace pixel can be off the exact line (clip rounding)
+#define TRACE_COLOR TFT_GREEN  // Not used by the graph frame, so it picks out the trace even on the axes
+
+static MyTouchScreen * graph;
+
+// Graph xs,ys on one pixel per unit axes
+static void plotData(float * xs, float * ys, int points) {
+   graph->drawScreen();
+   graph->setXAxis(0, PLOT_W, 10, "X");
+   graph->setYAxis(0, PLOT_H, 10, "Y");
+   graph->setOverlayChannel(0, 0, PLOT_H, "Y", TRACE_COLOR);
+   graph->drawGraph(false, "", points, xs, ys, NULL);
+}
+
+// Graph the display pixel segment x0,y0 -> x1,y1
+static void plotPixels(double x0, double y0, double x1, double y1) {
+   float xs[2] = {(float)(x0 - GRAPH_X_ORIGIN), (float)(x1 - GRAPH_X_ORIGIN)};
+   float ys[2] = {(float)(GRAPH_Y_ORIGIN - y0), (float)(GRAPH_Y_ORIGIN - y1)};
+   plotData(xs, ys, 2);
+}
+
+static bool tracePixel(int x, int y) {
+   return(tft.getFramePixel(x, y) == TRACE_COLOR);
+}
+
+// Clip to the plot window.  False if none of the segment is on it.
+static bool referenceClip(double * x0, double * y0, double * x1, double * y1) {
+   double dx = *x1 - *x0;
+   double dy = *y1 - *y0;
+   double p[4] = {-dx, dx, -dy, dy};
+   double q[4] = {*x0 - GRAPH_X_ORIGIN, GRAPH_X_RIGHT - *x0, *y0 - GRAPH_Y_TOP, GRAPH_Y_ORIGIN - *y0};
+   double t0 = 0.0;
+   double t1 = 1.0;
+   for(int i=0; i<4; i++) {
+      if(p[i] == 0.0) {
+         if(q[i] < 0.0) {
+            return(false);
+         }
+      } else if(p[i] < 0.0) {
+         t0 = max(t0, q[i] / p[i]);
+      } else {
+         t1 = min(t1, q[i] / p[i]);
+      }
+   }
+   if(t0 > t1) {
+      return(false);
+   }
+   double sx = *x0;
+   double sy = *y0;
+   *x0 = sx + t0 * dx; *y0 = sy + t0 * dy;
+   *x1 = sx + t1 * dx; *y1 = sy + t1 * dy;
+   return(true);
+}
+
+static double distanceToSegment(double px, double py, double x0, double y0, double x1, double y1) {
+   double dx = x1 - x0;
+   double dy = y1 - y0;
+   double len2 = dx * dx + dy * dy;
+   double t = (len2 > 0.0) ? ((px - x0) * dx + (py - y0) * dy) / len2 : 0.0;
+   t = constrain(t, 0.0, 1.0);
+   return(hypot(px - (x0 + t * dx), py - (y0 + t * dy)));
+}
+
+// Is there a trace pixel within TRACE_TOLERANCE of x,y
+static bool traceNear(double x, double y) {
+   for(int py=GRAPH_Y_TOP; py<=GRAPH_Y_ORIGIN; py++) {
+      for(int px=GRAPH_X_ORIGIN; px<=GRAPH_X_RIGHT; px++) {
+         if(tracePixel(px, py) && hypot(px - x, py - y) <= TRACE_TOLERANCE) {
+            return(true);
+         }
+      }
+   }
+   return(false);
+}
+
+// Plot a segment and check what's on the display against the reference clip
+static void checkSegment(double x0, double y0, double x1, double y1) {
+   char msg[96];
+   snprintf(msg, sizeof(msg), "segment (%.0f,%.0f)->(%.0f,%.0f)", x0, y0, x1, y1);
+   plotPixels(x0, y0, x1, y1);
+
+   // A segment that misses the window can still leave a pixel or two on the border if it passes
+   // within the tolerance, so those are checked against the whole segment
+   double cx0 = x0, cy0 = y0, cx1 = x1, cy1 = y1;
+   bool visible = referenceClip(&cx0, &cy0, &cx1, &cy1);
+   int drawn = 0;
+   for(int py=GRAPH_Y_TOP; py<=GRAPH_Y_ORIGIN; py++) {
+      for(int px=GRAPH_X_ORIGIN; px<=GRAPH_X_RIGHT; px++) {
+         if(tracePixel(px, py)) {
+            drawn++;
+            TEST_ASSERT_TRUE_MESSAGE(distanceToSegment(px, py, cx0, cy0, cx1, cy1) <= TRACE_TOLERANCE, msg);
+         }
+      }
+   }
+   if(visible && hypot(cx1 - cx0, cy1 - cy0) > 2 * TRACE_TOLERANCE) {
+      TEST_ASSERT_TRUE_MESSAGE(drawn > 0, msg);
+      TEST_ASSERT_TRUE_MESSAGE(traceNear(cx0, cy0), msg);
+      TEST_ASSERT_TRUE_MESSAGE(traceNear(cx1, cy1), msg);
+   }
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// Nothing in the graph frame is drawn in the trace color
+void test_frame_has_no_trace_color(void) {
+   float none[1] = {0.0};
+   plotData(none, none, 0);
+   for(int y=0; y<SCREEN_HEIGHT; y++) {
+      for(int x=0; x<SCREEN_WIDTH; x++) {
+         TEST_ASSERT_FALSE(tracePixel(x, y));
+      }
+   }
+}
+
+// Both ends off the plot, crossing two corners' worth of edges.  These took more than four clip
+// passes (integer rounding near a corner) and used to be dropped.
+void test_segments_needing_extra_passes(void) {
+   checkSegment(8, 240, 534, 18);
+   checkSegment(633, 13, -48, 253);
+}
+
+void test_inside_and_one_end_out(void) {
+   checkSegment(100, 100, 300, 150);
+   checkSegment(200, 120, 600, 60);
+   checkSegment(200, 120, -300, 400);
+   checkSegment(200, 120, 200, -50);
+   checkSegment(200, 120, 20, 120);
+}
+
+void test_off_to_one_side_dropped(void) {
+   checkSegment(-50, 10, 40, 300);
+   checkSegment(460, 100, 700, 200);
+   checkSegment(100, 0, 400, 20);
+   checkSegment(100, 240, 400, 300);
+}
+
+// Points far off the plot are clamped before clipping without losing the line
+void test_far_off_points(void) {
+   float xs[2] = {-1.0e30, 1.0e30};
+   float ys[2] = {100.0, 100.0};
+   plotData(xs, ys, 2);
+   int y = GRAPH_Y_ORIGIN - 100;
+   TEST_ASSERT_TRUE(tracePixel(GRAPH_X_ORIGIN + 1, y));
+   TEST_ASSERT_TRUE(tracePixel((GRAPH_X_ORIGIN + GRAPH_X_RIGHT) / 2, y));
+   TEST_ASSERT_TRUE(tracePixel(GRAPH_X_RIGHT - 1, y));
+}
+
+// Random segments over and around the plot window
+void test_random_segments(void) {
+   uint32_t seed = 12345;
+   for(int i=0; i<2000; i++) {
+      double c[4];
+      for(int j=0; j<4; j++) {
+         seed = seed * 1664525UL + 1013904223UL;
+         c[j] = (seed >> 8) % 1000;   // Whole pixels, so only the clipper rounds
+      }
+      checkSegment(c[0] - 250, floor(c[1] * 0.7) - 200, c[2] - 250, floor(c[3] * 0.7) - 200);
+   }
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+   graph = getScreenPtr(SCREEN_IV_GRAPH);
+
+   UNITY_BEGIN();
+   RUN_TEST(test_frame_has_no_trace_color);
+   RUN_TEST(test_segments_needing_extra_passes);
+   RUN_TEST(test_inside_and_one_end_out);
+   RUN_TEST(test_off_to_one_side_dropped);
+   RUN_TEST(test_far_off_points);
+   RUN_TEST(test_random_segments);
+   return(UNITY_END());
+}
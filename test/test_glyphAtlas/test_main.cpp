@@ -0,0 +1,136 @@
+//#################################################################################################
+// MyGlyphAtlas against drawString: every value the atlas draws has to leave the result sprite the
+// same, pixel for pixel, as clearing the field and drawString'ing it with TEXT_FONT does (which is
+// what drawTextSprite() falls back to).
+//#################################################################################################
+
+#include <nativeTest.h>
+#include <MyGlyphAtlas.h>
+
+#define BOX_W TEXT_SP_WIDTH
+#define BOX_H TEXT_SP_HEIGHT
+
+static MyGlyphAtlas atlas;
+static TFT_eSprite atlasSprite = TFT_eSprite(&tft);
+static TFT_eSprite fontSprite = TFT_eSprite(&tft);
+static uint32_t seed = 1;
+
+static uint32_t nextRandom() {
+   seed = seed * 1664525UL + 1013904223UL;
+   return(seed >> 8);
+}
+
+// Same speckled background in both sprites, so clearing and clipping are checked too
+static void speckle() {
+   atlasSprite.fillSprite(TFT_BLACK);
+   fontSprite.fillSprite(TFT_BLACK);
+   for(int i=0; i<400; i++) {
+      uint32_t r = nextRandom();
+      int x = r % TEXT_SP_WIDTH;
+      int y = (r >> 8) % TEXT_COLUMN_HEIGHT;
+      atlasSprite.drawPixel(x, y, TFT_WHITE);
+      fontSprite.drawPixel(x, y, TFT_WHITE);
+   }
+}
+
+// The field drawn the drawString way (see drawTextSprite)
+static void fontDraw(const char * text, int boxX, int boxY) {
+   fontSprite.setViewport(boxX, boxY, BOX_W, BOX_H);
+   fontSprite.fillSprite(TFT_BLACK);
+   fontSprite.drawString(text, 0, 0, GFXFF);
+   fontSprite.resetViewport();
+}
+
+static int spritesDiffer() {
+   int differ = 0;
+   for(int y=0; y<TEXT_COLUMN_HEIGHT; y++) {
+      for(int x=0; x<TEXT_SP_WIDTH; x++) {
+         differ += (atlasSprite.readPixel(x, y) != fontSprite.readPixel(x, y));
+      }
+   }
+   return(differ);
+}
+
+// Draw text both ways in the box at boxX,boxY and compare the whole sprites
+static void checkText(const char * text, int boxX, int boxY) {
+   char msg[64];
+   snprintf(msg, sizeof(msg), "'%s' at %d,%d", text, boxX, boxY);
+   speckle();
+   TEST_ASSERT_TRUE_MESSAGE(atlas.drawString(&atlasSprite, text, boxX, boxY, BOX_W, BOX_H), msg);
+   fontDraw(text, boxX, boxY);
+   TEST_ASSERT_EQUAL_INT_MESSAGE(0, spritesDiffer(), msg);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_atlas_fits(void) {
+   TEST_ASSERT_TRUE(atlas.begin(TEXT_FONT, GLYPH_ATLAS_CHARS));
+   TEST_ASSERT_LESS_OR_EQUAL_UINT32(GLYPH_ATLAS_BYTES, atlas.getMemoryUsed());
+}
+
+// Each character on its own and all of them together
+void test_every_character(void) {
+   const char * chars = GLYPH_ATLAS_CHARS;
+   for(const char * p=chars; *p; p++) {
+      char text[2] = {*p, '\0'};
+      checkText(text, 0, 0);
+   }
+   checkText("-123.4", 0, 0);
+   checkText("+0.56789", 0, 0);
+}
+
+// The fields sit at every row of the result column
+void test_column_rows(void) {
+   for(int y=0; y + BOX_H <= TEXT_COLUMN_HEIGHT; y += 9) {
+      checkText(" 12.34", 0, y);
+   }
+}
+
+// Values as the logger formats them (dtostrf, FLOAT_STRING_WIDTH wide with 2 decimals), across the
+// ranges the sensors give
+void test_logged_values(void) {
+   char text[FLOAT_STRING_WIDTH + 1];
+   for(int i=0; i<2000; i++) {
+      float value = ((int32_t)(nextRandom() % 2000000) - 1000000) / 100.0;
+      dtostrf(value, FLOAT_STRING_WIDTH, 2, text);
+      checkText(text, 0, ((nextRandom() % 5) * 45) % (TEXT_COLUMN_HEIGHT - BOX_H + 1));
+   }
+}
+
+// Anything the atlas can't draw is left to drawString with the sprite untouched
+void test_refuses_without_drawing(void) {
+   speckle();
+   TEST_ASSERT_FALSE(atlas.drawString(&atlasSprite, "12.3V", 0, 0, BOX_W, BOX_H));
+   TEST_ASSERT_FALSE(atlas.drawString(&atlasSprite, "12345678901234567890", 0, 0, BOX_W, BOX_H));
+   TEST_ASSERT_FALSE(atlas.drawString(&atlasSprite, "1.0", 0, TEXT_COLUMN_HEIGHT - 1, BOX_W, BOX_H));
+   TEST_ASSERT_EQUAL_INT(0, spritesDiffer());
+
+   TFT_eSprite colorSprite = TFT_eSprite(&tft);
+   colorSprite.setColorDepth(8);
+   colorSprite.createSprite(BOX_W, BOX_H);
+   TEST_ASSERT_FALSE(atlas.drawString(&colorSprite, "1.0", 0, 0, BOX_W, BOX_H));
+   colorSprite.deleteSprite();
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+   atlasSprite.setColorDepth(1);
+   atlasSprite.createSprite(TEXT_SP_WIDTH, TEXT_COLUMN_HEIGHT);
+   fontSprite.setColorDepth(1);
+   fontSprite.createSprite(TEXT_SP_WIDTH, TEXT_COLUMN_HEIGHT);
+   fontSprite.setFreeFont(TEXT_FONT);
+   fontSprite.setTextColor(TFT_WHITE, TFT_BLACK);
+   fontSprite.setTextDatum(TEXT_DATUM);
+
+   UNITY_BEGIN();
+   RUN_TEST(test_atlas_fits);
+   RUN_TEST(test_every_character);
+   RUN_TEST(test_column_rows);
+   RUN_TEST(test_logged_values);
+   RUN_TEST(test_refuses_without_drawing);
+   return(UNITY_END());
+}
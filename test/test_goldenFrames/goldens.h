@@ -0,0 +1,33 @@
+//#################################################################################################
+// Framebuffer hashes the golden frame suite checks against.  Text is drawn with the FreeFonts from
+// the TFT_eSPI library, so each set is keyed by a hash of the fonts it was recorded with (a build
+// with other fonts has no set and prints one to paste in here, see test_main.cpp).
+//
+// Re-record a scene only after looking at the PNG the suite wrote for it and deciding the new
+// frame is the right one.
+//#################################################################################################
+
+#ifndef goldens_h
+#define goldens_h
+
+#include <stdint.h>
+
+struct goldenFrame {
+   uint32_t fonts;      // fontsHash() of the build the frame was recorded on
+   const char * scene;
+   uint32_t frame;      // frameHash() of the whole display
+};
+
+static const goldenFrame goldenFrames[] = {
+   {0x0529CB59, "mainMenu", 0x5398D3D5},
+   {0x0529CB59, "ivMenu", 0x97BEC0CD},
+   {0x0529CB59, "ivMonitorLogging", 0x2A834C11},
+   {0x0529CB59, "ivMonitorDone", 0xEA27B920},
+   {0x0529CB59, "graphFull", 0xD93C6710},
+   {0x0529CB59, "graphCursor", 0x1926E9B1},
+   {0x0529CB59, "graphStrip", 0x8FE04B59},
+   {0x0529CB59, "graphOverlay", 0x6ED9F8E4},
+   {0x0529CB59, "graphSplit", 0x0A587634},
+};
+
+#endif
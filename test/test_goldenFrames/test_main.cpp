@@ -0,0 +1,206 @@
+//#################################################################################################
+// Golden frames.  The screens a logging session goes through are drawn on the emulator and the whole
+// framebuffer is hashed and compared with the hash recorded in goldens.h, so any change to what
+// drawScreen(), drawGraph() or the text/clock/status sprites put on the display shows up here
+// pixel for pixel.
+//
+// A frame that doesn't match is saved as <scene>.png in the suite's SD card directory (the path is
+// printed) next to the new hash.  A build whose fonts have no recorded set prints the lines to add
+// to goldens.h and ignores the scenes instead of failing them.
+//#################################################################################################
+
+#include <nativeTest.h>
+#include <graphing.h>
+#include <menus.h>
+#include <results.h>
+#include <MyScreenCache.h>
+#include "goldens.h"
+
+#define PLOT_Y ((GRAPH_Y_TOP + GRAPH_Y_ORIGIN) / 2)   // Somewhere on the plot
+
+#if USE_SCREEN_CACHE
+extern MyScreenCache screenCache;
+#endif
+
+static const GFXfont * const fonts[] = {
+   &FreeSans9pt7b, &FreeSansBold9pt7b, &FreeSansBold12pt7b, &FreeSansOblique12pt7b, &FreeSans18pt7b
+};
+
+static uint32_t fnv1a(uint32_t hash, const void * data, size_t len) {
+   const uint8_t * bytes = (const uint8_t *)data;
+   for(size_t i=0; i<len; i++) {
+      hash = (hash ^ bytes[i]) * 16777619UL;
+   }
+   return(hash);
+}
+
+// Hash of the glyph tables and bitmaps of the fonts the display can draw with
+static uint32_t fontsHash() {
+   uint32_t hash = 2166136261UL;
+   for(size_t f=0; f<sizeof(fonts) / sizeof(fonts[0]); f++) {
+      const GFXfont * font = fonts[f];
+      uint32_t bitmapBytes = 0;
+      for(int c=0; c<=font->last - font->first; c++) {
+         const GFXglyph * glyph = &font->glyph[c];
+         uint8_t fields[] = {glyph->width, glyph->height, glyph->xAdvance, (uint8_t)glyph->xOffset, (uint8_t)glyph->yOffset};
+         hash = fnv1a(hash, fields, sizeof(fields));
+         bitmapBytes = max(bitmapBytes, (uint32_t)(glyph->bitmapOffset + (glyph->width * glyph->height + 7) / 8));
+      }
+      hash = fnv1a(hash, font->bitmap, bitmapBytes);
+      hash = fnv1a(hash, &font->yAdvance, sizeof(font->yAdvance));
+   }
+   return(hash);
+}
+
+static uint32_t frameHash() {
+   uint32_t hash = 2166136261UL;
+   for(int y=0; y<SCREEN_HEIGHT; y++) {
+      for(int x=0; x<SCREEN_WIDTH; x++) {
+         uint16_t pixel = tft.getFramePixel(x, y);
+         hash = fnv1a(hash, &pixel, sizeof(pixel));
+      }
+   }
+   return(hash);
+}
+
+// Any golden set recorded with these fonts
+static bool fontsRecorded(uint32_t fontHash) {
+   for(size_t i=0; i<sizeof(goldenFrames) / sizeof(goldenFrames[0]); i++) {
+      if(goldenFrames[i].fonts == fontHash) {
+         return(true);
+      }
+   }
+   return(false);
+}
+
+// Compare the display with the scene's golden frame
+static void checkFrame(const char * scene) {
+   uint32_t fontHash = fontsHash();
+   uint32_t hash = frameHash();
+   char line[160];
+
+   if(!fontsRecorded(fontHash)) {
+      snprintf(line, sizeof(line), "   {0x%08lX, \"%s\", 0x%08lX},", (unsigned long)fontHash, scene, (unsigned long)hash);
+      TEST_MESSAGE(line);
+      TEST_IGNORE_MESSAGE("No golden frames for these fonts, add the line above to goldens.h");
+   }
+   for(size_t i=0; i<sizeof(goldenFrames) / sizeof(goldenFrames[0]); i++) {
+      if(goldenFrames[i].fonts == fontHash && strcmp(goldenFrames[i].scene, scene) == 0) {
+         if(goldenFrames[i].frame == hash) {
+            return;
+         }
+         std::string png = sdRoot() + "/" + scene + ".png";
+         tft.savePNG(png.c_str());
+         snprintf(line, sizeof(line), "%s: frame 0x%08lX, golden 0x%08lX (see %s)", scene, (unsigned long)hash,
+                  (unsigned long)goldenFrames[i].frame, png.c_str());
+         TEST_FAIL_MESSAGE(line);
+      }
+   }
+   snprintf(line, sizeof(line), "%s has no golden frame: {0x%08lX, \"%s\", 0x%08lX},", scene, (unsigned long)fontHash,
+            scene, (unsigned long)hash);
+   TEST_FAIL_MESSAGE(line);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_main_menu(void) {
+   runFor(1000);
+   checkFrame("mainMenu");
+}
+
+void test_iv_menu(void) {
+   tapButton(5);
+   checkFrame("ivMenu");
+}
+
+// Results text sprite and the clock while logging
+void test_iv_monitor_logging(void) {
+   tapButton(21);
+   tapButton(MONITOR_START_BTN);
+   runFor(5000);
+   checkFrame("ivMonitorLogging");
+}
+
+// The session's end (status pop-up and the final results)
+void test_iv_monitor_done(void) {
+   runFor(60000);
+   TEST_ASSERT_FALSE(monitoringResults);
+   checkFrame("ivMonitorDone");
+}
+
+void test_graph_full(void) {
+   tapButton(20);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_IV_GRAPH));
+   checkFrame("graphFull");
+}
+
+void test_graph_cursor(void) {
+   tapAt(GRAPH_X_ORIGIN + 120, PLOT_Y);
+   TEST_ASSERT_GREATER_OR_EQUAL(0, curScreenPtr->getGraphCursorX());
+   checkFrame("graphCursor");
+   tapAt(curScreenPtr->getGraphCursorX(), PLOT_Y);
+   checkFrame("graphFull");
+}
+
+void test_graph_strip(void) {
+   tapButton(23);
+   tapButton(18);
+   TEST_ASSERT_EQUAL_STRING("ViewStrip", graphModeS);
+   tapButton(20);
+   checkFrame("graphStrip");
+}
+
+void test_graph_overlay(void) {
+   tapButton(23);
+   tapButton(18);
+   TEST_ASSERT_EQUAL_STRING("ViewOvrly", graphModeS);
+   tapButton(20);
+   checkFrame("graphOverlay");
+}
+
+void test_graph_split(void) {
+   tapButton(23);
+   tapButton(18);
+   TEST_ASSERT_EQUAL_STRING("ViewSplit", graphModeS);
+   tapButton(20);
+   checkFrame("graphSplit");
+}
+
+// A screen restored from the screen cache is the same frame as one drawn from scratch
+void test_cached_screen_matches_drawn(void) {
+#if USE_SCREEN_CACHE
+   tapButton(23);
+   MyTouchScreen::setScreenCache(NULL);
+   curScreenPtr->drawScreen();
+   uint32_t drawn = frameHash();
+   MyTouchScreen::setScreenCache(&screenCache);
+   curScreenPtr->drawScreen();
+   uint32_t hits = screenCache.getHits();
+   curScreenPtr->drawScreen();
+   TEST_ASSERT_EQUAL_UINT32(hits + 1, screenCache.getHits());
+   TEST_ASSERT_EQUAL_HEX32(drawn, frameHash());
+#else
+   TEST_IGNORE_MESSAGE("USE_SCREEN_CACHE is off");
+#endif
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+
+   UNITY_BEGIN();
+   RUN_TEST(test_main_menu);
+   RUN_TEST(test_iv_menu);
+   RUN_TEST(test_iv_monitor_logging);
+   RUN_TEST(test_iv_monitor_done);
+   RUN_TEST(test_graph_full);
+   RUN_TEST(test_graph_cursor);
+   RUN_TEST(test_graph_strip);
+   RUN_TEST(test_graph_overlay);
+   RUN_TEST(test_graph_split);
+   RUN_TEST(test_cached_screen_matches_drawn);
+   return(UNITY_END());
+}
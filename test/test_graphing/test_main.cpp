@@ -0,0 +1,219 @@
+//#################################################################################################
+// graphing.cpp: graph modes and X axis ranges, touch zoom/pan and the tap cursor, on a logged session.
+//#################################################################################################
+
+#include <nativeTest.h>
+#include <graphing.h>
+#include <menus.h>
+#include <results.h>
+
+#define PLOT_Y ((GRAPH_Y_TOP + GRAPH_Y_ORIGIN) / 2)        // Somewhere on the plot
+#define PAN_Y  ((GRAPH_Y_ORIGIN + GRAPH_PAN_Y_BOTTOM) / 2)  // Over the X axis labels
+
+// Touch at x0,y and slide to x1 before letting go
+static void drag(uint16_t x0, uint16_t x1, uint16_t y) {
+   halTouch(x0, y);
+   runFor(TEST_TAP_MS);
+   for(int x=x0; x != x1; x += (x1 > x0 ? 1 : -1) * 10) {
+      halTouch(x, y);
+      runFor(TOUCH_POLL_MS);
+   }
+   halTouch(x1, y);
+   runFor(TEST_TAP_MS);
+   halRelease();
+   runFor(TEST_TAP_MS);
+}
+
+// Range the graph's X axis covers
+static float axisMin() {
+   return(curScreenPtr->pixelToDataX(GRAPH_X_ORIGIN));
+}
+
+static float axisMax() {
+   return(curScreenPtr->pixelToDataX(GRAPH_X_RIGHT));
+}
+
+static bool sessionLogged = false;
+
+// A 1 minute I/V session for the graphs (logged by the first test that needs it)
+static void openIvMonitor() {
+   tapButton(5);
+   tapButton(21);
+   if(!sessionLogged) {
+      tapButton(MONITOR_START_BTN);
+      runFor(65000);
+      TEST_ASSERT_FALSE(monitoringResults);
+      sessionLogged = true;
+   }
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_IV_MONITOR));
+}
+
+// The session's current graph, at the full range
+static void openIvGraph() {
+   openIvMonitor();
+   tapButton(20);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_IV_GRAPH));
+}
+
+// Zoom in on a stretch in the first half of the plot
+static void zoomIn() {
+   drag(GRAPH_X_ORIGIN + 100, GRAPH_X_ORIGIN + 200, PLOT_Y);
+   TEST_ASSERT_TRUE(graphZoomed);
+}
+
+// Every test starts from the main menu with full graphs
+void setUp(void) {
+   strcpy(graphModeS, "ViewFull");
+   drawMainMenu(0);
+   runFor(TEST_TAP_MS);
+}
+
+void tearDown(void) {
+}
+
+void test_graph_mode_from_label(void) {
+   strcpy(graphModeS, "ViewStrip");
+   TEST_ASSERT_EQUAL(GRAPH_MODE_STRIP, curGraphMode());
+   TEST_ASSERT_FALSE(allChannelsView());
+   strcpy(graphModeS, "ViewOvrly");
+   TEST_ASSERT_EQUAL(GRAPH_MODE_OVERLAY, curGraphMode());
+   TEST_ASSERT_TRUE(allChannelsView());
+   strcpy(graphModeS, "ViewSplit");
+   TEST_ASSERT_EQUAL(GRAPH_MODE_SPLIT, curGraphMode());
+   TEST_ASSERT_TRUE(allChannelsView());
+   strcpy(graphModeS, "ViewFull");
+   TEST_ASSERT_EQUAL(GRAPH_MODE_FULL, curGraphMode());
+}
+
+// A full graph runs from 0 to the monitor duration
+void test_full_graph_spans_duration(void) {
+   openIvGraph();
+   TEST_ASSERT_EQUAL_STRING(resF0, currentlyGraphing);
+   TEST_ASSERT_FLOAT_WITHIN(0.01, 0.0, axisMin());
+   TEST_ASSERT_FLOAT_WITHIN(0.01, 1.0, axisMax());
+}
+
+// The graph screen's buttons switch between the session's results
+void test_graph_buttons_switch_result(void) {
+   openIvGraph();
+   tapButton(21);
+   TEST_ASSERT_EQUAL_STRING(resF1, currentlyGraphing);
+   tapButton(22);
+   TEST_ASSERT_EQUAL_STRING(resF2, currentlyGraphing);
+   tapButton(20);
+   TEST_ASSERT_EQUAL_STRING(resF0, currentlyGraphing);
+}
+
+// Dragging across the plot zooms in on the range between the two ends
+void test_drag_on_plot_zooms(void) {
+   openIvGraph();
+   uint16_t x0 = GRAPH_X_ORIGIN + 100;
+   uint16_t x1 = GRAPH_X_ORIGIN + 200;
+   float from = curScreenPtr->pixelToDataX(x0);
+   float to = curScreenPtr->pixelToDataX(x1);
+
+   drag(x0, x1, PLOT_Y);
+
+   TEST_ASSERT_TRUE(graphZoomed);
+   TEST_ASSERT_FLOAT_WITHIN(0.001, from, graphZoomMin);
+   TEST_ASSERT_FLOAT_WITHIN(0.001, to, graphZoomMax);
+   TEST_ASSERT_FLOAT_WITHIN(0.001, from, axisMin());
+   TEST_ASSERT_FLOAT_WITHIN(0.001, to, axisMax());
+}
+
+// The zoom is kept while switching results
+void test_zoom_kept_across_results(void) {
+   openIvGraph();
+   zoomIn();
+   float from = axisMin();
+   tapButton(21);
+   TEST_ASSERT_TRUE(graphZoomed);
+   TEST_ASSERT_FLOAT_WITHIN(0.001, from, axisMin());
+}
+
+// Coming back from the monitor screen starts over at the full range
+void test_zoom_dropped_from_monitor(void) {
+   openIvGraph();
+   zoomIn();
+   tapButton(23);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_IV_MONITOR));
+   tapButton(20);
+   TEST_ASSERT_FALSE(graphZoomed);
+   TEST_ASSERT_FLOAT_WITHIN(0.01, 0.0, axisMin());
+   TEST_ASSERT_FLOAT_WITHIN(0.01, 1.0, axisMax());
+}
+
+// Dragging along the X axis labels pans, dragging right goes back in time
+void test_drag_on_axis_pans(void) {
+   openIvGraph();
+   zoomIn();
+   float from = axisMin();
+   float width = axisMax() - axisMin();
+   float shift = curScreenPtr->pixelToDataX(GRAPH_X_ORIGIN + 150) - curScreenPtr->pixelToDataX(GRAPH_X_ORIGIN + 100);
+
+   drag(GRAPH_X_ORIGIN + 150, GRAPH_X_ORIGIN + 100, PAN_Y);
+
+   TEST_ASSERT_TRUE(graphZoomed);
+   TEST_ASSERT_FLOAT_WITHIN(0.001, from + shift, axisMin());
+   TEST_ASSERT_FLOAT_WITHIN(0.001, width, axisMax() - axisMin());
+}
+
+// A tap on the X axis labels goes back to the full range
+void test_tap_on_axis_unzooms(void) {
+   openIvGraph();
+   zoomIn();
+   tapAt(GRAPH_X_ORIGIN + 100, PAN_Y);
+   TEST_ASSERT_FALSE(graphZoomed);
+   TEST_ASSERT_FLOAT_WITHIN(0.01, 0.0, axisMin());
+   TEST_ASSERT_FLOAT_WITHIN(0.01, 1.0, axisMax());
+}
+
+// A tap on the plot puts the cursor on the nearest sample, a second tap takes it off
+void test_tap_on_plot_cursor(void) {
+   openIvGraph();
+   TEST_ASSERT_LESS_THAN(0, curScreenPtr->getGraphCursorX());
+   tapAt(GRAPH_X_ORIGIN + 120, PLOT_Y);
+   int cursorX = curScreenPtr->getGraphCursorX();
+   TEST_ASSERT_GREATER_OR_EQUAL(GRAPH_X_ORIGIN + 120 - 3, cursorX);
+   TEST_ASSERT_LESS_OR_EQUAL(GRAPH_X_ORIGIN + 120 + 3, cursorX);
+
+   tapAt(cursorX, PLOT_Y);
+   TEST_ASSERT_LESS_THAN(0, curScreenPtr->getGraphCursorX());
+}
+
+// A strip chart is the strip window wide (and slides to end at the newest sample)
+void test_strip_graph_spans_window(void) {
+   openIvMonitor();
+   tapButton(18);
+   TEST_ASSERT_EQUAL_STRING("ViewStrip", graphModeS);
+   tapButton(20);
+   TEST_ASSERT_FLOAT_WITHIN(0.01, stripWindow, axisMax() - axisMin());
+}
+
+// Overlay and split views graph all the channels of the session
+void test_overlay_view(void) {
+   openIvMonitor();
+   tapButton(18);
+   tapButton(18);
+   TEST_ASSERT_EQUAL_STRING("ViewOvrly", graphModeS);
+   tapButton(20);
+   TEST_ASSERT_EQUAL_STRING(GRAPH_OVERLAY, currentlyGraphing);
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+
+   UNITY_BEGIN();
+   RUN_TEST(test_graph_mode_from_label);
+   RUN_TEST(test_full_graph_spans_duration);
+   RUN_TEST(test_graph_buttons_switch_result);
+   RUN_TEST(test_drag_on_plot_zooms);
+   RUN_TEST(test_zoom_kept_across_results);
+   RUN_TEST(test_zoom_dropped_from_monitor);
+   RUN_TEST(test_drag_on_axis_pans);
+   RUN_TEST(test_tap_on_axis_unzooms);
+   RUN_TEST(test_tap_on_plot_cursor);
+   RUN_TEST(test_strip_graph_spans_window);
+   RUN_TEST(test_overlay_view);
+   return(UNITY_END());
+}
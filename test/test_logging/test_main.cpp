@@ -0,0 +1,244 @@
+//#################################################################################################
+// Logging path: start an I/V session from the touch screen and check what lands on the SD card.
+//#################################################################################################
+
+#include <nativeTest.h>
+#include <results.h>
+#include <menus.h>
+#include <vector>
+#include <algorithm>
+
+#define TEST_CURRENT_MA 12.5
+#define TEST_BUS_V 5.0
+
+// Parse "x,y" lines
+static std::vector<std::pair<float,float>> readCsv(const char * name) {
+   std::vector<std::pair<float,float>> rows;
+   std::string text = readSdFile(name);
+   size_t pos = 0;
+   while(pos < text.size()) {
+      size_t end = text.find('\n', pos);
+      if(end == std::string::npos) {
+         end = text.size();
+      }
+      float x, y;
+      if(sscanf(text.substr(pos, end - pos).c_str(), "%f,%f", &x, &y) == 2) {
+         rows.push_back(std::make_pair(x, y));
+      }
+      pos = end + 1;
+   }
+   return(rows);
+}
+
+// Main menu -> I/V -> Monitor -> StartLog
+static void startIvSession() {
+   tapButton(5);
+   tapButton(21);
+   tapButton(MONITOR_START_BTN);
+}
+
+// A whole I/V session (1 minute at the default settings)
+static void logIvSession() {
+   startIvSession();
+   runFor(65000);
+   TEST_ASSERT_FALSE(monitoringResults);
+}
+
+// Every test starts from the main menu with the default I/V settings and the signals pinned.  Session
+// files are named to the second, so each test also starts on a second of its own to get its own files.
+void setUp(void) {
+   halSetSignal(HAL_CURRENT_MA, TEST_CURRENT_MA);
+   halSetSignal(HAL_BUS_V, TEST_BUS_V);
+   strcpy(monitorIvIntervalS, ".01");
+   strcpy(monitorIvDurationS, "1");
+   drawMainMenu(0);
+   runFor(TEST_TAP_MS);
+   halAdvanceMicros((1000 - millis() % 1000) * 1000UL);
+}
+
+void tearDown(void) {
+   if(monitoringResults) {
+      monitorResults(22);
+   }
+   strcpy(curResType, "");
+}
+
+// The session's files are named for when it started
+void test_start_iv_session(void) {
+   tapButton(5);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_IV_SETUP));
+   tapButton(21);
+   TEST_ASSERT_TRUE(curScreenPtr == getScreenPtr(SCREEN_IV_MONITOR));
+   char stamp[DATE_LEN] = "YYYY-MM-DD_hh-mm-ss";
+   RTC.now().toString(stamp);
+   tapButton(MONITOR_START_BTN);
+
+   TEST_ASSERT_TRUE(monitoringResults);
+   TEST_ASSERT_EQUAL_STRING((std::string("/ivCurrent_") + stamp + ".csv").c_str(), resF0);
+   TEST_ASSERT_EQUAL_STRING((std::string("/ivVoltage_") + stamp + ".csv").c_str(), resF1);
+   TEST_ASSERT_EQUAL_STRING((std::string("/ivPower_") + stamp + ".csv").c_str(), resF2);
+   TEST_ASSERT_EQUAL_STRING("Restart", getScreenPtr(SCREEN_IV_MONITOR)->getButtonLabel(MONITOR_START_BTN));
+}
+
+// The result arrays go to the card each time they fill (MAX_RESULT_POINTS samples)
+void test_results_flushed_when_arrays_fill(void) {
+   startIvSession();
+   runFor(20000);   // .01 minute interval -> a sample every 600ms
+
+   TEST_ASSERT_TRUE(monitoringResults);
+   TEST_ASSERT_TRUE(resultArraysFilled);
+   std::vector<std::pair<float,float>> rows = readCsv(resF0);
+   TEST_ASSERT_EQUAL(MAX_RESULT_POINTS - 1, rows.size());
+   TEST_ASSERT_EQUAL(rows.size(), readCsv(resF1).size());
+   TEST_ASSERT_EQUAL(rows.size(), readCsv(resF2).size());
+}
+
+// Session runs for the monitor duration (1 minute), stops on its own and writes what's left
+void test_session_stops_after_duration(void) {
+   logIvSession();
+
+   TEST_ASSERT_EQUAL_STRING("StartLog", getScreenPtr(SCREEN_IV_MONITOR)->getButtonLabel(MONITOR_START_BTN));
+
+   std::vector<std::pair<float,float>> current = readCsv(resF0);
+   std::vector<std::pair<float,float>> voltage = readCsv(resF1);
+   std::vector<std::pair<float,float>> power = readCsv(resF2);
+
+   // About a sample every .01 minutes for a minute (each interval runs over by part of a loop pass)
+   TEST_ASSERT_GREATER_OR_EQUAL(90, current.size());
+   TEST_ASSERT_LESS_OR_EQUAL(102, current.size());
+   TEST_ASSERT_EQUAL(current.size(), voltage.size());
+   TEST_ASSERT_EQUAL(current.size(), power.size());
+
+   TEST_ASSERT_FLOAT_WITHIN(0.001, 0.0, current[0].first);
+   TEST_ASSERT_FLOAT_WITHIN(0.02, 1.0, current.back().first);
+   for(size_t i=0; i<current.size(); i++) {
+      if(i > 0) {
+         TEST_ASSERT_TRUE(current[i].first > current[i-1].first);
+      }
+      TEST_ASSERT_FLOAT_WITHIN(0.01, TEST_CURRENT_MA, current[i].second);
+      TEST_ASSERT_FLOAT_WITHIN(0.01, current[i].first, voltage[i].first);
+      TEST_ASSERT_FLOAT_WITHIN(0.01, current[i].first, power[i].first);
+   }
+}
+
+// Each results file gets its summary pyramid for the graph
+void test_pyramid_files_written(void) {
+   logIvSession();
+   std::string level = resF0;
+   level.replace(level.size() - 4, 4, ".p16");
+   TEST_ASSERT_TRUE(sdFileExists(level.c_str()));
+}
+
+// Summary records of one pyramid level file
+static std::vector<pyramidRecord> readLevel(const char * resultFile, uint8_t level) {
+   char name[TEXT_PLUS_DATE_LEN + 4];
+   MyResultPyramid::getLevelFileName(resultFile, level, name);
+   std::string bytes = readSdFile(name);
+   std::vector<pyramidRecord> recs(bytes.size() / sizeof(pyramidRecord));
+   memcpy(recs.data(), bytes.data(), recs.size() * sizeof(pyramidRecord));
+   return(recs);
+}
+
+// A few thousand samples (one every couple of loop passes) so every level gets full buckets and a part-filled last one.
+// Each record must summarize its rows of the raw CSV file and its rawEnd must land just past its last row.
+void test_pyramid_levels_match_raw_rows(void) {
+   halReleaseSignal(HAL_CURRENT_MA);
+   strcpy(monitorIvIntervalS, ".0001");
+   strcpy(monitorIvDurationS, "1.8");
+   drawIvMenu(0);
+   monitorResults(21);
+   runFor(115000);
+   TEST_ASSERT_FALSE(monitoringResults);
+
+   std::string text = readSdFile(resF0);
+   std::vector<std::pair<float,float>> rows = readCsv(resF0);
+   TEST_ASSERT_GREATER_THAN(PYRAMID_FANOUT * PYRAMID_FANOUT * PYRAMID_FANOUT, rows.size());
+   TEST_ASSERT_EQUAL_UINT32(rows.size(), resPyramid0.getSampleCount());
+
+   for(uint8_t level=0; level<PYRAMID_LEVELS; level++) {
+      uint32_t size = MyResultPyramid::getBucketSize(level);
+      std::vector<pyramidRecord> recs = readLevel(resF0, level);
+      TEST_ASSERT_EQUAL_UINT32((rows.size() + size - 1) / size, recs.size());
+
+      for(size_t r=0; r<recs.size(); r++) {
+         size_t first = r * size;
+         size_t last = std::min(first + size, rows.size()) - 1;
+         float minY = rows[first].second;
+         float maxY = rows[first].second;
+         double sum = 0.0;
+         for(size_t i=first; i<=last; i++) {
+            minY = std::min(minY, rows[i].second);
+            maxY = std::max(maxY, rows[i].second);
+            sum += rows[i].second;
+         }
+         // The CSV rows are rounded to two places, the records aren't
+         TEST_ASSERT_FLOAT_WITHIN(0.006, rows[first].first, recs[r].xFirst);
+         TEST_ASSERT_FLOAT_WITHIN(0.006, rows[last].first, recs[r].xLast);
+         TEST_ASSERT_FLOAT_WITHIN(0.006, minY, recs[r].minY);
+         TEST_ASSERT_FLOAT_WITHIN(0.006, maxY, recs[r].maxY);
+         TEST_ASSERT_FLOAT_WITHIN(0.006, sum / (last - first + 1), recs[r].meanY);
+
+         // Seeking to rawEnd puts us at the start of the row after the bucket
+         TEST_ASSERT_TRUE(recs[r].rawEnd <= text.size());
+         TEST_ASSERT_EQUAL('\n', text[recs[r].rawEnd - 1]);
+         TEST_ASSERT_EQUAL_UINT32(last + 1, std::count(text.begin(), text.begin() + recs[r].rawEnd, '\n'));
+      }
+   }
+
+   // Coarsest level that still gives the asked for number of buckets
+   uint32_t samples = rows.size();
+   TEST_ASSERT_EQUAL_INT(2, resPyramid0.getLevelForBuckets(1));
+   TEST_ASSERT_EQUAL_INT(1, resPyramid0.getLevelForBuckets(2));
+   TEST_ASSERT_EQUAL_INT(1, resPyramid0.getLevelForBuckets(samples / 256));
+   TEST_ASSERT_EQUAL_INT(0, resPyramid0.getLevelForBuckets(samples / 256 + 1));
+   TEST_ASSERT_EQUAL_INT(0, resPyramid0.getLevelForBuckets(samples / 16));
+   TEST_ASSERT_EQUAL_INT(-1, resPyramid0.getLevelForBuckets(samples / 16 + 1));
+}
+
+// A/D only logs two channels.  Its session must leave the third file (and pyramid) of the last I/V
+// session alone.
+void test_ad_session_leaves_third_channel_alone(void) {
+   logIvSession();
+   std::string power = resF2;
+   std::string powerLevel = power;
+   powerLevel.replace(powerLevel.size() - 4, 4, ".p16");
+   std::string powerRows = readSdFile(power.c_str());
+   std::string powerSummary = readSdFile(powerLevel.c_str());
+   TEST_ASSERT_TRUE(powerRows.size() > 0);
+   TEST_ASSERT_TRUE(powerSummary.size() > 0);
+
+   halAdvanceMicros(1000000UL);
+   drawAdMenu(0);
+   monitorResults(21);
+   TEST_ASSERT_EQUAL_STRING("", resF2);
+   runFor(70000);
+   TEST_ASSERT_FALSE(monitoringResults);
+   TEST_ASSERT_TRUE(readCsv(resF0).size() > MAX_RESULT_POINTS);
+
+   TEST_ASSERT_TRUE(powerRows == readSdFile(power.c_str()));
+   TEST_ASSERT_TRUE(powerSummary == readSdFile(powerLevel.c_str()));
+   TEST_ASSERT_FALSE(sdFileExists(".p16"));
+   TEST_ASSERT_EQUAL_UINT32(0, resPyramid2.getSampleCount());
+}
+
+// Nothing more is logged once stopped
+void test_nothing_logged_when_stopped(void) {
+   logIvSession();
+   size_t rows = readCsv(resF0).size();
+   runFor(5000);
+   TEST_ASSERT_EQUAL(rows, readCsv(resF0).size());
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+
+   UNITY_BEGIN();
+   RUN_TEST(test_start_iv_session);
+   RUN_TEST(test_results_flushed_when_arrays_fill);
+   RUN_TEST(test_session_stops_after_duration);
+   RUN_TEST(test_pyramid_files_written);
+   RUN_TEST(test_nothing_logged_when_stopped);
+   RUN_TEST(test_pyramid_levels_match_raw_rows);
+   RUN_TEST(test_ad_session_leaves_third_channel_alone);
+   return(UNITY_END());
+}
@@ -0,0 +1,182 @@
+//#################################################################################################
+// results.cpp: result file writing, the result text fields and starting/stopping a session.
+//#################################################################################################
+
+#include <nativeTest.h>
+#include <results.h>
+#include <menus.h>
+#include <graphing.h>
+
+// Session files are named to the second, so each test starts a second later to get its own
+void setUp(void) {
+   halAdvanceMicros(1000000UL);
+}
+
+void tearDown(void) {
+   if(monitoringResults) {
+      monitorResults(22);
+   }
+   strcpy(curResType, "");
+}
+
+// Filling the arrays writes all but the newest entry and moves that one to the front
+void test_write_partial_moves_last_to_front(void) {
+   float x[5] = {0.0, 0.1, 0.2, 0.3, 0.4};
+   float y[5] = {1.0, 2.0, 3.0, 4.0, 5.0};
+   MyResultPyramid pyramid;
+   pyramid.begin("/partial.csv");
+
+   writeResultsToFile(0, "/partial.csv", 5, x, y, &pyramid);
+
+   TEST_ASSERT_EQUAL_STRING("0.00,1.00\r\n0.10,2.00\r\n0.20,3.00\r\n0.30,4.00\r\n", readSdFile("/partial.csv").c_str());
+   TEST_ASSERT_FLOAT_WITHIN(0.0001, 0.4, x[0]);
+   TEST_ASSERT_FLOAT_WITHIN(0.0001, 5.0, y[0]);
+   TEST_ASSERT_EQUAL_UINT32(4, pyramid.getSampleCount());
+}
+
+// Stopping writes every entry, appending to what's there
+void test_write_all_appends(void) {
+   float x[2] = {0.5, 0.6};
+   float y[2] = {-1.25, 7.5};
+   MyResultPyramid pyramid;
+   pyramid.begin("/all.csv");
+
+   writeResultsToFile(1, "/all.csv", 2, x, y, &pyramid);
+   writeResultsToFile(1, "/all.csv", 2, x, y, &pyramid);
+
+   TEST_ASSERT_EQUAL_STRING("0.50,-1.25\r\n0.60,7.50\r\n0.50,-1.25\r\n0.60,7.50\r\n", readSdFile("/all.csv").c_str());
+   TEST_ASSERT_FLOAT_WITHIN(0.0001, 0.5, x[0]);
+}
+
+// A file that can't be opened is reported and nothing is touched
+void test_write_unopenable_file(void) {
+   float x[3] = {0.0, 0.1, 0.2};
+   float y[3] = {1.0, 2.0, 3.0};
+   MyResultPyramid pyramid;
+   pyramid.begin("");
+
+   writeResultsToFile(0, "/noSuchDir/r.csv", 3, x, y, &pyramid);
+
+   TEST_ASSERT_FALSE(sdFileExists("/noSuchDir/r.csv"));
+   TEST_ASSERT_FLOAT_WITHIN(0.0001, 0.0, x[0]);
+   TEST_ASSERT_EQUAL_UINT32(0, pyramid.getSampleCount());
+}
+
+// The result text fields show the readings to one decimal place
+void test_iv_result_fields(void) {
+   drawIvMenu(0);
+   current_mA = 12.34;
+   loadVoltage = 4.96;
+   power_mW = 61.2;
+   timeMonitored = 0.25;
+
+   drawIvResults();
+
+   TEST_ASSERT_EQUAL_STRING("12.3", current_mAS);
+   TEST_ASSERT_EQUAL_STRING("5.0", loadVoltageS);
+   TEST_ASSERT_EQUAL_STRING("61.2", power_mWS);
+   TEST_ASSERT_EQUAL_STRING("0.2", timeMonitoredS);
+}
+
+void test_temp_result_fields(void) {
+   drawTempMenu(0);
+   curProbeTemp = 71.06;
+   curModuleTemp = 68.0;
+   curModuleHumidity = 45.55;
+
+   drawTempResults();
+
+   TEST_ASSERT_EQUAL_STRING("71.1", curProbeTempS);
+   TEST_ASSERT_EQUAL_STRING("68.0", curModuleTempS);
+   TEST_ASSERT_EQUAL_STRING("45.5", curModuleHumidityS);
+}
+
+// Starting a session away from the monitor screen names the files after the result type and the RTC time
+void test_start_names_files_by_type(void) {
+   drawTempMenu(0);
+   drawTempGraph(20);
+   monitorResults(21);
+
+   TEST_ASSERT_TRUE(monitoringResults);
+   TEST_ASSERT_EQUAL_INT(0, resArrIdx);
+   TEST_ASSERT_FALSE(resultArraysFilled);
+   char expected[TEXT_PLUS_DATE_LEN];
+   strcpy(expected, "/probeTemp_");
+   strcat(expected, dateString[0]);
+   strcat(expected, ".csv");
+   TEST_ASSERT_EQUAL_STRING(expected, resF0);
+   TEST_ASSERT_EQUAL(0, strncmp(resF2, "/moduleHumidity_", 16));
+   TEST_ASSERT_EQUAL_STRING("Restart", getScreenPtr(SCREEN_TEMP_MONITOR)->getButtonLabel(MONITOR_START_BTN));
+}
+
+// updateResults logs a time-0 sample and then one per monitor interval
+void test_update_logs_per_interval(void) {
+   drawIvSetupMenu(0);
+   drawIvMenu(0);
+   monitorResults(21);
+   float interval = atof(getScreenPtr(SCREEN_IV_SETUP)->getButtonLabel(SETUP_INTERVAL_BTN));
+
+   current_mA = 3.0;
+   updateResults(SCREEN_IV_MONITOR, SCREEN_IV_GRAPH, "IV", SCREEN_IV_SETUP, resF0, resF1, resF2,
+                 &current_mA, &loadVoltage, &power_mW, drawIvResults);
+   TEST_ASSERT_EQUAL_INT(1, resArrIdx);
+   TEST_ASSERT_FLOAT_WITHIN(0.0001, 3.0, monitoredResultsYAxis0[0]);
+
+   // Not due yet
+   halAdvanceMicros(interval * 60000000UL / 2);
+   updateResults(SCREEN_IV_MONITOR, SCREEN_IV_GRAPH, "IV", SCREEN_IV_SETUP, resF0, resF1, resF2,
+                 &current_mA, &loadVoltage, &power_mW, drawIvResults);
+   TEST_ASSERT_EQUAL_INT(1, resArrIdx);
+
+   current_mA = 4.0;
+   halAdvanceMicros(interval * 60000000UL / 2 + 1000);
+   updateResults(SCREEN_IV_MONITOR, SCREEN_IV_GRAPH, "IV", SCREEN_IV_SETUP, resF0, resF1, resF2,
+                 &current_mA, &loadVoltage, &power_mW, drawIvResults);
+   TEST_ASSERT_EQUAL_INT(2, resArrIdx);
+   TEST_ASSERT_FLOAT_WITHIN(0.0001, 4.0, monitoredResultsYAxis0[1]);
+   TEST_ASSERT_FLOAT_WITHIN(0.001, interval, monitoredResultsXAxis0[1]);
+}
+
+// Results for another type than the one on screen are left alone
+void test_update_ignores_other_screen_type(void) {
+   drawIvMenu(0);
+   monitorResults(21);
+   updateResults(SCREEN_TEMP_MONITOR, SCREEN_TEMP_GRAPH, "TEMP", SCREEN_TEMP_SETUP, resF0, resF1, resF2,
+                 &curProbeTemp, &curModuleTemp, &curModuleHumidity, drawTempResults);
+   TEST_ASSERT_EQUAL_INT(0, resArrIdx);
+}
+
+// Stopping writes out what's in the arrays
+void test_stop_writes_remaining(void) {
+   drawIvSetupMenu(0);
+   drawIvMenu(0);
+   monitorResults(21);
+   current_mA = 9.0;
+   updateResults(SCREEN_IV_MONITOR, SCREEN_IV_GRAPH, "IV", SCREEN_IV_SETUP, resF0, resF1, resF2,
+                 &current_mA, &loadVoltage, &power_mW, drawIvResults);
+   char file[TEXT_PLUS_DATE_LEN];
+   strcpy(file, resF0);
+
+   monitorResults(22);
+
+   TEST_ASSERT_FALSE(monitoringResults);
+   TEST_ASSERT_EQUAL_INT(0, resArrIdx);
+   TEST_ASSERT_EQUAL_STRING("0.00,9.00\r\n", readSdFile(file).c_str());
+   TEST_ASSERT_EQUAL_STRING("StartLog", getScreenPtr(SCREEN_IV_MONITOR)->getButtonLabel(MONITOR_START_BTN));
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+
+   UNITY_BEGIN();
+   RUN_TEST(test_write_partial_moves_last_to_front);
+   RUN_TEST(test_write_all_appends);
+   RUN_TEST(test_write_unopenable_file);
+   RUN_TEST(test_iv_result_fields);
+   RUN_TEST(test_temp_result_fields);
+   RUN_TEST(test_start_names_files_by_type);
+   RUN_TEST(test_update_logs_per_interval);
+   RUN_TEST(test_update_ignores_other_screen_type);
+   RUN_TEST(test_stop_writes_remaining);
+   return(UNITY_END());
+}
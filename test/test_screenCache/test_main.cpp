@@ -0,0 +1,140 @@
+//#################################################################################################
+// MyScreenCache against the emulator's framebuffer: a restored screen is the captured one pixel for
+// pixel, it goes out a row at a time, and the pool drops the oldest images when it fills up.
+//#################################################################################################
+
+#include <nativeTest.h>
+#include <menus.h>
+#include <MyScreenCache.h>
+
+static MyScreenCache cache(&tft);
+static uint16_t saved[SCREEN_HEIGHT][SCREEN_WIDTH];
+
+static void saveFrame() {
+   for(int y=0; y<SCREEN_HEIGHT; y++) {
+      for(int x=0; x<SCREEN_WIDTH; x++) {
+         saved[y][x] = tft.getFramePixel(x, y);
+      }
+   }
+}
+
+// How many pixels differ from the saved frame
+static int frameDiffers() {
+   int differ = 0;
+   for(int y=0; y<SCREEN_HEIGHT; y++) {
+      for(int x=0; x<SCREEN_WIDTH; x++) {
+         differ += (saved[y][x] != tft.getFramePixel(x, y));
+      }
+   }
+   return(differ);
+}
+
+// A few flat colored blocks, different for each seed
+static void drawBlocks(uint32_t seed) {
+   static const uint16_t colors[] = {TFT_BLACK, TFT_WHITE, TFT_BLUE, TFT_YELLOW, TFT_RED, TFT_GREEN};
+   tft.fillScreen(TFT_NAVY);
+   for(int i=0; i<12; i++) {
+      seed = seed * 1664525UL + 1013904223UL;
+      tft.fillRect((seed >> 8) % SCREEN_WIDTH, (seed >> 16) % SCREEN_HEIGHT, 17 + i * 9, 11 + i * 5, colors[i % 6]);
+   }
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// The main menu comes back exactly, in one pushPixels per row
+void test_restore_is_pixel_exact(void) {
+   uint32_t fields[SCREEN_CACHE_FIELDS];
+   for(int i=0; i<SCREEN_CACHE_FIELDS; i++) {
+      fields[i] = 1000 + i;
+   }
+   drawMainMenu(0);
+   saveFrame();
+   TEST_ASSERT_TRUE(cache.capture(0x1234, fields));
+
+   tft.fillScreen(TFT_BLACK);
+   uint32_t got[SCREEN_CACHE_FIELDS] = {0};
+   tft.resetStats();
+   TEST_ASSERT_TRUE(cache.restore(0x1234, got));
+   tftStats stats = tft.getStats();
+
+   TEST_ASSERT_EQUAL_INT(0, frameDiffers());
+   TEST_ASSERT_EQUAL_UINT32(SCREEN_HEIGHT, stats.drawCalls);
+   TEST_ASSERT_EQUAL_UINT32(SCREEN_WIDTH * SCREEN_HEIGHT, stats.pixels);
+   TEST_ASSERT_EQUAL_UINT32_ARRAY(fields, got, SCREEN_CACHE_FIELDS);
+}
+
+// Restoring doesn't leave the display's byte order changed
+void test_restore_keeps_swap_bytes(void) {
+   uint32_t fields[SCREEN_CACHE_FIELDS];
+   tft.setSwapBytes(true);
+   TEST_ASSERT_TRUE(cache.restore(0x1234, fields));
+   TEST_ASSERT_TRUE(tft.getSwapBytes());
+   tft.setSwapBytes(false);
+   TEST_ASSERT_EQUAL_INT(0, frameDiffers());
+}
+
+void test_unknown_key_is_a_miss(void) {
+   uint32_t fields[SCREEN_CACHE_FIELDS];
+   uint32_t misses = cache.getMisses();
+   TEST_ASSERT_FALSE(cache.restore(0x9999, fields));
+   TEST_ASSERT_EQUAL_UINT32(misses + 1, cache.getMisses());
+}
+
+// More colors than the palette holds isn't cached
+void test_too_many_colors_not_cached(void) {
+   uint32_t fields[SCREEN_CACHE_FIELDS] = {0};
+   tft.fillScreen(TFT_BLACK);
+   for(int i=0; i<SCREEN_CACHE_COLORS + 1; i++) {
+      tft.fillRect(i * 20, 0, 20, 20, i * 0x0841);
+   }
+   TEST_ASSERT_FALSE(cache.capture(0x5678, fields));
+   TEST_ASSERT_FALSE(cache.restore(0x5678, fields));
+}
+
+// Running out of room (slots or pool) drops the least recently used images and keeps the newest
+void test_full_pool_drops_oldest(void) {
+   uint32_t fields[SCREEN_CACHE_FIELDS] = {0};
+   uint32_t key;
+   for(key=1; key<=40; key++) {
+      drawBlocks(key);
+      TEST_ASSERT_TRUE(cache.capture(key, fields));
+      TEST_ASSERT_LESS_OR_EQUAL_UINT32(SCREEN_CACHE_BYTES, cache.getMemoryUsed());
+   }
+   TEST_ASSERT_FALSE(cache.restore(1, fields));
+
+   drawBlocks(40);
+   saveFrame();
+   tft.fillScreen(TFT_BLACK);
+   TEST_ASSERT_TRUE(cache.restore(40, fields));
+   TEST_ASSERT_EQUAL_INT(0, frameDiffers());
+}
+
+// Capturing the same key again replaces the image
+void test_recapture_replaces(void) {
+   uint32_t fields[SCREEN_CACHE_FIELDS] = {0};
+   drawBlocks(77);
+   TEST_ASSERT_TRUE(cache.capture(500, fields));
+   drawBlocks(78);
+   saveFrame();
+   TEST_ASSERT_TRUE(cache.capture(500, fields));
+   tft.fillScreen(TFT_BLACK);
+   TEST_ASSERT_TRUE(cache.restore(500, fields));
+   TEST_ASSERT_EQUAL_INT(0, frameDiffers());
+}
+
+int main(int argc, char ** argv) {
+   nativeBegin();
+
+   UNITY_BEGIN();
+   RUN_TEST(test_restore_is_pixel_exact);
+   RUN_TEST(test_restore_keeps_swap_bytes);
+   RUN_TEST(test_unknown_key_is_a_miss);
+   RUN_TEST(test_too_many_colors_not_cached);
+   RUN_TEST(test_full_pool_drops_oldest);
+   RUN_TEST(test_recapture_replaces);
+   return(UNITY_END());
+}
@@ -0,0 +1,261 @@
+//#################################################################################################
+// The serial sample stream: streamFrame.h's frame packing, COBS and CRC-16 round tripped through the
+// receiver's decoder, and streamResults() on the fake serial port (what it puts on the wire, and that
+// a full TX buffer drops the frame rather than waiting on it).
+//#################################################################################################
+
+#include <unity.h>
+#include <nativeHal.h>
+#include <streaming.h>
+#include <string>
+
+static streamSample sample(uint32_t seq, float r0, float r1, float r2) {
+   streamSample s;
+   s.type = STREAM_TYPE_IV;
+   s.seq = seq;
+   s.timeMs = seq * 10;
+   s.result[0] = r0;
+   s.result[1] = r1;
+   s.result[2] = r2;
+   return(s);
+}
+
+// The bytes a frame goes out as (COBS encoded with its 0x00 delimiter)
+static std::string wireFrame(const streamSample & s) {
+   uint8_t raw[STREAM_RAW_LEN];
+   uint8_t wire[STREAM_WIRE_LEN];
+   streamPackFrame(&s, raw);
+   uint16_t len = streamCobsEncode(raw, STREAM_RAW_LEN, wire);
+   return(std::string((const char *)wire, len));
+}
+
+// Feed bytes to the decoder.  Returns the number of good frames, the last one in *last.
+static int decode(streamDecoder * d, const std::string & bytes, streamSample * last) {
+   int good = 0;
+   for(size_t i=0; i<bytes.size(); i++) {
+      if(streamDecodeByte(d, (uint8_t)bytes[i], last)) {
+         good++;
+      }
+   }
+   return(good);
+}
+
+static void assertSame(const streamSample & a, const streamSample & b) {
+   TEST_ASSERT_EQUAL_UINT8(a.type, b.type);
+   TEST_ASSERT_EQUAL_UINT32(a.seq, b.seq);
+   TEST_ASSERT_EQUAL_UINT32(a.timeMs, b.timeMs);
+   TEST_ASSERT_EQUAL_MEMORY(a.result, b.result, sizeof(a.result));
+}
+
+void setUp(void) {
+   halSetSerialTxRoom(-1);
+   halSerialCapture(true);
+   streamSeq = 0;
+   streamSentFrames = 0;
+   streamDroppedFrames = 0;
+}
+
+void tearDown(void) {
+   halSerialCapture(false);
+   halSetSerialTxRoom(-1);
+}
+
+void test_round_trip(void) {
+   streamSample in = sample(123456, -12.5, 4.981, 62.0625);
+   streamSample out;
+   streamDecoder d;
+   streamDecoderInit(&d, true);
+   std::string wire = wireFrame(in);
+   TEST_ASSERT_EQUAL_UINT32(STREAM_WIRE_LEN, wire.size());
+   TEST_ASSERT_EQUAL_INT(1, decode(&d, wire, &out));
+   assertSame(in, out);
+}
+
+// Zeros in the payload (sequence 0, 0.0 results) are encoded away, the delimiter is the only one left
+void test_payload_with_zeros(void) {
+   streamSample in = sample(0, 0.0, 0.0, 256.0);
+   streamSample out;
+   uint8_t raw[STREAM_RAW_LEN];
+   streamPackFrame(&in, raw);
+   TEST_ASSERT_NOT_NULL(memchr(raw, 0, STREAM_RAW_LEN));
+   std::string wire = wireFrame(in);
+   TEST_ASSERT_EQUAL_UINT32(wire.size() - 1, wire.find('\0'));
+
+   streamDecoder d;
+   streamDecoderInit(&d, true);
+   TEST_ASSERT_EQUAL_INT(1, decode(&d, wire, &out));
+   assertSame(in, out);
+}
+
+// COBS on its own: all zeros, no zeros, and runs long enough to need the 0xFF code
+void test_cobs_edge_cases(void) {
+   uint8_t in[600];
+   uint8_t wire[600 + 600/254 + 2];
+   uint8_t out[600];
+   const uint16_t lens[] = {1, 2, 253, 254, 255, 508, 600};
+   for(int pattern=0; pattern<3; pattern++) {
+      for(uint16_t len : lens) {
+         for(uint16_t i=0; i<len; i++) {
+            in[i] = pattern == 0 ? 0 : (pattern == 1 ? (i % 255) + 1 : i % 7);
+         }
+         uint16_t wireLen = streamCobsEncode(in, len, wire);
+         TEST_ASSERT_TRUE(wireLen <= len + len/254 + 2);
+         TEST_ASSERT_NULL(memchr(wire, 0, wireLen - 1));
+         TEST_ASSERT_EQUAL_UINT8(0, wire[wireLen - 1]);
+         TEST_ASSERT_EQUAL_INT(len, streamCobsDecode(wire, wireLen - 1, out, sizeof(out)));
+         TEST_ASSERT_EQUAL_MEMORY(in, out, len);
+      }
+   }
+}
+
+// Any single bit flipped in the frame is caught (by COBS or the CRC) and the next frame still decodes
+void test_corrupted_frame(void) {
+   streamSample in = sample(7, 1.5, 2.5, 3.75);
+   streamSample out;
+   std::string wire = wireFrame(in);
+   for(size_t byte=0; byte<wire.size() - 1; byte++) {
+      for(int bit=0; bit<8; bit++) {
+         std::string bad = wire;
+         bad[byte] ^= 1 << bit;
+         if(bad[byte] == 0) {
+            continue;    // A new delimiter splits the frame in two, both halves are then too short
+         }
+         streamDecoder d;
+         streamDecoderInit(&d, true);
+         TEST_ASSERT_EQUAL_INT(0, decode(&d, bad, &out));
+         TEST_ASSERT_EQUAL_UINT32(1, d.badFrames);
+         TEST_ASSERT_EQUAL_INT(1, decode(&d, wire, &out));
+         assertSame(in, out);
+      }
+   }
+}
+
+// Only the CRC bytes wrong
+void test_bad_crc(void) {
+   streamSample in = sample(8, 1.0, 2.0, 3.0);
+   streamSample out;
+   uint8_t raw[STREAM_RAW_LEN];
+   uint8_t wire[STREAM_WIRE_LEN];
+   streamPackFrame(&in, raw);
+   TEST_ASSERT_TRUE(streamUnpackFrame(raw, STREAM_RAW_LEN, &out));
+   raw[22] ^= 0x01;
+   TEST_ASSERT_FALSE(streamUnpackFrame(raw, STREAM_RAW_LEN, &out));
+   uint16_t len = streamCobsEncode(raw, STREAM_RAW_LEN, wire);
+
+   streamDecoder d;
+   streamDecoderInit(&d, true);
+   TEST_ASSERT_EQUAL_INT(0, decode(&d, std::string((const char *)wire, len), &out));
+   TEST_ASSERT_EQUAL_UINT32(1, d.badFrames);
+   TEST_ASSERT_EQUAL_UINT32(0, d.goodFrames);
+}
+
+// A frame cut short (bytes lost on the wire) is bad, and doesn't take the one after it down with it
+void test_truncated_frame(void) {
+   streamSample out;
+   std::string first = wireFrame(sample(1, 1.0, 1.0, 1.0));
+   std::string second = wireFrame(sample(2, 2.0, 2.0, 2.0));
+   for(size_t cut=1; cut<first.size() - 1; cut++) {
+      streamDecoder d;
+      streamDecoderInit(&d, true);
+      std::string lost = first.substr(0, first.size() - 1 - cut) + '\0';
+      TEST_ASSERT_EQUAL_INT(0, decode(&d, lost, &out));
+      TEST_ASSERT_EQUAL_INT(1, decode(&d, second, &out));
+      TEST_ASSERT_EQUAL_UINT32(2, out.seq);
+      TEST_ASSERT_EQUAL_UINT32(1, d.badFrames);
+   }
+}
+
+// A receiver that joins mid-stream skips up to the first delimiter.  Debug text mixed into the stream
+// (longer than any frame) is thrown away up to the next one.
+void test_resync(void) {
+   streamSample out;
+   std::string frame = wireFrame(sample(5, 5.0, 5.0, 5.0));
+   streamDecoder d;
+   streamDecoderInit(&d, false);
+   TEST_ASSERT_EQUAL_INT(1, decode(&d, frame.substr(10) + frame, &out));
+   TEST_ASSERT_EQUAL_UINT32(0, d.badFrames);
+   std::string text = "Frames: 120  Avg us: 1830  Max us: 4200  Over budget: 0\r\n";
+   TEST_ASSERT_EQUAL_INT(1, decode(&d, text + '\0' + frame, &out));
+   TEST_ASSERT_EQUAL_UINT32(1, d.badFrames);
+}
+
+// Missing sequence numbers are counted as dropped, a sequence going backwards as a restart
+void test_sequence_gap(void) {
+   streamSample out;
+   streamDecoder d;
+   streamDecoderInit(&d, true);
+   std::string wire = wireFrame(sample(10, 0, 0, 0)) + wireFrame(sample(11, 0, 0, 0)) +
+                      wireFrame(sample(15, 0, 0, 0)) + wireFrame(sample(16, 0, 0, 0));
+   TEST_ASSERT_EQUAL_INT(4, decode(&d, wire, &out));
+   TEST_ASSERT_EQUAL_UINT32(3, d.droppedFrames);
+   TEST_ASSERT_EQUAL_UINT32(0, d.restarts);
+
+   TEST_ASSERT_EQUAL_INT(1, decode(&d, wireFrame(sample(0, 0, 0, 0)), &out));
+   TEST_ASSERT_EQUAL_UINT32(3, d.droppedFrames);
+   TEST_ASSERT_EQUAL_UINT32(1, d.restarts);
+}
+
+// What streamResults() writes to the serial port decodes to the samples it was given
+void test_stream_results_on_the_wire(void) {
+   monitoringStartTime = millis();
+   halAdvanceMicros(250000);
+   streamResults("TEMP", 71.5, 22.25, 45.0);
+   streamResults("AD", 12.0, 1.5, 1.5);
+
+   streamSample out;
+   streamDecoder d;
+   streamDecoderInit(&d, true);
+   TEST_ASSERT_EQUAL_INT(1, decode(&d, halSerialOutput().substr(0, STREAM_WIRE_LEN), &out));
+   TEST_ASSERT_EQUAL_UINT8(STREAM_TYPE_TEMP, out.type);
+   TEST_ASSERT_EQUAL_UINT32(0, out.seq);
+   TEST_ASSERT_EQUAL_UINT32(250, out.timeMs);
+   TEST_ASSERT_EQUAL_FLOAT(22.25, out.result[1]);
+   TEST_ASSERT_EQUAL_INT(1, decode(&d, halSerialOutput().substr(STREAM_WIRE_LEN), &out));
+   TEST_ASSERT_EQUAL_UINT8(STREAM_TYPE_AD, out.type);
+   TEST_ASSERT_EQUAL_UINT32(1, out.seq);
+   TEST_ASSERT_EQUAL_UINT32(2, streamSentFrames);
+}
+
+// With no room for a whole frame nothing is written (no partial frame, no waiting), the frame is counted
+// as dropped and its sequence number is skipped so the receiver sees the gap
+void test_full_tx_buffer_drops_frame(void) {
+   halSetSerialTxRoom(STREAM_WIRE_LEN - 1);
+   streamResults("IV", 1.0, 2.0, 3.0);
+   TEST_ASSERT_EQUAL_UINT32(0, halSerialOutput().size());
+   TEST_ASSERT_EQUAL_UINT32(1, streamDroppedFrames);
+   TEST_ASSERT_EQUAL_UINT32(0, streamSentFrames);
+
+   halSetSerialTxRoom(STREAM_WIRE_LEN);
+   streamResults("IV", 1.0, 2.0, 3.0);
+   TEST_ASSERT_EQUAL_UINT32(STREAM_WIRE_LEN, halSerialOutput().size());
+   streamResults("IV", 1.0, 2.0, 3.0);
+   TEST_ASSERT_EQUAL_UINT32(2, streamDroppedFrames);
+
+   halSetSerialTxRoom(-1);
+   streamResults("IV", 1.0, 2.0, 3.0);
+   streamSample out;
+   streamDecoder d;
+   streamDecoderInit(&d, true);
+   TEST_ASSERT_EQUAL_INT(2, decode(&d, halSerialOutput(), &out));
+   TEST_ASSERT_EQUAL_UINT32(1, d.droppedFrames);
+
+   // Turning streaming off reports the counts and starts them over
+   streamEnd();
+   TEST_ASSERT_TRUE(halSerialOutput().find("dropped (TX buffer full): 2") != std::string::npos);
+   TEST_ASSERT_EQUAL_UINT32(0, streamDroppedFrames);
+}
+
+int main(int argc, char ** argv) {
+   UNITY_BEGIN();
+   RUN_TEST(test_round_trip);
+   RUN_TEST(test_payload_with_zeros);
+   RUN_TEST(test_cobs_edge_cases);
+   RUN_TEST(test_corrupted_frame);
+   RUN_TEST(test_bad_crc);
+   RUN_TEST(test_truncated_frame);
+   RUN_TEST(test_resync);
+   RUN_TEST(test_sequence_gap);
+   RUN_TEST(test_stream_results_on_the_wire);
+   RUN_TEST(test_full_tx_buffer_drops_frame);
+   return(UNITY_END());
+}
@@ -0,0 +1,18 @@
+// INA219 current/voltage module for the native build (readings from nativeHal, see nativeHal.h)
+
+#ifndef Adafruit_INA219_h
+#define Adafruit_INA219_h
+
+#include <Wire.h>
+
+class Adafruit_INA219 {
+   public:
+      Adafruit_INA219(uint8_t = 0x40) {}
+      bool begin(TwoWire * = &Wire) { return(true); }
+      float getShuntVoltage_mV();
+      float getBusVoltage_V();
+      float getCurrent_mA();
+      float getPower_mW();
+};
+
+#endif
@@ -0,0 +1,26 @@
+// DS18x20 temperature probe for the native build (readings from nativeHal, see nativeHal.h).
+// A conversion takes 750ms like the real 12-bit one, reads before then return the previous value.
+
+#ifndef DallasTemperature_h
+#define DallasTemperature_h
+
+#include <OneWire.h>
+
+#define DEVICE_DISCONNECTED_F -196.6
+
+class DallasTemperature {
+   public:
+      DallasTemperature(OneWire *) {}
+      void begin() {}
+      void setWaitForConversion(bool wait) { _wait = wait; }
+      void requestTemperatures();
+      float getTempFByIndex(uint8_t);
+   private:
+      bool _wait = true;
+      unsigned long _requestTime = 0;
+      float _tempF = DEVICE_DISCONNECTED_F;
+      float _pendingF = DEVICE_DISCONNECTED_F;
+      bool _pending = false;
+};
+
+#endif
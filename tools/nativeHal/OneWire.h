@@ -0,0 +1,15 @@
+// 1-Wire bus for the native build.  The DS18x20 fake (DallasTemperature.h) doesn't use it.
+
+#ifndef OneWire_h
+#define OneWire_h
+
+#include <Arduino.h>
+
+class OneWire {
+   public:
+      OneWire(uint8_t pin) : _pin(pin) {}
+   private:
+      uint8_t _pin;
+};
+
+#endif
@@ -0,0 +1,34 @@
+// DS1307 real time clock for the native build.  Runs off the nativeHal clock (see nativeHal.h).
+
+#ifndef RTClib_h
+#define RTClib_h
+
+#include <Wire.h>
+
+class DateTime {
+   public:
+      DateTime(uint32_t t = 946684800);   // 2000-01-01 00:00:00
+      DateTime(uint16_t, uint8_t, uint8_t, uint8_t hour = 0, uint8_t min = 0, uint8_t sec = 0);
+      DateTime(const char *, const char *);   // __DATE__, __TIME__
+      uint16_t year() const { return(_y); }
+      uint8_t month() const { return(_m); }
+      uint8_t day() const { return(_d); }
+      uint8_t hour() const { return(_hh); }
+      uint8_t minute() const { return(_mm); }
+      uint8_t second() const { return(_ss); }
+      uint32_t unixtime() const;
+      char * toString(char *);   // YYYY YY MM DD hh mm ss in the buffer are replaced
+   private:
+      uint16_t _y;
+      uint8_t _m, _d, _hh, _mm, _ss;
+};
+
+class RTC_DS1307 {
+   public:
+      bool begin(TwoWire * = &Wire) { return(true); }
+      bool isrunning() { return(true); }
+      void adjust(const DateTime &);
+      DateTime now();
+};
+
+#endif
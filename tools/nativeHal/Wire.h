@@ -0,0 +1,22 @@
+// I2C bus for the native build.  The INA219 and RTC fakes don't go through it, so there is nothing
+// on the bus and every transfer is NACKed.
+
+#ifndef Wire_h
+#define Wire_h
+
+#include <Arduino.h>
+
+class TwoWire {
+   public:
+      bool begin() { return(true); }
+      void setClock(uint32_t) {}
+      void beginTransmission(uint8_t) {}
+      size_t write(uint8_t) { return(1); }
+      uint8_t endTransmission(bool = true) { return(2); }   // Address NACK
+      uint8_t requestFrom(uint8_t, uint8_t) { return(0); }
+      int available() { return(0); }
+      int read() { return(-1); }
+};
+extern TwoWire Wire;
+
+#endif
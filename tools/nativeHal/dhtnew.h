@@ -0,0 +1,21 @@
+// DHT temperature/humidity module for the native build (readings from nativeHal, see nativeHal.h)
+
+#ifndef dhtnew_h
+#define dhtnew_h
+
+#include <Arduino.h>
+
+#define DHTLIB_OK 0
+
+class DHTNEW {
+   public:
+      DHTNEW(uint8_t) {}
+      int read();
+      float getTemperature() { return(_temperature); }
+      float getHumidity() { return(_humidity); }
+   private:
+      float _temperature = 0;
+      float _humidity = 0;
+};
+
+#endif
@@ -0,0 +1,157 @@
+// I2C, INA219, DS18x20, DHT and RTC fakes for the native build (see nativeHal.h)
+
+#include <nativeHal.h>
+#include <Wire.h>
+#include <Adafruit_INA219.h>
+#include <DallasTemperature.h>
+#include <dhtnew.h>
+#include <RTClib.h>
+
+TwoWire Wire;
+
+//###############################################################################
+// INA219.  0.1 ohm shunt like the Adafruit breakout.
+//###############################################################################
+float Adafruit_INA219::getShuntVoltage_mV() {
+   return(halGetSignal(HAL_CURRENT_MA) * 0.1);
+}
+
+float Adafruit_INA219::getBusVoltage_V() {
+   return(halGetSignal(HAL_BUS_V));
+}
+
+float Adafruit_INA219::getCurrent_mA() {
+   return(halGetSignal(HAL_CURRENT_MA));
+}
+
+float Adafruit_INA219::getPower_mW() {
+   return(halGetSignal(HAL_CURRENT_MA) * halGetSignal(HAL_BUS_V));
+}
+
+//###############################################################################
+// DS18x20
+//###############################################################################
+#define DS18X20_CONVERSION_MS 750
+
+void DallasTemperature::requestTemperatures() {
+   _pendingF = halGetSignal(HAL_PROBE_F);
+   _pending = true;
+   _requestTime = millis();
+   if(_wait) {
+      delay(DS18X20_CONVERSION_MS);
+   }
+}
+
+float DallasTemperature::getTempFByIndex(uint8_t index) {
+   if(index != 0) {
+      return(DEVICE_DISCONNECTED_F);
+   }
+   if(_pending && millis() - _requestTime >= DS18X20_CONVERSION_MS) {
+      _tempF = _pendingF;
+      _pending = false;
+   }
+   return(_tempF);
+}
+
+//###############################################################################
+// DHT
+//###############################################################################
+int DHTNEW::read() {
+   _temperature = halGetSignal(HAL_MODULE_C);
+   _humidity = halGetSignal(HAL_HUMIDITY);
+   return(DHTLIB_OK);
+}
+
+//###############################################################################
+// RTC.  Keeps the offset from the fake clock so it ticks along with millis().
+//###############################################################################
+static uint32_t rtcEpoch = 1704067200;   // 2024-01-01 00:00:00
+
+void halSetRtcEpoch(uint32_t epoch) {
+   rtcEpoch = epoch;
+}
+
+void RTC_DS1307::adjust(const DateTime & dt) {
+   rtcEpoch = dt.unixtime() - millis() / 1000;
+}
+
+DateTime RTC_DS1307::now() {
+   return(DateTime(rtcEpoch + millis() / 1000));
+}
+
+// Days from 1970-01-01 to y-m-d and back (proleptic Gregorian)
+static int32_t daysFromCivil(int32_t y, uint32_t m, uint32_t d) {
+   y -= m <= 2;
+   int32_t era = (y >= 0 ? y : y - 399) / 400;
+   uint32_t yoe = y - era * 400;
+   uint32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+   uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+   return(era * 146097 + doe - 719468);
+}
+
+DateTime::DateTime(uint32_t t) {
+   int32_t z = t / 86400 + 719468;
+   int32_t era = z / 146097;
+   uint32_t doe = z - era * 146097;
+   uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+   uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+   uint32_t mp = (5 * doy + 2) / 153;
+   _d = doy - (153 * mp + 2) / 5 + 1;
+   _m = mp < 10 ? mp + 3 : mp - 9;
+   _y = yoe + era * 400 + (_m <= 2);
+   _hh = (t / 3600) % 24;
+   _mm = (t / 60) % 60;
+   _ss = t % 60;
+}
+
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t min, uint8_t sec) {
+   _y = (year < 100) ? year + 2000 : year;
+   _m = month;
+   _d = day;
+   _hh = hour;
+   _mm = min;
+   _ss = sec;
+}
+
+// "Jan  1 2024", "12:34:56"
+DateTime::DateTime(const char * date, const char * time) {
+   static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+   _m = 1;
+   for(uint8_t i=0; i<12; i++) {
+      if(!strncmp(date, months + i * 3, 3)) {
+         _m = i + 1;
+      }
+   }
+   _d = atoi(date + 4);
+   _y = atoi(date + 7);
+   _hh = atoi(time);
+   _mm = atoi(time + 3);
+   _ss = atoi(time + 6);
+}
+
+uint32_t DateTime::unixtime() const {
+   return(daysFromCivil(_y, _m, _d) * 86400UL + _hh * 3600UL + _mm * 60UL + _ss);
+}
+
+static void replaceField(char * buf, const char * token, uint16_t value, uint8_t digits) {
+   char * p = strstr(buf, token);
+   if(p) {
+      char field[6];   // Any uint16_t, zero padded to 5 digits (the token takes the low ones)
+      snprintf(field, sizeof(field), "%05u", value);
+      memcpy(p, field + 5 - digits, digits);
+   }
+}
+
+char * DateTime::toString(char * buf) {
+   if(strstr(buf, "YYYY")) {
+      replaceField(buf, "YYYY", _y, 4);
+   } else {
+      replaceField(buf, "YY", _y % 100, 2);
+   }
+   replaceField(buf, "MM", _m, 2);
+   replaceField(buf, "DD", _d, 2);
+   replaceField(buf, "hh", _hh, 2);
+   replaceField(buf, "mm", _mm, 2);
+   replaceField(buf, "ss", _ss, 2);
+   return(buf);
+}
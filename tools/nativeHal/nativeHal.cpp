@@ -0,0 +1,220 @@
+// Clock, GPIO, ADC, PWM and chip info fakes for the native build (see nativeHal.h)
+
+#include <nativeHal.h>
+#include <main.h>
+
+//###############################################################################
+// Clock.  Only moves when we move it.
+//###############################################################################
+static unsigned long fakeMicros = 0;
+
+void halAdvanceMicros(unsigned long us) {
+   fakeMicros += us;
+}
+
+void halSetMicros(unsigned long us) {
+   fakeMicros = us;
+}
+
+unsigned long micros() {
+   return(fakeMicros);
+}
+
+unsigned long millis() {
+   return(fakeMicros / 1000);
+}
+
+void delay(unsigned long ms) {
+   fakeMicros += ms * 1000;
+}
+
+//###############################################################################
+// Sensor waveforms.  Slow sines so a logging run sees values move (and cross 
+// alarm limits) the same way every time.
+//###############################################################################
+static boolean signalPinned[HAL_SIGNALS];
+static float signalValue[HAL_SIGNALS];
+
+void halSetSignal(halSignal s, float value) {
+   signalPinned[s] = true;
+   signalValue[s] = value;
+}
+
+void halReleaseSignal(halSignal s) {
+   signalPinned[s] = false;
+}
+
+static float wave(float mid, float amplitude, float periodSec) {
+   return(mid + amplitude * sin(2.0 * M_PI * (fakeMicros / 1000000.0) / periodSec));
+}
+
+float halGetSignal(halSignal s) {
+   if(signalPinned[s]) {
+      return(signalValue[s]);
+   }
+   switch(s) {
+      case HAL_CURRENT_MA: return(wave(100.0, 50.0, 60.0));
+      case HAL_BUS_V:      return(5.0 - halGetSignal(HAL_CURRENT_MA) / 2000.0);   // A little sag under load
+      case HAL_PROBE_F:    return(wave(72.0, 4.0, 600.0));
+      case HAL_MODULE_C:   return(wave(22.0, 1.5, 900.0));
+      case HAL_HUMIDITY:   return(wave(45.0, 8.0, 450.0));
+      case HAL_AIN_MV:     return(wave(1500.0, 1000.0, 120.0));
+      default:             return(0.0);
+   }
+}
+
+//###############################################################################
+// GPIO.  Undriven inputs read high (pulled up) apart from D-In, which toggles 
+// once a second so the counter has something to count.
+//###############################################################################
+static uint8_t pinLevel[HAL_PINS];
+static boolean pinDriven[HAL_PINS];
+static void (*pinIsr[HAL_PINS])(void);
+static int pinIsrMode[HAL_PINS];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+   if(pin < HAL_PINS && mode == INPUT_PULLUP && !pinDriven[pin]) {
+      pinLevel[pin] = HIGH;
+   }
+}
+
+int digitalRead(uint8_t pin) {
+   if(pin >= HAL_PINS) {
+      return(LOW);
+   }
+   if(pin == DINPIN && !pinDriven[pin]) {
+      return((millis() / 1000) & 1 ? LOW : HIGH);
+   }
+   return(pinDriven[pin] ? pinLevel[pin] : HIGH);
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+   if(pin < HAL_PINS) {
+      pinLevel[pin] = level;
+   }
+}
+
+int digitalPinToInterrupt(int pin) {
+   return(pin);
+}
+
+void attachInterrupt(int irq, void (*isr)(void), int mode) {
+   if(irq >= 0 && irq < HAL_PINS) {
+      pinIsr[irq] = isr;
+      pinIsrMode[irq] = mode;
+   }
+}
+
+void halSetPin(uint8_t pin, uint8_t level) {
+   if(pin >= HAL_PINS) {
+      return;
+   }
+   uint8_t prev = digitalRead(pin);
+   pinDriven[pin] = true;
+   pinLevel[pin] = level;
+   if(pinIsr[pin] && prev != level) {
+      int mode = pinIsrMode[pin];
+      if(mode == CHANGE || (mode == FALLING && level == LOW) || (mode == RISING && level == HIGH)) {
+         pinIsr[pin]();
+      }
+   }
+}
+
+uint8_t halGetPin(uint8_t pin) {
+   return(pin < HAL_PINS ? pinLevel[pin] : LOW);
+}
+
+//###############################################################################
+// ADC.  Only the analog input pin is connected to anything.
+//###############################################################################
+uint32_t analogReadMilliVolts(uint8_t pin) {
+   if(pin != AINPIN) {
+      return(0);
+   }
+   return((uint32_t)constrain(halGetSignal(HAL_AIN_MV), 0.0f, 3300.0f));
+}
+
+//###############################################################################
+// PWM (ledc)
+//###############################################################################
+static uint32_t pwmDuty[HAL_PWM_CHANNELS];
+static int8_t pwmPinChannel[HAL_PINS];
+static boolean pwmInit = false;
+
+static void pwmSetup() {
+   if(!pwmInit) {
+      memset(pwmPinChannel, -1, sizeof(pwmPinChannel));
+      pwmInit = true;
+   }
+}
+
+double ledcSetup(uint8_t, double freq, uint8_t) {
+   return(freq);
+}
+
+void ledcAttachPin(uint8_t pin, uint8_t channel) {
+   pwmSetup();
+   if(pin < HAL_PINS) {
+      pwmPinChannel[pin] = channel;
+   }
+}
+
+void ledcDetachPin(uint8_t pin) {
+   pwmSetup();
+   if(pin < HAL_PINS) {
+      pwmPinChannel[pin] = -1;
+   }
+}
+
+void ledcWrite(uint8_t channel, uint32_t duty) {
+   if(channel < HAL_PWM_CHANNELS) {
+      pwmDuty[channel] = duty;
+   }
+}
+
+uint32_t halGetPwm(uint8_t channel) {
+   return(channel < HAL_PWM_CHANNELS ? pwmDuty[channel] : 0);
+}
+
+int8_t halGetPwmChannel(uint8_t pin) {
+   pwmSetup();
+   return(pin < HAL_PINS ? pwmPinChannel[pin] : -1);
+}
+
+//###############################################################################
+// Chip info (an ESP32 at its usual clocks with the heap it has after boot)
+//###############################################################################
+uint32_t getCpuFrequencyMhz() {
+   return(240);
+}
+
+uint32_t getXtalFrequencyMhz() {
+   return(40);
+}
+
+uint32_t getApbFrequency() {
+   return(80000000);
+}
+
+uint32_t esp_get_free_heap_size() {
+   return(200000);
+}
+
+uint32_t esp_get_minimum_free_heap_size() {
+   return(200000);
+}
+
+//###############################################################################
+// Serial port (the fake itself is in tools/tftEmulator/Arduino.h)
+//###############################################################################
+void halSerialCapture(boolean on) {
+   Serial.hostCapture(on);
+}
+
+const std::string & halSerialOutput() {
+   return(Serial.hostCaptured());
+}
+
+void halSetSerialTxRoom(int bytes) {
+   Serial.hostSetTxRoom(bytes);
+}
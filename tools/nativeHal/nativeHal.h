@@ -0,0 +1,57 @@
+//#################################################################################################
+// Native (Linux) stand-ins for the data logger's hardware.  See README.md.
+//
+// Everything is deterministic.  Time only moves when halAdvanceMicros() (or delay()) moves it, and
+// each sensor reads a fixed waveform of that time (see nativeHal.cpp) unless a test pins it to a
+// value with halSetSignal().  Outputs (relay, D-Out level/PWM) are recorded so they can be checked.
+//#################################################################################################
+
+#ifndef nativeHal_h
+#define nativeHal_h
+
+#include <Arduino.h>
+
+#define HAL_PINS 40            // ESP32 GPIO0-39
+#define HAL_PWM_CHANNELS 16
+
+// The sensor readings the fakes produce
+enum halSignal {
+   HAL_CURRENT_MA,      // INA219 load current
+   HAL_BUS_V,           // INA219 bus voltage
+   HAL_PROBE_F,         // DS18x20 probe temperature
+   HAL_MODULE_C,        // DHT module temperature
+   HAL_HUMIDITY,        // DHT module humidity
+   HAL_AIN_MV,          // ADC input (at the pin, before the divider)
+   HAL_SIGNALS
+};
+
+// Clock
+void halAdvanceMicros(unsigned long);
+void halSetMicros(unsigned long);
+
+// Sensors.  halSetSignal pins a reading to a value, halReleaseSignal puts it back on its waveform.
+void halSetSignal(halSignal, float);
+void halReleaseSignal(halSignal);
+float halGetSignal(halSignal);
+
+// GPIO.  Inputs are driven with halSetPin (an edge calls any attached interrupt), outputs read
+// back with halGetPin.  D-In (DINPIN) toggles once a second on its own until halSetPin drives it.
+void halSetPin(uint8_t, uint8_t);
+uint8_t halGetPin(uint8_t);
+uint32_t halGetPwm(uint8_t);          // Last ledcWrite() duty on a channel
+int8_t halGetPwmChannel(uint8_t);     // Channel attached to a pin (-1 if none)
+
+// Touch panel.  A press at x,y until released.
+void halTouch(uint16_t, uint16_t);
+void halRelease();
+
+// Serial port.  halSerialCapture keeps what's written (instead of printing it) for halSerialOutput,
+// halSetSerialTxRoom leaves only that many bytes free in the TX buffer (-1 = never full).
+void halSerialCapture(boolean);
+const std::string & halSerialOutput();
+void halSetSerialTxRoom(int);
+
+// Seconds since 1970 the RTC reads at time 0 (2024-01-01 00:00:00 by default)
+void halSetRtcEpoch(uint32_t);
+
+#endif
@@ -0,0 +1,110 @@
+//#################################################################################################
+// Runs the data logger sketch on Linux: setup() and then loop() on the fake clock (see README.md).
+//
+// Usage: ESP32_datalogger_class [loops] [loopMs] [outDir] [tap:<ms>:<x>:<y> ...]
+//
+//    loops    loop() passes to run (default 1000)
+//    loopMs   fake time added after each pass, on top of any delay() in the pass (default 10)
+//    outDir   where the final screen is saved as screen.png (default: not saved)
+//    tap      touch the screen at x,y for TAP_MS, <ms> of fake time after setup() returns
+//
+// At the end it prints the host time per loop() pass and the display traffic per pass, which is
+// what the screen/sampling optimizations are measured with.
+//#################################################################################################
+
+#include <nativeHal.h>
+#include <TFT_eSPI.h>
+#include <chrono>
+#include <vector>
+
+#define TAP_MS 100   // Long enough for a few TOUCH_POLL_MS reads
+
+extern TFT_eSPI tft;
+
+void halTouch(uint16_t x, uint16_t y) {
+   tft.setHostTouch(true, x, y);
+}
+
+void halRelease() {
+   tft.setHostTouch(false);
+}
+
+// Unit tests bring their own main()
+#ifndef UNIT_TEST
+
+struct tap {
+   unsigned long ms;
+   uint16_t x;
+   uint16_t y;
+};
+
+int main(int argc, char ** argv) {
+   unsigned long loops = 1000;
+   unsigned long loopMs = 10;
+   const char * outDir = NULL;
+   std::vector<tap> taps;
+
+   uint8_t positional = 0;
+   for(int i=1; i<argc; i++) {
+      tap t;
+      unsigned int x, y;
+      if(sscanf(argv[i], "tap:%lu:%u:%u", &t.ms, &x, &y) == 3) {
+         t.x = x;
+         t.y = y;
+         taps.push_back(t);
+      } else if(positional == 0) {
+         loops = strtoul(argv[i], NULL, 10);
+         positional++;
+      } else if(positional == 1) {
+         loopMs = strtoul(argv[i], NULL, 10);
+         positional++;
+      } else {
+         outDir = argv[i];
+      }
+   }
+
+   setup();
+
+   unsigned long hostUs = 0;
+   unsigned long maxUs = 0;
+   unsigned long startMs = millis();
+   tft.resetStats();
+   for(unsigned long i=0; i<loops; i++) {
+      boolean touching = false;
+      for(const tap & t : taps) {
+         if(millis() - startMs >= t.ms && millis() - startMs < t.ms + TAP_MS) {
+            halTouch(t.x, t.y);
+            touching = true;
+         }
+      }
+      if(!touching) {
+         halRelease();
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      loop();
+      unsigned long us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+      hostUs += us;
+      maxUs = max(maxUs, us);
+
+      halAdvanceMicros(loopMs * 1000);
+   }
+   tftStats stats = tft.getStats();
+
+   char line[160];
+   snprintf(line, sizeof(line), "%lu loops over %.1f s fake time.  loop(): %.1f us avg, %lu us max.  Per loop: %.1f draw calls, %.0f pixels",
+            loops, (millis() - startMs) / 1000.0, hostUs / (double)max(loops, 1UL), maxUs,
+            stats.drawCalls / (double)max(loops, 1UL), stats.pixels / (double)max(loops, 1UL));
+   Serial.println(line);
+
+   if(outDir) {
+      std::string path = std::string(outDir) + "/screen.png";
+      if(!tft.savePNG(path.c_str())) {
+         Serial.print("Could not write ");
+         Serial.println(path.c_str());
+      }
+   }
+   return(0);
+}
+
+#endif
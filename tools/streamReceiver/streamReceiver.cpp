@@ -0,0 +1,199 @@
+
+// Host side receiver for the data logger's binary sample stream.
+// Reads COBS framed samples from a serial port (or pty), writes them to a CSV file and
+// reports CRC errors and dropped frames (gaps in the sequence numbers).
+//
+// Build:  g++ -O2 -Wall -I../../include -o streamReceiver streamReceiver.cpp
+// Usage:  streamReceiver <device> [baud] [output.csv]
+//         streamReceiver --send <device> [baud] [count] [skipEvery]   (made up frames, for testing)
+//
+// Linux only (termios).
+
+#include <streamFrame.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int) {
+   stopRequested = 1;
+}
+
+static speed_t baudToSpeed(long baud) {
+   switch(baud) {
+      case 9600:    return(B9600);
+      case 19200:   return(B19200);
+      case 38400:   return(B38400);
+      case 57600:   return(B57600);
+      case 115200:  return(B115200);
+      case 230400:  return(B230400);
+      case 460800:  return(B460800);
+      case 921600:  return(B921600);
+      case 1000000: return(B1000000);
+      case 1500000: return(B1500000);
+      case 2000000: return(B2000000);
+   }
+   return(0);
+}
+
+// Put the port in raw mode at the requested speed.  A pty just ignores the speed.
+static bool configurePort(int fd, long baud) {
+   struct termios tio;
+   if(tcgetattr(fd, &tio) != 0) {
+      return(false);
+   }
+   cfmakeraw(&tio);
+   tio.c_cflag |= CLOCAL | CREAD;
+   tio.c_cc[VMIN] = 1;
+   tio.c_cc[VTIME] = 0;
+   speed_t speed = baudToSpeed(baud);
+   if(speed == 0) {
+      fprintf(stderr, "Unsupported baud rate %ld\n", baud);
+      return(false);
+   }
+   cfsetispeed(&tio, speed);
+   cfsetospeed(&tio, speed);
+   return(tcsetattr(fd, TCSANOW, &tio) == 0);
+}
+
+static const char * typeName(uint8_t type) {
+   switch(type) {
+      case STREAM_TYPE_AD:   return("AD");
+      case STREAM_TYPE_IV:   return("IV");
+      case STREAM_TYPE_TEMP: return("TEMP");
+   }
+   return("?");
+}
+
+// Sender mode, for trying the receiver out on a pty pair without the logger.  Writes count IV frames
+// of a made up session 10ms apart, the same way streamResults() does, leaving out every skipEvery'th
+// sequence number (0 = none) so the receiver has some drops to report.
+static int sendFrames(int fd, unsigned long count, unsigned long skipEvery) {
+   // A delimiter first, so the receiver doesn't take our first frame for the tail of an earlier one
+   uint8_t zero = 0;
+   if(write(fd, &zero, 1) != 1) {
+      fprintf(stderr, "Write error: %s\n", strerror(errno));
+      return(1);
+   }
+   uint32_t seq = 0;
+   for(unsigned long i=0; i<count && !stopRequested; i++, seq++) {
+      if(skipEvery && i && i % skipEvery == 0) {
+         seq++;
+      }
+      streamSample sample;
+      sample.type = STREAM_TYPE_IV;
+      sample.seq = seq;
+      sample.timeMs = i * 10;
+      sample.result[0] = 100.0 + 50.0 * sin(i * 0.01);
+      sample.result[1] = 5.0 - sample.result[0] / 2000.0;
+      sample.result[2] = sample.result[0] * sample.result[1];
+
+      uint8_t raw[STREAM_RAW_LEN];
+      uint8_t wire[STREAM_WIRE_LEN];
+      streamPackFrame(&sample, raw);
+      uint16_t wireLen = streamCobsEncode(raw, STREAM_RAW_LEN, wire);
+      if(write(fd, wire, wireLen) != wireLen) {
+         fprintf(stderr, "Write error: %s\n", strerror(errno));
+         return(1);
+      }
+      usleep(10000);
+   }
+   fprintf(stderr, "Frames sent: %lu  last seq: %u\n", count, seq ? seq - 1 : 0);
+   return(0);
+}
+
+int main(int argc, char ** argv) {
+   bool send = (argc > 1 && !strcmp(argv[1], "--send"));
+   if(send) {
+      argc--;
+      argv++;
+   }
+   if(argc < 2) {
+      fprintf(stderr, "Usage: %s <device> [baud] [output.csv]\n"
+                      "       %s --send <device> [baud] [count] [skipEvery]\n", argv[0], argv[0]);
+      return(2);
+   }
+   const char * device = argv[1];
+   long baud = (argc > 2) ? atol(argv[2]) : 115200;
+
+   int fd = open(device, (send ? O_WRONLY : O_RDONLY) | O_NOCTTY);
+   if(fd < 0) {
+      fprintf(stderr, "Failed to open %s: %s\n", device, strerror(errno));
+      return(1);
+   }
+   if(!configurePort(fd, baud)) {
+      fprintf(stderr, "Failed to configure %s\n", device);
+      close(fd);
+      return(1);
+   }
+
+   struct sigaction sa;
+   memset(&sa, 0, sizeof(sa));
+   sa.sa_handler = onSignal;
+   sigaction(SIGINT, &sa, NULL);
+   sigaction(SIGTERM, &sa, NULL);
+
+   if(send) {
+      int rc = sendFrames(fd, (argc > 3) ? atol(argv[3]) : 1000, (argc > 4) ? atol(argv[4]) : 0);
+      close(fd);
+      return(rc);
+   }
+
+   const char * csvName = (argc > 3) ? argv[3] : NULL;
+   FILE * csv = csvName ? fopen(csvName, "w") : stdout;
+   if(!csv) {
+      fprintf(stderr, "Failed to open %s: %s\n", csvName, strerror(errno));
+      close(fd);
+      return(1);
+   }
+   fprintf(csv, "seq,time_ms,type,result0,result1,result2\n");
+
+   // Skip the partial frame we most likely joined in the middle of
+   streamDecoder decoder;
+   streamDecoderInit(&decoder, false);
+
+   uint8_t buff[4096];
+   while(!stopRequested) {
+      ssize_t n = read(fd, buff, sizeof(buff));
+      if(n < 0) {
+         if(errno == EINTR) {
+            continue;
+         }
+         if(errno != EIO) {   // EIO is what a pty returns once the other end closes
+            fprintf(stderr, "Read error: %s\n", strerror(errno));
+         }
+         break;
+      }
+      if(n == 0) {
+         break;
+      }
+
+      for(ssize_t i=0; i<n; i++) {
+         streamSample s;
+         unsigned long restarts = decoder.restarts;
+         if(streamDecodeByte(&decoder, buff[i], &s)) {
+            if(decoder.restarts != restarts) {
+               fprintf(stderr, "Sequence restarted at %u (logger reset?)\n", s.seq);
+            }
+            fprintf(csv, "%u,%u,%s,%g,%g,%g\n", s.seq, s.timeMs, typeName(s.type),
+                    s.result[0], s.result[1], s.result[2]);
+         }
+      }
+      fflush(csv);
+   }
+
+   fprintf(stderr, "Frames received: %lu  dropped: %lu  bad (CRC/format): %lu\n",
+           decoder.goodFrames, decoder.droppedFrames, decoder.badFrames);
+   if(csv != stdout) {
+      fclose(csv);
+   }
+   close(fd);
+   return(0);
+}
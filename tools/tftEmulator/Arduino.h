@@ -0,0 +1,143 @@
+// Just enough of the Arduino core for the screen libraries to build on Linux (see README.md)
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+using std::min;
+using std::max;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define RISING 1
+#define FALLING 2
+#define CHANGE 3
+
+#define IRAM_ATTR
+#define PROGMEM
+#define F(x) x
+#define pgm_read_byte(a)  (*(const uint8_t *)(a))
+#define pgm_read_word(a)  (*(const uint16_t *)(a))
+#define pgm_read_dword(a) (*(const uint32_t *)(a))
+#define pgm_read_ptr(a)   (*(void * const *)(a))
+
+template<class T, class L, class H> T constrain(T a, L lo, H hi) {
+   return(a < lo ? lo : (a > hi ? hi : a));
+}
+long map(long, long, long, long, long);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long);
+
+// Board I/O.  Only the native build (tools/nativeHal) has bodies for these.
+void pinMode(uint8_t, uint8_t);
+int digitalRead(uint8_t);
+void digitalWrite(uint8_t, uint8_t);
+int digitalPinToInterrupt(int);
+void attachInterrupt(int, void (*)(void), int);
+uint32_t analogReadMilliVolts(uint8_t);
+void ledcAttachPin(uint8_t, uint8_t);
+void ledcDetachPin(uint8_t);
+double ledcSetup(uint8_t, double, uint8_t);
+void ledcWrite(uint8_t, uint32_t);
+uint32_t getCpuFrequencyMhz();
+uint32_t getXtalFrequencyMhz();
+uint32_t getApbFrequency();
+uint32_t esp_get_free_heap_size();
+uint32_t esp_get_minimum_free_heap_size();
+
+// The sketch
+void setup();
+void loop();
+
+char * dtostrf(double, signed char, unsigned char, char *);
+char * itoa(int, char *, int);
+
+class String {
+   public:
+      String(const char * s = "") : _s(s) {}
+      const char * c_str() const { return(_s.c_str()); }
+      bool operator==(const char * s) const { return(_s == s); }
+      bool operator!=(const char * s) const { return(_s != s); }
+   private:
+      std::string _s;
+};
+
+// Text output.  Everything ends up in write().
+class Print {
+   public:
+      virtual ~Print() {}
+      virtual size_t write(uint8_t) = 0;
+      virtual size_t write(const uint8_t * buf, size_t len) {
+         size_t n = 0;
+         while(len--) {
+            n += write(*buf++);
+         }
+         return(n);
+      }
+      size_t print(const char * s) { return(write((const uint8_t *)s, strlen(s))); }
+      size_t print(const String & s) { return(print(s.c_str())); }
+      size_t print(char c) { return(write((uint8_t)c)); }
+      size_t print(int n) { return(_printf("%d", n)); }
+      size_t print(unsigned int n) { return(_printf("%u", n)); }
+      size_t print(long n) { return(_printf("%ld", n)); }
+      size_t print(unsigned long n) { return(_printf("%lu", n)); }
+      size_t print(double n, int digits = 2) { return(_printf("%.*f", digits, n)); }
+      size_t println() { return(print("\r\n")); }   // Same line ending as the Arduino core
+      template<class T> size_t println(T v) { size_t n = print(v); return(n + println()); }
+      size_t println(double v, int digits) { size_t n = print(v, digits); return(n + println()); }
+   private:
+      size_t _printf(const char * fmt, ...);
+};
+
+// Serial goes to stdout.  The native tests can instead keep what's written (hostCapture) and model a
+// TX buffer with only so many bytes free that nothing drains (hostSetTxRoom, -1 is always room).
+class HardwareSerial : public Print {
+   public:
+      void begin(unsigned long) {}
+      operator bool() { return(true); }
+      int availableForWrite() { return(_txRoom < 0 ? 4096 : _txRoom); }
+      size_t setTxBufferSize(size_t size) { return(size); }
+      void flush() { fflush(stdout); }
+      int available() { return(0); }
+      int read() { return(-1); }
+      size_t write(uint8_t c) {
+         if(_txRoom == 0) {
+            return(0);
+         }
+         if(_txRoom > 0) {
+            _txRoom--;
+         }
+         if(_capture) {
+            _captured += (char)c;
+            return(1);
+         }
+         return(fputc(c, stdout) == EOF ? 0 : 1);
+      }
+      using Print::write;
+
+      void hostSetTxRoom(int bytes) { _txRoom = bytes; }
+      void hostCapture(bool on) { _capture = on; _captured.clear(); }
+      const std::string & hostCaptured() { return(_captured); }
+   private:
+      int _txRoom = -1;
+      bool _capture = false;
+      std::string _captured;
+};
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,60 @@
+// Files for the host build.  Each file system is a directory on the host (see SD.h, SPIFFS.h and README.md).
+
+#ifndef FS_h
+#define FS_h
+
+#include <Arduino.h>
+#include <memory>
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+enum SeekMode { SeekSet, SeekCur, SeekEnd };
+
+// What was read off a file system since the counters were last reset
+struct fsStats {
+   uint32_t opens;         // Files opened
+   uint32_t bytesRead;     // Bytes read from them
+};
+
+class File : public Print {
+   public:
+      File() {}
+      File(FILE * fp, fsStats * stats) : _fp(fp, fclose), _stats(stats) {}
+      operator bool() const { return(_fp != nullptr); }
+      int available();
+      int read();
+      size_t read(uint8_t *, size_t);
+      size_t readBytes(char * buf, size_t len) { return(read((uint8_t *)buf, len)); }
+      bool seek(uint32_t, SeekMode mode = SeekSet);
+      size_t position() const;
+      size_t size() const;
+      void flush();
+      void close() { _fp.reset(); }
+      size_t write(uint8_t);
+      size_t write(const uint8_t *, size_t);
+      using Print::write;
+   private:
+      std::shared_ptr<FILE> _fp;
+      fsStats * _stats = nullptr;
+};
+
+class FS {
+   public:
+      // Files live under $<rootEnv>, or rootDefault if it isn't set
+      FS(const char * rootEnv, const char * rootDefault) : _rootEnv(rootEnv), _rootDefault(rootDefault) {}
+      bool begin();
+      File open(const char *, const char * mode = FILE_READ);
+      bool exists(const char *);
+      bool remove(const char *);
+      fsStats getStats() { return(_stats); }
+      void resetStats() { _stats.opens = 0; _stats.bytesRead = 0; }
+   private:
+      std::string _path(const char *);
+      const char * _rootEnv;
+      const char * _rootDefault;
+      fsStats _stats = {0, 0};
+};
+
+#endif
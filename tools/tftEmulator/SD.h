@@ -0,0 +1,17 @@
+// The SD card for the host build.  Files live under $SD_ROOT (default ./sdcard) (see README.md).
+
+#ifndef SD_h
+#define SD_h
+
+#include <FS.h>
+
+enum { CARD_NONE, CARD_MMC, CARD_SD, CARD_SDHC };
+
+class SDFS : public FS {
+   public:
+      SDFS() : FS("SD_ROOT", "./sdcard") {}
+      uint8_t cardType() { return(CARD_SDHC); }
+};
+extern SDFS SD;
+
+#endif
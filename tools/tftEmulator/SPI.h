@@ -0,0 +1,5 @@
+// Nothing needed from SPI.h on the host (see README.md)
+#ifndef SPI_h
+#define SPI_h
+#include <Arduino.h>
+#endif
@@ -0,0 +1,15 @@
+// The ESP32 flash file system for the host build.  Files live under $SPIFFS_ROOT (default ./spiffs) (see README.md).
+
+#ifndef SPIFFS_h
+#define SPIFFS_h
+
+#include <FS.h>
+
+class SPIFFSFS : public FS {
+   public:
+      SPIFFSFS() : FS("SPIFFS_ROOT", "./spiffs") {}
+      bool format() { return(begin()); }
+};
+extern SPIFFSFS SPIFFS;
+
+#endif
@@ -0,0 +1,870 @@
+// Software TFT_eSPI for the host build (see TFT_eSPI.h and README.md)
+
+#include <TFT_eSPI.h>
+
+//###############################################################################
+// Color helpers
+//###############################################################################
+static uint16_t swap16(uint16_t c) {
+   return((c >> 8) | (c << 8));
+}
+
+static uint8_t color565to332(uint16_t c) {
+   return(((c & 0xE000) >> 8) | ((c & 0x0700) >> 6) | ((c & 0x0018) >> 3));
+}
+
+static uint16_t color332to565(uint8_t c) {
+   uint16_t r = c >> 5;
+   uint16_t g = (c >> 2) & 0x07;
+   uint16_t b = c & 0x03;
+   r = (r << 2) | (r >> 1);
+   g = (g << 3) | g;
+   b = (b << 3) | (b << 1) | (b >> 1);
+   return((r << 11) | (g << 5) | b);
+}
+
+// The library's default 4-bit palette
+static const uint16_t default_4bit_palette[16] = {
+   TFT_BLACK, TFT_BROWN, TFT_RED, TFT_ORANGE, TFT_YELLOW, TFT_GREEN, TFT_BLUE, TFT_PURPLE,
+   TFT_DARKGREY, TFT_WHITE, TFT_CYAN, TFT_MAGENTA, TFT_MAROON, TFT_DARKGREEN, TFT_NAVY, TFT_PINK
+};
+
+//###############################################################################
+// TFT_eSPI.  The display.
+//###############################################################################
+TFT_eSPI::TFT_eSPI(int16_t w, int16_t h) {
+   _width = w;
+   _height = h;
+   _frame = (w > 0 && h > 0) ? new uint16_t[w * h]() : NULL;
+   _xPivot = _yPivot = 0;
+   _swapBytes = false;
+   _font = NULL;
+   _textColor = TFT_WHITE;
+   _textBgColor = TFT_WHITE;
+   _textDatum = TL_DATUM;
+   _glyphAb = _glyphBb = 0;
+   _cursorX = _cursorY = 0;
+   _winX = _winY = _winW = _winH = _winPos = 0;
+   _depth = 0;
+   _touched = false;
+   _touchX = _touchY = 0;
+   resetStats();
+   resetViewport();
+}
+
+TFT_eSPI::~TFT_eSPI() {
+   delete[] _frame;
+}
+
+int16_t TFT_eSPI::width() {
+   return(_vpDatum ? _vpW : _width);
+}
+
+int16_t TFT_eSPI::height() {
+   return(_vpDatum ? _vpH : _height);
+}
+
+void TFT_eSPI::_writeRaw(int32_t x, int32_t y, uint32_t color) {
+   _frame[y * _width + x] = color;
+}
+
+uint32_t TFT_eSPI::_readRaw(int32_t x, int32_t y) {
+   return(_frame[y * _width + x]);
+}
+
+// Absolute coordinates, clipped to the viewport
+void TFT_eSPI::_plot(int32_t x, int32_t y, uint32_t color) {
+   if(x < _vpX || y < _vpY || x >= _vpX + _vpW || y >= _vpY + _vpH) {
+      return;
+   }
+   _writeRaw(x, y, color);
+   _countPixels(1);
+}
+
+void TFT_eSPI::_fillAbs(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+   int32_t x1 = max(x, _vpX);
+   int32_t y1 = max(y, _vpY);
+   int32_t x2 = min(x + w, _vpX + _vpW);
+   int32_t y2 = min(y + h, _vpY + _vpH);
+   if(x1 >= x2 || y1 >= y2) {
+      return;
+   }
+   for(int32_t yy=y1; yy<y2; yy++) {
+      for(int32_t xx=x1; xx<x2; xx++) {
+         _writeRaw(xx, yy, color);
+      }
+   }
+   _countPixels((x2 - x1) * (y2 - y1));
+}
+
+//###############################################################################
+// Primitives
+//###############################################################################
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+   _Call call(this);
+   _plot(x + _xDatum, y + _yDatum, color);
+}
+
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+   _Call call(this);
+   int32_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+   int32_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+   int32_t err = dx + dy;
+   while(true) {
+      _plot(x0 + _xDatum, y0 + _yDatum, color);
+      if(x0 == x1 && y0 == y1) {
+         break;
+      }
+      int32_t e2 = 2 * err;
+      if(e2 >= dy) { err += dy; x0 += sx; }
+      if(e2 <= dx) { err += dx; y0 += sy; }
+   }
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+   _Call call(this);
+   _fillAbs(x + _xDatum, y + _yDatum, 1, h, color);
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+   _Call call(this);
+   _fillAbs(x + _xDatum, y + _yDatum, w, 1, color);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+   _Call call(this);
+   _fillAbs(x + _xDatum, y + _yDatum, w, h, color);
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+   _Call call(this);
+   drawFastHLine(x, y, w, color);
+   drawFastHLine(x, y + h - 1, w, color);
+   drawFastVLine(x, y + 1, h - 2, color);
+   drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+void TFT_eSPI::fillScreen(uint32_t color) {
+   fillRect(0, 0, _width, _height, color);
+}
+
+// Quarter circle outlines (same as the Adafruit_GFX helpers the library uses)
+void TFT_eSPI::_circleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t corners, uint32_t color) {
+   int32_t f = 1 - r;
+   int32_t ddF_x = 1;
+   int32_t ddF_y = -2 * r;
+   int32_t x = 0;
+   int32_t y = r;
+   while(x < y) {
+      if(f >= 0) {
+         y--;
+         ddF_y += 2;
+         f += ddF_y;
+      }
+      x++;
+      ddF_x += 2;
+      f += ddF_x;
+      if(corners & 0x4) { drawPixel(x0 + x, y0 + y, color); drawPixel(x0 + y, y0 + x, color); }
+      if(corners & 0x2) { drawPixel(x0 + x, y0 - y, color); drawPixel(x0 + y, y0 - x, color); }
+      if(corners & 0x8) { drawPixel(x0 - y, y0 + x, color); drawPixel(x0 - x, y0 + y, color); }
+      if(corners & 0x1) { drawPixel(x0 - y, y0 - x, color); drawPixel(x0 - x, y0 - y, color); }
+   }
+}
+
+void TFT_eSPI::_fillCircleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t corners, int32_t delta, uint32_t color) {
+   int32_t f = 1 - r;
+   int32_t ddF_x = 1;
+   int32_t ddF_y = -r - r;
+   int32_t y = 0;
+   delta++;
+   while(y < r) {
+      if(f >= 0) {
+         if(corners & 0x1) drawFastHLine(x0 - y, y0 + r, y + y + delta, color);
+         if(corners & 0x2) drawFastHLine(x0 - y, y0 - r, y + y + delta, color);
+         r--;
+         ddF_y += 2;
+         f += ddF_y;
+      }
+      y++;
+      ddF_x += 2;
+      f += ddF_x;
+      if(corners & 0x1) drawFastHLine(x0 - r, y0 + y, r + r + delta, color);
+      if(corners & 0x2) drawFastHLine(x0 - r, y0 - y, r + r + delta, color);
+   }
+}
+
+void TFT_eSPI::drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color) {
+   _Call call(this);
+   drawFastHLine(x + r, y, w - r - r, color);
+   drawFastHLine(x + r, y + h - 1, w - r - r, color);
+   drawFastVLine(x, y + r, h - r - r, color);
+   drawFastVLine(x + w - 1, y + r, h - r - r, color);
+   _circleHelper(x + r, y + r, r, 1, color);
+   _circleHelper(x + w - r - 1, y + r, r, 2, color);
+   _circleHelper(x + w - r - 1, y + h - r - 1, r, 4, color);
+   _circleHelper(x + r, y + h - r - 1, r, 8, color);
+}
+
+void TFT_eSPI::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color) {
+   _Call call(this);
+   fillRect(x, y + r, w, h - r - r, color);
+   _fillCircleHelper(x + r, y + h - r - 1, r, 1, w - r - r - 1, color);
+   _fillCircleHelper(x + r, y + r, r, 2, w - r - r - 1, color);
+}
+
+//###############################################################################
+// Free font text.  Only the GFXFF fonts are drawn, the built in GLCD font is not.
+//###############################################################################
+void TFT_eSPI::setFreeFont(const GFXfont * font) {
+   _font = font;
+   _glyphAb = _glyphBb = 0;
+   if(font == NULL) {
+      return;
+   }
+   for(uint16_t c=0; c<=font->last - font->first; c++) {
+      const GFXglyph * glyph = &font->glyph[c];
+      _glyphAb = max(_glyphAb, (int16_t)-glyph->yOffset);
+      _glyphBb = max(_glyphBb, (int16_t)(glyph->height + glyph->yOffset));
+   }
+}
+
+int16_t TFT_eSPI::textWidth(const char * string) {
+   int16_t width = 0;
+   if(_font == NULL) {
+      return(6 * strlen(string));
+   }
+   while(*string) {
+      uint8_t c = *string++;
+      if(c < _font->first || c > _font->last) {
+         continue;
+      }
+      const GFXglyph * glyph = &_font->glyph[c - _font->first];
+      if(*string == 0) {
+         width += glyph->xOffset + glyph->width;
+      } else {
+         width += glyph->xAdvance;
+      }
+   }
+   return(width);
+}
+
+int16_t TFT_eSPI::fontHeight() {
+   return(_font ? _font->yAdvance : 8);
+}
+
+// One glyph with its baseline at y.  Moves x on by the advance.
+void TFT_eSPI::_drawGlyph(uint16_t c, int32_t * x, int32_t y) {
+   if(_font == NULL || c < _font->first || c > _font->last) {
+      return;
+   }
+   const GFXglyph * glyph = &_font->glyph[c - _font->first];
+   const uint8_t * bitmap = _font->bitmap + glyph->bitmapOffset;
+   uint8_t bits = 0;
+   uint16_t bit = 0;
+   for(int32_t yy=0; yy<glyph->height; yy++) {
+      for(int32_t xx=0; xx<glyph->width; xx++) {
+         if(!(bit++ & 7)) {
+            bits = *bitmap++;
+         }
+         if(bits & 0x80) {
+            _plot(*x + glyph->xOffset + xx + _xDatum, y + glyph->yOffset + yy + _yDatum, _textColor);
+         }
+         bits <<= 1;
+      }
+   }
+   *x += glyph->xAdvance;
+}
+
+int16_t TFT_eSPI::drawString(const char * string, int32_t x, int32_t y) {
+   _Call call(this);
+   int16_t width = textWidth(string);
+   int16_t height = _glyphAb;
+   int16_t baseline = height;
+   y += height;   // Free fonts are drawn on their baseline
+
+   switch(_textDatum) {
+      case TC_DATUM: x -= width/2; break;
+      case TR_DATUM: x -= width; break;
+      case ML_DATUM: y -= height/2; break;
+      case MC_DATUM: x -= width/2; y -= height/2; break;
+      case MR_DATUM: x -= width; y -= height/2; break;
+      case BL_DATUM: y -= height; break;
+      case BC_DATUM: x -= width/2; y -= height; break;
+      case BR_DATUM: x -= width; y -= height; break;
+      case L_BASELINE: y -= baseline; break;
+      case C_BASELINE: x -= width/2; y -= baseline; break;
+      case R_BASELINE: x -= width; y -= baseline; break;
+   }
+
+   while(*string) {
+      _drawGlyph((uint8_t)*string++, &x, y);
+   }
+   return(width);
+}
+
+size_t TFT_eSPI::write(uint8_t c) {
+   _Call call(this);
+   if(c == '\n') {
+      _cursorX = 0;
+      _cursorY += fontHeight();
+   } else if(c != '\r') {
+      _drawGlyph(c, &_cursorX, _cursorY);
+   }
+   return(1);
+}
+
+//###############################################################################
+// Viewports
+//###############################################################################
+void TFT_eSPI::setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum) {
+   _vpDatum = vpDatum;
+   _xDatum = vpDatum ? x : 0;
+   _yDatum = vpDatum ? y : 0;
+   if(x < 0) { w += x; x = 0; }
+   if(y < 0) { h += y; y = 0; }
+   _vpX = x;
+   _vpY = y;
+   _vpW = max((int32_t)0, min(w, _width - x));
+   _vpH = max((int32_t)0, min(h, _height - y));
+}
+
+void TFT_eSPI::resetViewport() {
+   _vpDatum = false;
+   _xDatum = _yDatum = 0;
+   _vpX = _vpY = 0;
+   _vpW = _width;
+   _vpH = _height;
+}
+
+//###############################################################################
+// Block transfers.  Like the library, image data is byte swapped unless setSwapBytes(true).
+//###############################################################################
+void TFT_eSPI::readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t * data) {
+   x += _xDatum;
+   y += _yDatum;
+   for(int32_t yy=0; yy<h; yy++) {
+      for(int32_t xx=0; xx<w; xx++) {
+         int32_t px = x + xx;
+         int32_t py = y + yy;
+         uint16_t c = 0;
+         if(px >= 0 && py >= 0 && px < _width && py < _height) {
+            c = _read565(px, py);
+         }
+         *data++ = swap16(c);
+      }
+   }
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t * data) {
+   _Call call(this);
+   for(int32_t yy=0; yy<h; yy++) {
+      for(int32_t xx=0; xx<w; xx++) {
+         uint16_t c = *data++;
+         _plot(x + xx + _xDatum, y + yy + _yDatum, _swapBytes ? c : swap16(c));
+      }
+   }
+}
+
+void TFT_eSPI::setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+   _winX = x + _xDatum;
+   _winY = y + _yDatum;
+   _winW = w;
+   _winH = h;
+   _winPos = 0;
+}
+
+void TFT_eSPI::pushColor(uint16_t color) {
+   pushColor(color, 1);
+}
+
+void TFT_eSPI::pushColor(uint16_t color, uint32_t len) {
+   _Call call(this);
+   while(len-- && _winPos < _winW * _winH) {
+      _plot(_winX + _winPos % _winW, _winY + _winPos / _winW, color);
+      _winPos++;
+   }
+}
+
+// Into the address window like pushColor, with the same byte order as pushImage
+void TFT_eSPI::pushPixels(const void * data, uint32_t len) {
+   _Call call(this);
+   const uint16_t * p = (const uint16_t *)data;
+   while(len-- && _winPos < _winW * _winH) {
+      uint16_t c = *p++;
+      _plot(_winX + _winPos % _winW, _winY + _winPos / _winW, _swapBytes ? c : swap16(c));
+      _winPos++;
+   }
+}
+
+//###############################################################################
+// Image dumps.  RGB565 is widened to 8 bits per channel.
+//###############################################################################
+static void rgb888(uint16_t c, uint8_t * rgb) {
+   uint8_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+   rgb[0] = (r << 3) | (r >> 2);
+   rgb[1] = (g << 2) | (g >> 4);
+   rgb[2] = (b << 3) | (b >> 2);
+}
+
+bool TFT_eSPI::savePPM(const char * path) {
+   FILE * fp = fopen(path, "wb");
+   if(fp == NULL) {
+      return(false);
+   }
+   fprintf(fp, "P6\n%d %d\n255\n", (int)_width, (int)_height);
+   for(int32_t i=0; i<_width*_height; i++) {
+      uint8_t rgb[3];
+      rgb888(_read565(i % _width, i / _width), rgb);
+      fwrite(rgb, 1, 3, fp);
+   }
+   return(fclose(fp) == 0);
+}
+
+static uint32_t crc32(uint32_t crc, const uint8_t * data, size_t len) {
+   static uint32_t table[256];
+   if(table[1] == 0) {
+      for(uint32_t n=0; n<256; n++) {
+         uint32_t c = n;
+         for(uint8_t k=0; k<8; k++) {
+            c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+         }
+         table[n] = c;
+      }
+   }
+   crc = ~crc;
+   while(len--) {
+      crc = table[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+   }
+   return(~crc);
+}
+
+static void putU32BE(std::string & out, uint32_t v) {
+   out += (char)(v >> 24);
+   out += (char)(v >> 16);
+   out += (char)(v >> 8);
+   out += (char)v;
+}
+
+static void pngChunk(FILE * fp, const char * type, const std::string & data) {
+   std::string chunk(type, 4);
+   chunk += data;
+   std::string len;
+   putU32BE(len, data.size());
+   std::string crc;
+   putU32BE(crc, crc32(0, (const uint8_t *)chunk.data(), chunk.size()));
+   fwrite(len.data(), 1, 4, fp);
+   fwrite(chunk.data(), 1, chunk.size(), fp);
+   fwrite(crc.data(), 1, 4, fp);
+}
+
+// PNG with the image data in stored (uncompressed) deflate blocks, so no zlib is needed
+bool TFT_eSPI::savePNG(const char * path) {
+   FILE * fp = fopen(path, "wb");
+   if(fp == NULL) {
+      return(false);
+   }
+
+   std::string raw;
+   for(int32_t y=0; y<_height; y++) {
+      raw += (char)0;   // Filter type none
+      for(int32_t x=0; x<_width; x++) {
+         uint8_t rgb[3];
+         rgb888(_read565(x, y), rgb);
+         raw.append((const char *)rgb, 3);
+      }
+   }
+
+   std::string z;
+   z += (char)0x78;
+   z += (char)0x01;
+   for(size_t pos=0; pos<raw.size() || pos==0; ) {
+      size_t len = min(raw.size() - pos, (size_t)65535);
+      z += (char)(pos + len == raw.size() ? 1 : 0);
+      z += (char)(len & 0xFF);
+      z += (char)(len >> 8);
+      z += (char)(~len & 0xFF);
+      z += (char)((~len >> 8) & 0xFF);
+      z.append(raw, pos, len);
+      pos += len;
+      if(len == 0) {
+         break;
+      }
+   }
+   uint32_t a = 1, b = 0;
+   for(size_t i=0; i<raw.size(); i++) {
+      a = (a + (uint8_t)raw[i]) % 65521;
+      b = (b + a) % 65521;
+   }
+   putU32BE(z, (b << 16) | a);
+
+   std::string ihdr;
+   putU32BE(ihdr, _width);
+   putU32BE(ihdr, _height);
+   ihdr += (char)8;   // Bit depth
+   ihdr += (char)2;   // Truecolor
+   ihdr += std::string(3, (char)0);
+
+   fwrite("\x89PNG\r\n\x1a\n", 1, 8, fp);
+   pngChunk(fp, "IHDR", ihdr);
+   pngChunk(fp, "IDAT", z);
+   pngChunk(fp, "IEND", "");
+   return(fclose(fp) == 0);
+}
+
+//###############################################################################
+// TFT_eSprite.  Pixels are held at the sprite's color depth with the library's layouts:
+//   16 bit  byte swapped RGB565
+//    8 bit  RGB332
+//    4 bit  palette index, two pixels per byte, even x in the high nibble
+//    1 bit  rows padded to whole bytes, MSB is the leftmost pixel
+//###############################################################################
+TFT_eSprite::TFT_eSprite(TFT_eSPI * tft) : TFT_eSPI(0, 0) {
+   _tft = tft;
+   _buf = NULL;
+   _bpp = 16;
+   _bitWidth = 0;
+   memcpy(_palette, default_4bit_palette, sizeof(_palette));
+   _bitmapFg = TFT_WHITE;
+   _bitmapBg = TFT_BLACK;
+   _sx = _sy = _sw = _sh = 0;
+   _scrollFill = TFT_BLACK;
+}
+
+TFT_eSprite::~TFT_eSprite() {
+   deleteSprite();
+}
+
+void * TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t) {
+   if(_buf) {
+      return(_buf);
+   }
+   if(w < 1 || h < 1) {
+      return(NULL);
+   }
+   _width = w;
+   _height = h;
+   _bitWidth = (_bpp == 1) ? (w + 7) & ~7 : (w + 1) & ~1;
+   size_t bytes;
+   switch(_bpp) {
+      case 1:  bytes = _bitWidth * h / 8; break;
+      case 4:  bytes = _bitWidth * h / 2; break;
+      case 8:  bytes = w * h; break;
+      default: bytes = w * h * 2; break;
+   }
+   _buf = (uint8_t *)calloc(bytes, 1);
+   resetViewport();
+   setScrollRect(0, 0, w, h, TFT_BLACK);
+   return(_buf);
+}
+
+void TFT_eSprite::deleteSprite() {
+   free(_buf);
+   _buf = NULL;
+   _width = _height = 0;
+   resetViewport();
+}
+
+void * TFT_eSprite::setColorDepth(int8_t b) {
+   _bpp = (b == 1 || b == 4 || b == 8) ? b : 16;
+   if(_buf == NULL) {
+      return(NULL);
+   }
+   int16_t w = _width, h = _height;
+   deleteSprite();
+   return(createSprite(w, h));
+}
+
+void TFT_eSprite::createPalette(const uint16_t * palette, uint8_t colors) {
+   memcpy(_palette, default_4bit_palette, sizeof(_palette));
+   if(palette) {
+      memcpy(_palette, palette, min(colors, (uint8_t)16) * sizeof(uint16_t));
+   }
+}
+
+void TFT_eSprite::_writeRaw(int32_t x, int32_t y, uint32_t color) {
+   if(_buf == NULL) {
+      return;
+   }
+   switch(_bpp) {
+      case 1: {
+         uint8_t * p = &_buf[(x + y * _bitWidth) >> 3];
+         if(color) {
+            *p |= 0x80 >> (x & 7);
+         } else {
+            *p &= ~(0x80 >> (x & 7));
+         }
+         break;
+      }
+      case 4: {
+         uint8_t * p = &_buf[(x + y * _bitWidth) >> 1];
+         if(x & 1) {
+            *p = (*p & 0xF0) | (color & 0x0F);
+         } else {
+            *p = (*p & 0x0F) | ((color & 0x0F) << 4);
+         }
+         break;
+      }
+      case 8:
+         _buf[x + y * _width] = color565to332(color);
+         break;
+      default:
+         ((uint16_t *)_buf)[x + y * _width] = swap16(color);
+         break;
+   }
+}
+
+uint32_t TFT_eSprite::_readRaw(int32_t x, int32_t y) {
+   if(_buf == NULL) {
+      return(0);
+   }
+   switch(_bpp) {
+      case 1:  return((_buf[(x + y * _bitWidth) >> 3] >> (7 - (x & 7))) & 1);
+      case 4:  return((x & 1) ? _buf[(x + y * _bitWidth) >> 1] & 0x0F : _buf[(x + y * _bitWidth) >> 1] >> 4);
+      case 8:  return(_buf[x + y * _width]);
+      default: return(((uint16_t *)_buf)[x + y * _width]);
+   }
+}
+
+uint16_t TFT_eSprite::_read565(int32_t x, int32_t y) {
+   uint32_t raw = _readRaw(x, y);
+   switch(_bpp) {
+      case 1:  return(raw ? _bitmapFg : _bitmapBg);
+      case 4:  return(_palette[raw]);
+      case 8:  return(color332to565(raw));
+      default: return(swap16(raw));
+   }
+}
+
+uint16_t TFT_eSprite::readPixel(int32_t x, int32_t y) {
+   x += _xDatum;
+   y += _yDatum;
+   if(x < 0 || y < 0 || x >= _width || y >= _height) {
+      return(0xFFFF);
+   }
+   return(_read565(x, y));
+}
+
+uint16_t TFT_eSprite::readPixelValue(int32_t x, int32_t y) {
+   x += _xDatum;
+   y += _yDatum;
+   if(x < 0 || y < 0 || x >= _width || y >= _height) {
+      return(0xFF);
+   }
+   return(_bpp == 16 ? swap16(_readRaw(x, y)) : _readRaw(x, y));
+}
+
+void TFT_eSprite::fillSprite(uint32_t color) {
+   _fillAbs(_vpX, _vpY, _vpW, _vpH, color);
+}
+
+// True if the pixel matches the transparent color (a palette index for 4-bit sprites)
+bool TFT_eSprite::_transparent(int32_t x, int32_t y, uint16_t transp) {
+   switch(_bpp) {
+      case 4:  return(_readRaw(x, y) == (transp & 0x0F));
+      case 8:  return(_readRaw(x, y) == color565to332(transp));
+      default: return(_read565(x, y) == transp);
+   }
+}
+
+// The value to hand to dst's pixel store for one of our pixels
+uint32_t TFT_eSprite::_colorFor(TFT_eSPI * dst, int32_t x, int32_t y) {
+   if(!dst->_isDisplay()) {
+      TFT_eSprite * spr = (TFT_eSprite *)dst;
+      if(spr->_bpp == 4 && _bpp == 4) {
+         return(_readRaw(x, y));
+      }
+      if(spr->_bpp == 1) {
+         return(_bpp == 1 ? _readRaw(x, y) : _read565(x, y) != spr->_bitmapBg);
+      }
+   }
+   return(_read565(x, y));
+}
+
+// Copy the sprite area (sx,sy,sw,sh) to (tx,ty) on dst
+void TFT_eSprite::_pushWindow(TFT_eSPI * dst, int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh, bool useTransp, uint16_t transp) {
+   _Call call(dst);
+   for(int32_t y=0; y<sh; y++) {
+      for(int32_t x=0; x<sw; x++) {
+         if(useTransp && _transparent(sx + x, sy + y, transp)) {
+            continue;
+         }
+         dst->_plot(tx + x + dst->_xDatum, ty + y + dst->_yDatum, _colorFor(dst, sx + x, sy + y));
+      }
+   }
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
+   if(_buf) {
+      _pushWindow(_tft, x, y, 0, 0, _width, _height, false, 0);
+   }
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transp) {
+   if(_buf) {
+      _pushWindow(_tft, x, y, 0, 0, _width, _height, true, transp);
+   }
+}
+
+bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh) {
+   if(_buf == NULL) {
+      return(false);
+   }
+   if(sx < 0) { sw += sx; tx -= sx; sx = 0; }
+   if(sy < 0) { sh += sy; ty -= sy; sy = 0; }
+   sw = min(sw, _width - sx);
+   sh = min(sh, _height - sy);
+   if(sw < 1 || sh < 1) {
+      return(false);
+   }
+   _pushWindow(_tft, tx, ty, sx, sy, sw, sh, false, 0);
+   return(true);
+}
+
+bool TFT_eSprite::pushToSprite(TFT_eSprite * dst, int32_t x, int32_t y) {
+   if(_buf == NULL || !dst->created()) {
+      return(false);
+   }
+   _pushWindow(dst, x, y, 0, 0, _width, _height, false, 0);
+   return(true);
+}
+
+bool TFT_eSprite::pushToSprite(TFT_eSprite * dst, int32_t x, int32_t y, uint16_t transp) {
+   if(_buf == NULL || !dst->created()) {
+      return(false);
+   }
+   _pushWindow(dst, x, y, 0, 0, _width, _height, true, transp);
+   return(true);
+}
+
+// Rotate clockwise by angle degrees about our pivot and place that pivot on (px,py) of dst.
+// Nearest neighbour, which is what the library does too.
+bool TFT_eSprite::_rotateTo(TFT_eSPI * dst, int16_t px, int16_t py, int16_t angle, uint32_t transp) {
+   if(_buf == NULL) {
+      return(false);
+   }
+   _Call call(dst);
+   double ra = angle * M_PI / 180.0;
+   double s = sin(ra), c = cos(ra);
+
+   // Bounding box of the rotated sprite relative to the destination pivot
+   double minX = 1e9, maxX = -1e9, minY = 1e9, maxY = -1e9;
+   const int32_t cx[4] = { 0, _width, 0, _width };
+   const int32_t cy[4] = { 0, 0, _height, _height };
+   for(uint8_t i=0; i<4; i++) {
+      double x = cx[i] - _xPivot, y = cy[i] - _yPivot;
+      double rx = x * c - y * s, ry = x * s + y * c;
+      minX = min(minX, rx); maxX = max(maxX, rx);
+      minY = min(minY, ry); maxY = max(maxY, ry);
+   }
+
+   for(int32_t y=(int32_t)floor(minY); y<=(int32_t)ceil(maxY); y++) {
+      for(int32_t x=(int32_t)floor(minX); x<=(int32_t)ceil(maxX); x++) {
+         int32_t sx = (int32_t)floor(x * c + y * s + _xPivot);
+         int32_t sy = (int32_t)floor(-x * s + y * c + _yPivot);
+         if(sx < 0 || sy < 0 || sx >= _width || sy >= _height) {
+            continue;
+         }
+         if(transp != 0x00FFFFFF && _transparent(sx, sy, transp)) {
+            continue;
+         }
+         dst->_plot(px + x + dst->_xDatum, py + y + dst->_yDatum, _colorFor(dst, sx, sy));
+      }
+   }
+   return(true);
+}
+
+bool TFT_eSprite::pushRotated(int16_t angle, uint32_t transp) {
+   return(_rotateTo(_tft, _tft->getPivotX(), _tft->getPivotY(), angle, transp));
+}
+
+bool TFT_eSprite::pushRotated(TFT_eSprite * dst, int16_t angle, uint32_t transp) {
+   if(!dst->created()) {
+      return(false);
+   }
+   return(_rotateTo(dst, dst->getPivotX(), dst->getPivotY(), angle, transp));
+}
+
+void TFT_eSprite::setScrollRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+   if(x < 0) { w += x; x = 0; }
+   if(y < 0) { h += y; y = 0; }
+   _sx = x;
+   _sy = y;
+   _sw = max((int32_t)0, min(w, _width - x));
+   _sh = max((int32_t)0, min(h, _height - y));
+   _scrollFill = color;
+}
+
+// Move the scroll rectangle contents by (dx,dy) and fill what is uncovered
+void TFT_eSprite::scroll(int16_t dx, int16_t dy) {
+   if(_buf == NULL || _sw < 1 || _sh < 1) {
+      return;
+   }
+   uint32_t * copy = new uint32_t[_sw * _sh];
+   for(int32_t y=0; y<_sh; y++) {
+      for(int32_t x=0; x<_sw; x++) {
+         copy[y * _sw + x] = _readRaw(_sx + x, _sy + y);
+      }
+   }
+   for(int32_t y=0; y<_sh; y++) {
+      for(int32_t x=0; x<_sw; x++) {
+         int32_t fx = x - dx, fy = y - dy;
+         if(fx < 0 || fy < 0 || fx >= _sw || fy >= _sh) {
+            _writeRaw(_sx + x, _sy + y, _scrollFill);
+         } else if(_bpp == 16) {
+            ((uint16_t *)_buf)[(_sy + y) * _width + _sx + x] = copy[fy * _sw + fx];
+         } else if(_bpp == 8) {
+            _buf[(_sy + y) * _width + _sx + x] = copy[fy * _sw + fx];
+         } else {
+            _writeRaw(_sx + x, _sy + y, copy[fy * _sw + fx]);
+         }
+      }
+   }
+   delete[] copy;
+}
+
+//###############################################################################
+// TFT_eSPI_Button
+//###############################################################################
+TFT_eSPI_Button::TFT_eSPI_Button() {
+   _gfx = NULL;
+   _xd = _yd = 0;
+   _textDatum = MC_DATUM;
+   _label[0] = 0;
+   _currState = _lastState = false;
+}
+
+void TFT_eSPI_Button::initButton(TFT_eSPI * gfx, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t outline, uint16_t fill, uint16_t textColor, char * label, uint8_t textSize) {
+   _x1 = x - w/2;
+   _y1 = y - h/2;
+   _w = w;
+   _h = h;
+   _outlineColor = outline;
+   _fillColor = fill;
+   _textColor = textColor;
+   _textSize = textSize;
+   _gfx = gfx;
+   strncpy(_label, label, 9);
+   _label[9] = 0;
+}
+
+void TFT_eSPI_Button::drawButton(bool inverted, String longName) {
+   uint16_t fill = inverted ? _textColor : _fillColor;
+   uint16_t text = inverted ? _fillColor : _textColor;
+   uint8_t r = min(_w, _h) / 4;
+   _gfx->fillRoundRect(_x1, _y1, _w, _h, r, fill);
+   _gfx->drawRoundRect(_x1, _y1, _w, _h, r, _outlineColor);
+   _gfx->setTextColor(text, fill);
+   _gfx->setTextSize(_textSize);
+   uint8_t datum = _gfx->getTextDatum();
+   _gfx->setTextDatum(_textDatum);
+   if(longName == "") {
+      _gfx->drawString(_label, _x1 + (_w/2) + _xd, _y1 + (_h/2) - 4 + _yd);
+   } else {
+      _gfx->drawString(longName, _x1 + (_w/2) + _xd, _y1 + (_h/2) - 4 + _yd);
+   }
+   _gfx->setTextDatum(datum);
+}
+
+bool TFT_eSPI_Button::contains(int16_t x, int16_t y) {
+   return(x >= _x1 && x < _x1 + _w && y >= _y1 && y < _y1 + _h);
+}
@@ -0,0 +1,284 @@
+// Software stand-in for the Bodmer TFT_eSPI library so the screen code can be built and run on Linux.
+//
+// The display is a 480x320 RGB565 framebuffer in memory.  Sprites keep their pixels at their real color
+// depth (1/4/8/16 bit, same layouts as the library) so sprite code behaves the same.  Everything that
+// reaches the display is counted (draw calls and pixels written) and the framebuffer can be dumped as
+// a PPM or PNG image.  Only the parts of the library the data logger uses are here.  See README.md.
+
+#ifndef TFT_eSPI_h
+#define TFT_eSPI_h
+
+#include <Arduino.h>
+#include <User_Setup.h>
+#include <SPIFFS.h>   // The library pulls this in on the ESP32 (touch calibration files live there)
+
+// Fonts come from the real library (-I to the TFT_eSPI library directory, see README.md)
+#include <Fonts/GFXFF/gfxfont.h>
+#include <Fonts/GFXFF/FreeSans9pt7b.h>
+#include <Fonts/GFXFF/FreeSansBold9pt7b.h>
+#include <Fonts/GFXFF/FreeSansBold12pt7b.h>
+#include <Fonts/GFXFF/FreeSansOblique12pt7b.h>
+#include <Fonts/GFXFF/FreeSans18pt7b.h>
+
+#define TFT_EMU_WIDTH  480
+#define TFT_EMU_HEIGHT 320
+
+#define GFXFF 1
+
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define CL_DATUM 3
+#define MC_DATUM 4
+#define CC_DATUM 4
+#define MR_DATUM 5
+#define CR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+#define L_BASELINE 9
+#define C_BASELINE 10
+#define R_BASELINE 11
+
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_DARKCYAN    0x03EF
+#define TFT_MAROON      0x7800
+#define TFT_PURPLE      0x780F
+#define TFT_OLIVE       0x7BE0
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_DARKGREY    0x7BEF
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_CYAN        0x07FF
+#define TFT_RED         0xF800
+#define TFT_MAGENTA     0xF81F
+#define TFT_YELLOW      0xFFE0
+#define TFT_WHITE       0xFFFF
+#define TFT_ORANGE      0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_PINK        0xFE19
+#define TFT_BROWN       0x9A60
+#define TFT_GOLD        0xFEA0
+#define TFT_SILVER      0xC618
+#define TFT_SKYBLUE     0x867D
+#define TFT_VIOLET      0x915C
+#define TFT_GREY        0x5AEB
+#define TFT_TRANSPARENT 0x0120
+
+// What reached the display since the counters were last reset
+struct tftStats {
+   uint32_t drawCalls;     // Public drawing calls made on the display (sprite pushes included)
+   uint32_t pixels;        // Pixels written to the display
+};
+
+class TFT_eSPI : public Print {
+
+   public:
+      TFT_eSPI(int16_t w = TFT_EMU_WIDTH, int16_t h = TFT_EMU_HEIGHT);
+      virtual ~TFT_eSPI();
+
+      void init() {}
+      void setRotation(uint8_t) {}
+      int16_t width();
+      int16_t height();
+
+      // Drawing (coordinates are relative to the viewport when it has its own datum)
+      void drawPixel(int32_t, int32_t, uint32_t);
+      void drawLine(int32_t, int32_t, int32_t, int32_t, uint32_t);
+      void drawFastVLine(int32_t, int32_t, int32_t, uint32_t);
+      void drawFastHLine(int32_t, int32_t, int32_t, uint32_t);
+      void fillRect(int32_t, int32_t, int32_t, int32_t, uint32_t);
+      void drawRect(int32_t, int32_t, int32_t, int32_t, uint32_t);
+      void fillRoundRect(int32_t, int32_t, int32_t, int32_t, int32_t, uint32_t);
+      void drawRoundRect(int32_t, int32_t, int32_t, int32_t, int32_t, uint32_t);
+      void fillScreen(uint32_t);
+
+      // Free font text
+      void setFreeFont(const GFXfont *);
+      void setTextFont(uint8_t) { _font = NULL; }
+      void setTextColor(uint16_t c) { _textColor = c; _textBgColor = c; }
+      void setTextColor(uint16_t c, uint16_t bg, bool = false) { _textColor = c; _textBgColor = bg; }
+      void setTextDatum(uint8_t d) { _textDatum = d; }
+      uint8_t getTextDatum() { return(_textDatum); }
+      void setTextSize(uint8_t) {}
+      void setTextPadding(uint16_t) {}
+      uint16_t getTextPadding() { return(0); }
+      void setCursor(int16_t x, int16_t y) { _cursorX = x; _cursorY = y; }
+      int16_t textWidth(const char *);
+      int16_t fontHeight();
+      int16_t drawString(const char *, int32_t, int32_t);
+      int16_t drawString(const char * s, int32_t x, int32_t y, uint8_t) { return(drawString(s, x, y)); }
+      int16_t drawString(const String & s, int32_t x, int32_t y) { return(drawString(s.c_str(), x, y)); }
+      size_t write(uint8_t);
+      using Print::write;
+
+      // Viewports
+      void setViewport(int32_t, int32_t, int32_t, int32_t, bool vpDatum = true);
+      void resetViewport();
+
+      void setPivot(int16_t x, int16_t y) { _xPivot = x; _yPivot = y; }
+      int16_t getPivotX() { return(_xPivot); }
+      int16_t getPivotY() { return(_yPivot); }
+
+      // Block transfers
+      void setSwapBytes(bool swap) { _swapBytes = swap; }
+      bool getSwapBytes() { return(_swapBytes); }
+      void readRect(int32_t, int32_t, int32_t, int32_t, uint16_t *);
+      void pushImage(int32_t, int32_t, int32_t, int32_t, const uint16_t *);
+      void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t * data) { pushImage(x, y, w, h, (const uint16_t *)data); }
+      void setAddrWindow(int32_t, int32_t, int32_t, int32_t);
+      void pushColor(uint16_t);
+      void pushColor(uint16_t, uint32_t);
+      void pushPixels(const void *, uint32_t);
+      void startWrite() {}
+      void endWrite() {}
+      bool initDMA(bool = false) { return(false); }
+      bool dmaBusy() { return(false); }
+      void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t * data, uint16_t * = nullptr) { pushImage(x, y, w, h, data); }
+      void writecommand(uint8_t) {}
+      void writedata(uint8_t) {}
+
+      // No touch panel on the host.  setHostTouch() fakes a press (see tools/nativeHal).
+      uint8_t getTouch(uint16_t * x, uint16_t * y, uint16_t = 600) { *x = _touchX; *y = _touchY; return(_touched); }
+      void setHostTouch(bool touched, uint16_t x = 0, uint16_t y = 0) { _touched = touched; _touchX = x; _touchY = y; }
+      void setTouch(uint16_t *) {}
+      void calibrateTouch(uint16_t *, uint32_t, uint32_t, uint8_t) {}
+
+      // Emulator extras.  Display pixel (RGB565), the counters and image dumps.
+      uint16_t getFramePixel(int32_t x, int32_t y) { return(_frame[y * _width + x]); }
+      tftStats getStats() { return(_stats); }
+      void resetStats() { _stats.drawCalls = 0; _stats.pixels = 0; }
+      bool savePPM(const char *);
+      bool savePNG(const char *);
+
+   protected:
+      friend class TFT_eSprite;
+
+      // Counts one draw call for every public call that reaches the display.  Calls made from inside
+      // another call (drawRect -> drawFastHLine, ...) are not counted again.
+      struct _Call {
+         TFT_eSPI * t;
+         explicit _Call(TFT_eSPI * tft) : t(tft) { if(t->_depth++ == 0 && t->_isDisplay()) t->_stats.drawCalls++; }
+         ~_Call() { t->_depth--; }
+      };
+
+      // Pixel store.  Coordinates are absolute and already clipped.  The display stores RGB565, sprites
+      // store the color at their own depth (see TFT_eSprite).
+      virtual void _writeRaw(int32_t, int32_t, uint32_t);
+      virtual uint32_t _readRaw(int32_t, int32_t);
+      virtual uint16_t _read565(int32_t x, int32_t y) { return(_readRaw(x, y)); }
+      virtual bool _isDisplay() { return(true); }
+
+      void _plot(int32_t, int32_t, uint32_t);
+      void _fillAbs(int32_t, int32_t, int32_t, int32_t, uint32_t);
+      void _circleHelper(int32_t, int32_t, int32_t, uint8_t, uint32_t);
+      void _fillCircleHelper(int32_t, int32_t, int32_t, uint8_t, int32_t, uint32_t);
+      void _drawGlyph(uint16_t, int32_t *, int32_t);
+      void _countPixels(uint32_t n) { if(_isDisplay()) _stats.pixels += n; }
+
+      int32_t _width, _height;
+      int32_t _vpX, _vpY, _vpW, _vpH;   // Clip rectangle
+      int32_t _xDatum, _yDatum;         // Added to drawing coordinates
+      bool _vpDatum;
+      int16_t _xPivot, _yPivot;
+      bool _swapBytes;
+
+      const GFXfont * _font;
+      uint16_t _textColor, _textBgColor;
+      uint8_t _textDatum;
+      int16_t _glyphAb, _glyphBb;
+      int32_t _cursorX, _cursorY;
+
+      int32_t _winX, _winY, _winW, _winH, _winPos;   // setAddrWindow/pushColor
+
+      tftStats _stats;
+      uint8_t _depth;
+
+      bool _touched;
+      uint16_t _touchX, _touchY;
+
+   private:
+      uint16_t * _frame;
+};
+
+class TFT_eSprite : public TFT_eSPI {
+
+   public:
+      explicit TFT_eSprite(TFT_eSPI *);
+      ~TFT_eSprite();
+
+      void * createSprite(int16_t, int16_t, uint8_t frames = 1);
+      void deleteSprite();
+      bool created() { return(_buf != NULL); }
+      void * setColorDepth(int8_t);
+      int8_t getColorDepth() { return(_bpp); }
+      void * getPointer() { return(_buf); }
+
+      void createPalette(const uint16_t * palette = nullptr, uint8_t colors = 16);
+      void createPalette(uint16_t * palette, uint8_t colors = 16) { createPalette((const uint16_t *)palette, colors); }
+      void setBitmapColor(uint16_t fg, uint16_t bg) { _bitmapFg = fg; _bitmapBg = bg; }
+
+      void fillSprite(uint32_t);
+      uint16_t readPixel(int32_t, int32_t);
+      uint16_t readPixelValue(int32_t, int32_t);
+
+      void pushSprite(int32_t, int32_t);
+      void pushSprite(int32_t, int32_t, uint16_t);
+      bool pushSprite(int32_t, int32_t, int32_t, int32_t, int32_t, int32_t);
+      bool pushToSprite(TFT_eSprite *, int32_t, int32_t);
+      bool pushToSprite(TFT_eSprite *, int32_t, int32_t, uint16_t);
+      bool pushRotated(int16_t, uint32_t transp = 0x00FFFFFF);
+      bool pushRotated(TFT_eSprite *, int16_t, uint32_t transp = 0x00FFFFFF);
+
+      void setScrollRect(int32_t, int32_t, int32_t, int32_t, uint16_t color = TFT_BLACK);
+      void scroll(int16_t, int16_t dy = 0);
+
+   protected:
+      void _writeRaw(int32_t, int32_t, uint32_t) override;
+      uint32_t _readRaw(int32_t, int32_t) override;
+      uint16_t _read565(int32_t, int32_t) override;
+      bool _isDisplay() override { return(false); }
+
+   private:
+      void _pushWindow(TFT_eSPI *, int32_t, int32_t, int32_t, int32_t, int32_t, int32_t, bool, uint16_t);
+      bool _rotateTo(TFT_eSPI *, int16_t, int16_t, int16_t, uint32_t);
+      bool _transparent(int32_t, int32_t, uint16_t);
+      uint32_t _colorFor(TFT_eSPI *, int32_t, int32_t);
+
+      TFT_eSPI * _tft;
+      uint8_t * _buf;
+      int8_t _bpp;
+      int32_t _bitWidth;            // Rows are padded to whole bytes (1-bit and 4-bit sprites, as in TFT_eSPI)
+      uint16_t _palette[16];
+      uint16_t _bitmapFg, _bitmapBg;
+      int32_t _sx, _sy, _sw, _sh;   // Scroll rectangle
+      uint16_t _scrollFill;
+};
+
+class TFT_eSPI_Button {
+
+   public:
+      TFT_eSPI_Button();
+      void initButton(TFT_eSPI *, int16_t, int16_t, uint16_t, uint16_t, uint16_t, uint16_t, uint16_t, char *, uint8_t);
+      void setLabelDatum(int16_t x, int16_t y, uint8_t datum = MC_DATUM) { _xd = x; _yd = y; _textDatum = datum; }
+      void drawButton(bool inverted = false, String longName = "");
+      bool contains(int16_t, int16_t);
+      void press(bool p) { _lastState = _currState; _currState = p; }
+      bool isPressed() { return(_currState); }
+      bool justPressed() { return(_currState && !_lastState); }
+      bool justReleased() { return(!_currState && _lastState); }
+
+   private:
+      TFT_eSPI * _gfx;
+      int16_t _x1, _y1, _xd, _yd;
+      uint16_t _w, _h;
+      uint8_t _textSize, _textDatum;
+      uint16_t _outlineColor, _fillColor, _textColor;
+      char _label[10];
+      bool _currState, _lastState;
+};
+
+#endif
@@ -0,0 +1,5 @@
+// Host build stand-in for the TFT_eSPI User_Setup.h (only the free fonts are used, see README.md)
+#ifndef User_Setup_h
+#define User_Setup_h
+#define LOAD_GFXFF
+#endif
@@ -0,0 +1,155 @@
+// Arduino core, Serial and SD card bodies for the host build (see README.md)
+
+#include <Arduino.h>
+#include <SD.h>
+#include <SPIFFS.h>
+#include <stdarg.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+SDFS SD;
+SPIFFSFS SPIFFS;
+
+// The native build (tools/nativeHal) brings its own clock that only moves when it's told to
+#ifndef HOST_FAKE_CLOCK
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+   return(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - bootTime).count());
+}
+
+unsigned long micros() {
+   return(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime).count());
+}
+
+void delay(unsigned long ms) {
+   std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+#endif
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+   return((x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin);
+}
+
+char * dtostrf(double val, signed char width, unsigned char prec, char * buf) {
+   sprintf(buf, "%*.*f", width, prec, val);
+   return(buf);
+}
+
+char * itoa(int val, char * buf, int base) {
+   if(base == 16) {
+      sprintf(buf, "%x", val);
+   } else {
+      sprintf(buf, "%d", val);
+   }
+   return(buf);
+}
+
+size_t Print::_printf(const char * fmt, ...) {
+   char buf[64];
+   va_list args;
+   va_start(args, fmt);
+   vsnprintf(buf, sizeof(buf), fmt, args);
+   va_end(args);
+   return(print(buf));
+}
+
+//###############################################################################
+// File systems.  The SD card is the directory $SD_ROOT (default ./sdcard) and
+// SPIFFS is $SPIFFS_ROOT (default ./spiffs).
+//###############################################################################
+std::string FS::_path(const char * path) {
+   const char * root = getenv(_rootEnv);
+   std::string full = root ? root : _rootDefault;
+   if(path[0] != '/') {
+      full += "/";
+   }
+   return(full + path);
+}
+
+// Make the root directory if it isn't there yet
+bool FS::begin() {
+   struct stat st;
+   std::string root = _path("");
+   return(stat(root.c_str(), &st) == 0 || mkdir(root.c_str(), 0755) == 0);
+}
+
+File FS::open(const char * path, const char * mode) {
+   // Arduino opens for update, the host needs the binary flag for seek()/size() to behave
+   std::string m = mode;
+   m = (m == FILE_READ) ? "rb" : (m == FILE_WRITE) ? "wb+" : "ab+";
+   FILE * fp = fopen(_path(path).c_str(), m.c_str());
+   if(!fp) {
+      return(File());
+   }
+   _stats.opens++;
+   return(File(fp, &_stats));
+}
+
+bool FS::exists(const char * path) {
+   FILE * fp = fopen(_path(path).c_str(), "rb");
+   if(fp) {
+      fclose(fp);
+   }
+   return(fp != NULL);
+}
+
+bool FS::remove(const char * path) {
+   return(::remove(_path(path).c_str()) == 0);
+}
+
+int File::available() {
+   return(_fp ? size() - position() : 0);
+}
+
+int File::read() {
+   int c = _fp ? fgetc(_fp.get()) : -1;
+   if(c >= 0) {
+      _stats->bytesRead++;
+   }
+   return(c);
+}
+
+size_t File::read(uint8_t * buf, size_t len) {
+   size_t n = _fp ? fread(buf, 1, len, _fp.get()) : 0;
+   if(n > 0) {
+      _stats->bytesRead += n;
+   }
+   return(n);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+   int whence = (mode == SeekCur) ? SEEK_CUR : (mode == SeekEnd) ? SEEK_END : SEEK_SET;
+   return(_fp && fseek(_fp.get(), pos, whence) == 0);
+}
+
+size_t File::position() const {
+   return(_fp ? ftell(_fp.get()) : 0);
+}
+
+size_t File::size() const {
+   if(!_fp) {
+      return(0);
+   }
+   long pos = ftell(_fp.get());
+   fseek(_fp.get(), 0, SEEK_END);
+   long end = ftell(_fp.get());
+   fseek(_fp.get(), pos, SEEK_SET);
+   return(end);
+}
+
+void File::flush() {
+   if(_fp) {
+      fflush(_fp.get());
+   }
+}
+
+size_t File::write(uint8_t c) {
+   return(_fp && fputc(c, _fp.get()) != EOF ? 1 : 0);
+}
+
+size_t File::write(const uint8_t * buf, size_t len) {
+   return(_fp ? fwrite(buf, 1, len, _fp.get()) : 0);
+}
@@ -0,0 +1,374 @@
+//#################################################################################################
+// Host-side run of the data logger screens.
+//
+// Builds the display sprites and MyTouchScreen the same way main.cpp does, but against the
+// software TFT_eSPI in this directory.  Each scene (menu, results, graph) is drawn, the framebuffer
+// is written out as <dir>/<scene>.ppm and <dir>/<scene>.png, and then the scene is drawn again
+// <loops> times to report what one draw costs:
+//
+//    scene      us/draw  calls/draw  pixels/draw
+//
+// calls are the TFT_eSPI calls that reached the display (sprite pushes included) and pixels the
+// display pixels written, so a change to the screen code can be checked for what it saves (or
+// costs) without the hardware.  Then a long trace is graphed to report how many data points per
+// second get transformed, clipped and plotted (the graph drawn with just two points is timed too and
+// taken off, so the frame and the push don't count).  Last, one frame of new results is drawn the
+// old way (a sprite of its own pushed for each field) and with drawTextSprite() with and without the
+// glyph atlas, to compare what the result column costs per frame.  See README.md for the build line.
+//
+// Usage: tftEmulator [outDir] [loops] [nocache]
+//#################################################################################################
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <MyDisplay.h>
+#include <MyTouchScreen.h>
+#include <MyGlyphAtlas.h>
+#include <MyScreenCache.h>
+
+TFT_eSPI tft = TFT_eSPI();
+TFT_eSprite btnTextSprite = TFT_eSprite(&tft);
+TFT_eSprite textSprite = TFT_eSprite(&tft);
+TFT_eSprite statusSprite = TFT_eSprite(&tft);
+TFT_eSprite yAxisSprite = TFT_eSprite(&tft);
+TFT_eSprite clockSprite = TFT_eSprite(&tft);
+TFT_eSprite plotSprite = TFT_eSprite(&tft);
+TFT_eSprite fieldSprite = TFT_eSprite(&tft);   // One result field, what textSprite was before the column sprite
+
+MyGlyphAtlas textAtlas;
+static boolean atlasReady = false;
+MyScreenCache screenCache(&tft);
+
+MyTouchScreen menuScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, "Main Menu", 1);
+MyTouchScreen monitorScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, "Monitor Results", 1);
+MyTouchScreen graphScreen(&tft, &btnTextSprite, &textSprite, &statusSprite, &yAxisSprite, &clockSprite, &plotSprite, "Graph", 0);
+
+// Nothing happens on a press here
+static void nop(uint8_t) {}
+
+//##################################################################
+// Layouts.  Copies of the main menu and the IV monitor/graph screens.
+//##################################################################
+static constexpr screenButton menuButtons[] = {
+   { 5,  "I/V",        nop },
+   { 6,  "Temp",       nop },
+   { 9,  "A-In/D-In",  nop },
+   { 10, "D-Out",      nop },
+   { 13, "Clock",      nop },
+   { 14, "110v",       nop },
+};
+static constexpr screenLayout menuLayout = {
+   menuButtons, LAYOUT_COUNT(menuButtons),
+   NULL, 0,
+   NULL, 0,
+   NULL, 0
+};
+
+static char current_mAS[TEXT_LEN + 1] = "0.00";
+static char loadVoltageS[TEXT_LEN + 1] = "0.00";
+static char power_mWS[TEXT_LEN + 1] = "0.00";
+static char timeMonitoredS[TEXT_LEN + 1] = "0.00";
+
+static constexpr screenButton monitorButtons[] = {
+   { 18, "Full",      nop },
+   { 19, "Stream",    nop },
+   { 20, "ViewGraph", nop },
+   { 21, "Start",     nop },
+   { 22, "StopLog",   nop },
+   { 23, "Back",      nop },
+};
+static constexpr screenText monitorText[] = {
+   { 0, "Load Current (mA)",    TEXT_LEFT, TEXT_LINE0 },
+   { 1, "Load Voltage (V)",     TEXT_LEFT, TEXT_LINE1 },
+   { 2, "Load Power (mW)",      TEXT_LEFT, TEXT_LINE2 },
+   { 3, "Time Monitored (Min)", TEXT_LEFT, TEXT_LINE3 },
+};
+static constexpr screenText monitorSprites[] = {
+   { 0, current_mAS,     TEXT_SP_LEFT, TEXT_SP_LINE0 },
+   { 1, loadVoltageS,    TEXT_SP_LEFT, TEXT_SP_LINE1 },
+   { 2, power_mWS,       TEXT_SP_LEFT, TEXT_SP_LINE2 },
+   { 3, timeMonitoredS,  TEXT_SP_LEFT, TEXT_SP_LINE3 },
+};
+static constexpr screenLayout monitorLayout = {
+   monitorButtons, LAYOUT_COUNT(monitorButtons),
+   monitorText, LAYOUT_COUNT(monitorText),
+   monitorSprites, LAYOUT_COUNT(monitorSprites),
+   NULL, 0
+};
+
+static constexpr screenButton graphButtons[] = {
+   { 20, "Current", nop },
+   { 21, "Voltage", nop },
+   { 22, "Power",   nop },
+   { 23, "Back",    nop },
+};
+static constexpr screenLayout graphLayout = {
+   graphButtons, LAYOUT_COUNT(graphButtons),
+   NULL, 0,
+   NULL, 0,
+   NULL, 0
+};
+
+//##################################################################
+// Scenes
+//##################################################################
+#define GRAPH_POINTS 600
+static float graphX[GRAPH_POINTS];
+static float graphY[GRAPH_POINTS];
+
+// The trace starts and ends off the sides of the plot and swings past the top and bottom, so plenty
+// of its segments get clipped
+#define TRACE_POINTS 20000
+static float traceX[TRACE_POINTS];
+static float traceY[TRACE_POINTS];
+static uint32_t sampleCount = 0;
+
+static void drawMenu() {
+   menuScreen.drawScreen();
+}
+
+// Next set of results into the monitor screen's fields
+static void nextResults() {
+   sampleCount++;
+   float t = sampleCount * 0.05;
+   dtostrf(120.0 + 30.0 * sin(t), FLOAT_STRING_WIDTH, 2, current_mAS);
+   dtostrf(4.9 + 0.1 * cos(t), FLOAT_STRING_WIDTH, 2, loadVoltageS);
+   dtostrf((120.0 + 30.0 * sin(t)) * 4.9, FLOAT_STRING_WIDTH, 2, power_mWS);
+   dtostrf(sampleCount / 60.0, FLOAT_STRING_WIDTH, 2, timeMonitoredS);
+   monitorScreen.updateTextSprite(0, current_mAS);
+   monitorScreen.updateTextSprite(1, loadVoltageS);
+   monitorScreen.updateTextSprite(2, power_mWS);
+   monitorScreen.updateTextSprite(3, timeMonitoredS);
+}
+
+// The monitor screen once, then new results each time after that (like a logging loop)
+static void drawResults() {
+   if(sampleCount == 0) {
+      monitorScreen.drawScreen();
+   }
+   nextResults();
+   monitorScreen.drawTextSprite();
+}
+
+// The result fields the way drawTextSprite() drew them before the column sprite: each changed field
+// cleared, drawn and pushed in a sprite of its own
+static char fieldShown[LAYOUT_COUNT(monitorSprites)][TEXT_LEN + 1];
+
+static void drawFieldSprites() {
+   fieldSprite.setFreeFont(TEXT_FONT);
+   fieldSprite.setTextColor(TFT_WHITE, TFT_BLACK);
+   fieldSprite.setTextDatum(TEXT_DATUM);
+   for(uint8_t row=0; row<LAYOUT_COUNT(monitorSprites); row++) {
+      if(!strcmp(fieldShown[row], monitorSprites[row].text)) {
+         continue;
+      }
+      strcpy(fieldShown[row], monitorSprites[row].text);
+      fieldSprite.fillSprite(TFT_BLACK);
+      fieldSprite.drawString(monitorSprites[row].text, 0, 0, GFXFF);
+      fieldSprite.pushSprite(monitorSprites[row].x, monitorSprites[row].y);
+   }
+}
+
+static void drawColumnSprite() {
+   monitorScreen.drawTextSprite();
+}
+
+// Hash of the display, to check the ways of drawing the results come out the same
+static uint32_t frameHash() {
+   uint32_t hash = 2166136261UL;
+   for(int y=0; y<SCREEN_HEIGHT; y++) {
+      for(int x=0; x<SCREEN_WIDTH; x++) {
+         hash = (hash ^ tft.getFramePixel(x, y)) * 16777619UL;
+      }
+   }
+   return(hash);
+}
+
+// Per frame cost of the result column drawn with draw(), and the display once a fixed set of results
+// has been drawn on a fresh monitor screen
+static uint32_t timeResultText(const char * name, void (*draw)(), int loops) {
+   monitorScreen.drawScreen();
+   memset(fieldShown, 0, sizeof(fieldShown));
+   tft.resetStats();
+   unsigned long start = micros();
+   for(int i=0; i<loops; i++) {
+      nextResults();
+      draw();
+   }
+   unsigned long elapsed = micros() - start;
+   tftStats stats = tft.getStats();
+
+   char line[128];
+   snprintf(line, sizeof(line), "   %-20s %8.2f %11.2f %12.1f", name, elapsed / (double)max(loops, 1),
+            stats.drawCalls / (double)max(loops, 1), stats.pixels / (double)max(loops, 1));
+   Serial.println(line);
+
+   uint32_t saved = sampleCount;
+   sampleCount = 0;
+   monitorScreen.drawScreen();
+   memset(fieldShown, 0, sizeof(fieldShown));
+   nextResults();
+   draw();
+   sampleCount = saved;
+   return(frameHash());
+}
+
+static void drawGraph() {
+   graphScreen.drawScreen();
+   graphScreen.setXAxis(0, 60, 10, "Time (Min)");
+   graphScreen.setYAxis(0, 200, 10, "Current (mA)");
+   graphScreen.drawGraph(false, "", GRAPH_POINTS, graphX, graphY, NULL);
+}
+
+static void drawTrace(int points) {
+   graphScreen.drawScreen();
+   graphScreen.setXAxis(0, 60, 10, "Time (Min)");
+   graphScreen.setYAxis(0, 200, 10, "Current (mA)");
+   graphScreen.drawGraph(false, "", points, traceX, traceY, NULL);
+}
+
+// Host time for <loops> trace graphs of <points> points
+static unsigned long timeTrace(int points, int loops) {
+   unsigned long start = micros();
+   for(int i=0; i<loops; i++) {
+      drawTrace(points);
+   }
+   return(micros() - start);
+}
+
+struct scene {
+   const char * name;
+   void (*draw)();
+};
+static const scene scenes[] = {
+   { "menu",    drawMenu },
+   { "results", drawResults },
+   { "graph",   drawGraph },
+};
+
+//##################################################################
+// Same sprite set up as main.cpp
+//##################################################################
+static void setupDisplay(boolean useCache) {
+   tft.init();
+   tft.setRotation(1);
+
+   btnTextSprite.createSprite(BUTTON_TEXT_SP_WIDTH,BUTTON_TEXT_SP_HEIGHT);
+   btnTextSprite.setColorDepth(8);
+   textSprite.createSprite(TEXT_SP_WIDTH,TEXT_COLUMN_HEIGHT);
+   textSprite.setColorDepth(1);
+   if(useCache) {
+      MyTouchScreen::setScreenCache(&screenCache);
+   }
+   atlasReady = textAtlas.begin(TEXT_FONT, GLYPH_ATLAS_CHARS);
+   if(atlasReady) {
+      MyTouchScreen::setTextAtlas(&textAtlas);
+   }
+   statusSprite.createSprite(STATUS_WIDTH, STATUS_HEIGHT);
+   statusSprite.setColorDepth(1);
+   clockSprite.createSprite(CLOCK_WIDTH, CLOCK_HEIGHT);
+   clockSprite.setColorDepth(1);
+   yAxisSprite.createSprite(SCREEN_HEIGHT/2, 25);
+   yAxisSprite.setColorDepth(1);
+   yAxisSprite.setPivot(0, GRAPH_LABEL_SP_H/2);
+   yAxisSprite.fillSprite(TFT_BLACK);
+   plotSprite.setColorDepth(4);
+   plotSprite.createSprite(GRAPH_PLOT_W, GRAPH_PLOT_H);
+   fieldSprite.createSprite(TEXT_SP_WIDTH, TEXT_SP_HEIGHT);
+   fieldSprite.setColorDepth(1);
+
+   menuScreen.loadLayout(&menuLayout);
+   monitorScreen.loadLayout(&monitorLayout);
+   graphScreen.init(&graphScreen);
+   graphScreen.loadLayout(&graphLayout);
+
+   for(int i=0; i<GRAPH_POINTS; i++) {
+      graphX[i] = i * 60.0 / GRAPH_POINTS;
+      graphY[i] = 100.0 + 60.0 * sin(i * 0.03) + 15.0 * sin(i * 0.4);
+   }
+   for(int i=0; i<TRACE_POINTS; i++) {
+      traceX[i] = -10.0 + i * 80.0 / TRACE_POINTS;
+      traceY[i] = 100.0 + 150.0 * sin(i * 0.002) + 40.0 * sin(i * 0.7);
+   }
+}
+
+int main(int argc, char ** argv) {
+   const char * outDir = (argc > 1) ? argv[1] : ".";
+   int loops = (argc > 2) ? atoi(argv[2]) : 20;
+   boolean useCache = !(argc > 3 && !strcmp(argv[3], "nocache"));
+
+   setupDisplay(useCache);
+
+   Serial.println("scene      us/draw  calls/draw  pixels/draw");
+   for(const scene & s : scenes) {
+      tft.fillScreen(TFT_BLACK);
+      tft.resetStats();
+      s.draw();
+      tftStats first = tft.getStats();
+
+      char path[256];
+      snprintf(path, sizeof(path), "%s/%s.ppm", outDir, s.name);
+      boolean saved = tft.savePPM(path);
+      snprintf(path, sizeof(path), "%s/%s.png", outDir, s.name);
+      saved = tft.savePNG(path) && saved;
+      if(!saved) {
+         Serial.print("Could not write ");
+         Serial.println(path);
+      }
+
+      tft.resetStats();
+      unsigned long start = micros();
+      for(int i=0; i<loops; i++) {
+         s.draw();
+      }
+      unsigned long elapsed = micros() - start;
+      tftStats stats = tft.getStats();
+
+      char line[128];
+      snprintf(line, sizeof(line), "%-9s %8lu %11lu %12lu   (first draw %lu calls, %lu pixels)",
+               s.name, elapsed / max(loops, 1), (unsigned long)stats.drawCalls / max(loops, 1),
+               (unsigned long)stats.pixels / max(loops, 1), (unsigned long)first.drawCalls, (unsigned long)first.pixels);
+      Serial.println(line);
+   }
+
+   // Frame only and full trace runs taken in turns, so a slow patch on the host hits both
+   drawTrace(TRACE_POINTS);
+   unsigned long frameUs = 0;
+   unsigned long traceUs = 0;
+   for(int i=0; i<max(loops, 1); i++) {
+      frameUs += timeTrace(2, 1);
+      traceUs += timeTrace(TRACE_POINTS, 1);
+   }
+   if(traceUs > frameUs) {
+      char line[128];
+      double plotUs = traceUs - frameUs;
+      snprintf(line, sizeof(line), "Graph trace: %.0f points/sec (%.1f ns/point, %d points)",
+               (TRACE_POINTS - 2) * max(loops, 1) * 1000000.0 / plotUs, plotUs * 1000.0 / ((TRACE_POINTS - 2) * max(loops, 1)), TRACE_POINTS);
+      Serial.println(line);
+   }
+
+   // The result column every frame (all the fields change, the time every few frames)
+   Serial.println("Result text          us/frame  calls/frame  pixels/frame");
+   uint32_t fieldHash = timeResultText("sprite per field", drawFieldSprites, max(loops, 1));
+   MyTouchScreen::setTextAtlas(NULL);
+   uint32_t columnHash = timeResultText("column sprite", drawColumnSprite, max(loops, 1));
+   uint32_t atlasHash = columnHash;
+   if(atlasReady) {
+      MyTouchScreen::setTextAtlas(&textAtlas);
+      atlasHash = timeResultText("column sprite+atlas", drawColumnSprite, max(loops, 1));
+   }
+   if(columnHash != fieldHash || atlasHash != fieldHash) {
+      Serial.println("   Result text differs between the ways of drawing it");
+   }
+
+   if(useCache) {
+      Serial.print("Screen cache: ");
+      Serial.print(screenCache.getHits());
+      Serial.print(" hits, ");
+      Serial.print(screenCache.getMisses());
+      Serial.print(" misses, ");
+      Serial.print(screenCache.getMemoryUsed());
+      Serial.println(" bytes");
+   }
+   return(0);
+}